@@ -35,6 +35,7 @@ QUANTUM_SRC += \
 include $(QUANTUM_DIR)/nvm/rules.mk
 
 VPATH += $(QUANTUM_DIR)/logging
+VPATH += $(QUANTUM_DIR)/spsc_queue
 # Fall back to lib/printf if there is no platform provided print
 ifeq ("$(wildcard $(PLATFORM_PATH)/$(PLATFORM_KEY)/printf.mk)","")
     include $(QUANTUM_PATH)/logging/print.mk
@@ -57,6 +58,7 @@ ifeq ($(strip $(AUDIO_ENABLE)), yes)
             OPT_DEFS += -DAUDIO_DRIVER_DAC
         else ifeq ($(strip $(AUDIO_DRIVER)), dac_additive)
             OPT_DEFS += -DAUDIO_DRIVER_DAC
+            SRC += $(QUANTUM_DIR)/audio/audio_mixer.c
         ## stm32f2 and above have a usable DAC unit, f1 do not, and need to use pwm instead
         else ifeq ($(strip $(AUDIO_DRIVER)), pwm_software)
             OPT_DEFS += -DAUDIO_DRIVER_PWM
@@ -299,7 +301,7 @@ ifneq ($(strip $(FLASH_DRIVER)), none)
 endif
 
 RGBLIGHT_ENABLE ?= no
-VALID_RGBLIGHT_TYPES := ws2812 apa102 custom
+VALID_RGBLIGHT_TYPES := ws2812 apa102 rgb_matrix custom
 
 ifeq ($(strip $(RGBLIGHT_ENABLE)), yes)
     RGBLIGHT_DRIVER ?= ws2812
@@ -326,6 +328,15 @@ ifeq ($(strip $(RGBLIGHT_ENABLE)), yes)
         APA102_DRIVER_REQUIRED := yes
     endif
 
+    ifeq ($(strip $(RGBLIGHT_DRIVER)), rgb_matrix)
+        ifneq ($(strip $(RGB_MATRIX_ENABLE)), yes)
+            $(call CATASTROPHIC_ERROR,Invalid RGBLIGHT_DRIVER,RGBLIGHT_DRIVER="rgb_matrix" requires RGB_MATRIX_ENABLE = yes)
+        endif
+        ifeq ($(filter $(RGB_MATRIX_DRIVER),ws2812 custom),)
+            $(call CATASTROPHIC_ERROR,Invalid RGBLIGHT_DRIVER,RGBLIGHT_DRIVER="rgb_matrix" requires RGB_MATRIX_DRIVER to be ws2812 or custom)
+        endif
+    endif
+
     ifeq ($(strip $(VELOCIKEY_ENABLE)), yes)
         OPT_DEFS += -DVELOCIKEY_ENABLE
     endif
@@ -651,6 +662,27 @@ ifeq ($(strip $(DYNAMIC_KEYMAP_ENABLE)), yes)
     SEND_STRING_ENABLE := yes
 endif
 
+VALID_ANALOG_MATRIX_DRIVER_TYPES := pins custom
+ANALOG_MATRIX_DRIVER ?= pins
+ifeq ($(strip $(ANALOG_MATRIX_ENABLE)), yes)
+    ifeq ($(filter $(ANALOG_MATRIX_DRIVER),$(VALID_ANALOG_MATRIX_DRIVER_TYPES)),)
+        $(call CATASTROPHIC_ERROR,Invalid ANALOG_MATRIX_DRIVER,ANALOG_MATRIX_DRIVER="$(ANALOG_MATRIX_DRIVER)" is not a valid analog matrix driver)
+    endif
+
+    # The analog matrix provides matrix_scan_custom(), and tracks travel with hysteresis so debouncing would only add
+    # latency
+    ifneq ($(filter-out lite,$(strip $(CUSTOM_MATRIX))),)
+        $(call CATASTROPHIC_ERROR,Invalid CUSTOM_MATRIX,CUSTOM_MATRIX="$(CUSTOM_MATRIX)" cannot be used with ANALOG_MATRIX_ENABLE)
+    endif
+    CUSTOM_MATRIX := lite
+    DEBOUNCE_TYPE ?= none
+
+    ifeq ($(strip $(ANALOG_MATRIX_DRIVER)), pins)
+        ANALOG_DRIVER_REQUIRED = yes
+        SRC += $(QUANTUM_DIR)/analog_matrix/analog_matrix_pins.c
+    endif
+endif
+
 VALID_CUSTOM_MATRIX_TYPES:= yes lite no
 
 CUSTOM_MATRIX ?= no
@@ -1009,6 +1041,31 @@ ifeq ($(strip $(ANALOG_DRIVER_REQUIRED)), yes)
     QUANTUM_LIB_SRC += analog.c
 endif
 
+ifeq ($(strip $(I2C_QUEUE_ENABLE)), yes)
+    OPT_DEFS += -DI2C_QUEUE_ENABLE
+    I2C_DRIVER_REQUIRED = yes
+    BUS_QUEUE_REQUIRED = yes
+    SRC += i2c_queue.c
+    SRC += $(PLATFORM_PATH)/$(PLATFORM_KEY)/$(DRIVER_DIR)/i2c_queue_backend.c
+endif
+
+ifeq ($(strip $(SPI_QUEUE_ENABLE)), yes)
+    OPT_DEFS += -DSPI_QUEUE_ENABLE
+    SPI_DRIVER_REQUIRED = yes
+    BUS_QUEUE_REQUIRED = yes
+    SRC += spi_queue.c
+    SRC += $(PLATFORM_PATH)/$(PLATFORM_KEY)/$(DRIVER_DIR)/spi_queue_backend.c
+endif
+
+ifeq ($(strip $(BUS_QUEUE_REQUIRED)), yes)
+    SRC += bus_queue.c
+endif
+
+ifeq ($(strip $(BUS_STATS_ENABLE)), yes)
+    OPT_DEFS += -DBUS_STATS_ENABLE
+    SRC += bus_stats.c
+endif
+
 ifeq ($(strip $(I2C_DRIVER_REQUIRED)), yes)
     OPT_DEFS += -DHAL_USE_I2C=TRUE
     QUANTUM_LIB_SRC += i2c_master.c
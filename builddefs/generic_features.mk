@@ -19,10 +19,12 @@ SEND_STRING_ENABLE ?= yes
 SPACE_CADET_ENABLE ?= yes
 
 GENERIC_FEATURES = \
+    ANALOG_MATRIX \
     AUTO_SHIFT \
     AUTOCORRECT \
     BATTERY \
     BOOTMAGIC \
+    BOOT_TRACE \
     CAPS_WORD \
     COMBO \
     COMMAND \
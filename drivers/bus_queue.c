@@ -0,0 +1,86 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "bus_queue.h"
+
+bool bus_queue_submit(bus_queue_t *queue, bus_queue_job_t *job, uint8_t priority, uint32_t device) {
+    if (job->queued || priority >= BUS_QUEUE_PRIORITY_COUNT) {
+        return false;
+    }
+
+    job->next     = NULL;
+    job->queued   = true;
+    job->priority = priority;
+    job->device   = device;
+    job->segment  = 0;
+    job->offset   = 0;
+
+    bus_queue_job_t **tail = &queue->heads[priority];
+    while (*tail != NULL) {
+        tail = &(*tail)->next;
+    }
+    *tail = job;
+    return true;
+}
+
+bool bus_queue_cancel(bus_queue_t *queue, bus_queue_job_t *job) {
+    if (!job->queued || job == queue->in_flight) {
+        return false;
+    }
+
+    for (bus_queue_job_t **link = &queue->heads[job->priority]; *link != NULL; link = &(*link)->next) {
+        if (*link == job) {
+            *link       = job->next;
+            job->queued = false;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool bus_queue_is_idle(const bus_queue_t *queue) {
+    if (queue->in_flight != NULL) {
+        return false;
+    }
+    for (uint8_t i = 0; i < BUS_QUEUE_PRIORITY_COUNT; i++) {
+        if (queue->heads[i] != NULL) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool job_is_started(const bus_queue_job_t *job) {
+    return job->segment != 0 || job->offset != 0;
+}
+
+bus_queue_job_t *bus_queue_next(const bus_queue_t *queue) {
+    for (uint8_t i = 0; i < BUS_QUEUE_PRIORITY_COUNT; i++) {
+        bus_queue_job_t *job = queue->heads[i];
+        if (job == NULL) {
+            continue;
+        }
+        if (job_is_started(job)) {
+            return job;
+        }
+
+        bool device_busy = false;
+        for (uint8_t j = 0; j < BUS_QUEUE_PRIORITY_COUNT; j++) {
+            bus_queue_job_t *other = queue->heads[j];
+            if (j != i && other != NULL && other->device == job->device && job_is_started(other)) {
+                device_busy = true;
+                break;
+            }
+        }
+        if (!device_busy) {
+            return job;
+        }
+    }
+    return NULL;
+}
+
+void bus_queue_finish(bus_queue_t *queue, bus_queue_job_t *job) {
+    // A started job is always the head of its list.
+    queue->heads[job->priority] = job->next;
+    job->queued                 = false;
+}
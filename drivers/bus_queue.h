@@ -0,0 +1,70 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * \file
+ *
+ * \brief Prioritised job lists shared by the I2C and SPI transaction queues.
+ *
+ * Each bus queue embeds a `bus_queue_job_t` in its own job type and keeps a `bus_queue_t` for its jobs. This file only
+ * tracks which jobs are waiting, in which order, and how far each has got. Building and running transfers stays with
+ * the bus queue.
+ */
+
+#define BUS_QUEUE_PRIORITY_COUNT 3
+
+typedef struct bus_queue_job_t bus_queue_job_t;
+
+/**
+ * \brief The part of a job managed by the queue.
+ */
+struct bus_queue_job_t {
+    bus_queue_job_t *next;
+    bool             queued;
+    uint8_t          priority;
+    uint32_t         device; // jobs with the same device never interleave
+    uint8_t          segment;
+    uint16_t         offset;
+};
+
+typedef struct {
+    bus_queue_job_t *heads[BUS_QUEUE_PRIORITY_COUNT];
+    bus_queue_job_t *in_flight; // the job whose transfer is on the bus
+} bus_queue_t;
+
+// The job of type `type` that embeds `link` as its member `member`
+#define BUS_QUEUE_JOB(link, type, member) ((type *)((char *)(link) - offsetof(type, member)))
+
+/**
+ * \brief Appends a job to the list for its priority.
+ *
+ * \return `false` if the job is already queued or the priority is out of range.
+ */
+bool bus_queue_submit(bus_queue_t *queue, bus_queue_job_t *job, uint8_t priority, uint32_t device);
+
+/**
+ * \brief Removes a queued job. A job whose transfer is on the bus cannot be cancelled.
+ */
+bool bus_queue_cancel(bus_queue_t *queue, bus_queue_job_t *job);
+
+/**
+ * \brief Whether no job is queued and the bus is free.
+ */
+bool bus_queue_is_idle(const bus_queue_t *queue);
+
+/**
+ * \brief Picks the job to run next: the first head, by priority, that is either already started or does not target a
+ * device another started job is in the middle of talking to.
+ */
+bus_queue_job_t *bus_queue_next(const bus_queue_t *queue);
+
+/**
+ * \brief Removes a started job from the head of its list once it has completed or failed, before its callback runs.
+ */
+void bus_queue_finish(bus_queue_t *queue, bus_queue_job_t *job);
@@ -0,0 +1,109 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "bus_stats.h"
+#include <string.h>
+#include "atomic_util.h"
+#include "timer.h"
+#include "print.h"
+#include "progmem.h"
+#include "compiler_support.h"
+
+static bus_stats_t bus_stats[BUS_STATS_BUS_COUNT];
+static uint32_t    bus_stats_start_us[BUS_STATS_BUS_COUNT];
+static uint8_t     bus_stats_open; // bitmask of buses with a transaction in progress
+static uint32_t    bus_stats_reset_us;
+
+STATIC_ASSERT(BUS_STATS_BUS_COUNT <= 8, "Too many buses for the open transaction mask");
+STATIC_ASSERT(sizeof(bus_stats_t) == 20, "bus_stats_t should not contain padding");
+
+void bus_stats_begin(bus_stats_bus_t bus) {
+    // The I2C queue's worker thread may share a bus with the main loop
+    ATOMIC_BLOCK_RESTORESTATE {
+        if (!(bus_stats_open & (1 << bus))) {
+            bus_stats_open |= 1 << bus;
+            bus_stats_start_us[bus] = timer_read_us32();
+        }
+    }
+}
+
+void bus_stats_end(bus_stats_bus_t bus, uint32_t bytes, int16_t status) {
+    uint32_t now = timer_read_us32();
+    ATOMIC_BLOCK_RESTORESTATE {
+        if (bus_stats_open & (1 << bus)) {
+            bus_stats_open &= ~(1 << bus);
+
+            bus_stats_t *stats    = &bus_stats[bus];
+            uint32_t     duration = TIMER_DIFF_32(now, bus_stats_start_us[bus]);
+            stats->transactions++;
+            stats->bytes += bytes;
+            stats->busy_us += duration;
+            if (duration > stats->max_latency_us) {
+                stats->max_latency_us = duration;
+            }
+            if (status == BUS_STATS_TIMEOUT) {
+                stats->timeouts++;
+            } else if (status < 0) {
+                stats->errors++;
+            }
+        }
+    }
+}
+
+void bus_stats_get(bus_stats_bus_t bus, bus_stats_t *stats) {
+    if (bus >= BUS_STATS_BUS_COUNT) {
+        memset(stats, 0, sizeof(bus_stats_t));
+        return;
+    }
+    ATOMIC_BLOCK_RESTORESTATE {
+        *stats = bus_stats[bus];
+    }
+}
+
+uint32_t bus_stats_elapsed_us(void) {
+    return timer_elapsed_us32(bus_stats_reset_us);
+}
+
+void bus_stats_reset(void) {
+    ATOMIC_BLOCK_RESTORESTATE {
+        memset(bus_stats, 0, sizeof(bus_stats));
+        bus_stats_reset_us = timer_read_us32();
+    }
+}
+
+#ifndef NO_PRINT
+static const char *bus_stats_bus_name(uint8_t bus) {
+    switch (bus) {
+        case BUS_STATS_I2C:
+            return PSTR("i2c");
+        case BUS_STATS_SPI:
+            return PSTR("spi");
+        case BUS_STATS_SERIAL:
+            return PSTR("serial");
+        default:
+            return PSTR("?");
+    }
+}
+#endif // NO_PRINT
+
+void bus_stats_print(void) {
+#ifndef NO_PRINT
+    uint32_t elapsed = bus_stats_elapsed_us();
+    uprintf("bus stats over %lu ms\n", elapsed / 1000);
+
+    bus_stats_t stats;
+    for (uint8_t bus = 0; bus < BUS_STATS_BUS_COUNT; bus++) {
+        bus_stats_get(bus, &stats);
+        if (stats.transactions == 0) {
+            continue;
+        }
+        // Busy time in tenths of a percent, without overflowing for long intervals
+        uint32_t busy = elapsed >= 1000 ? stats.busy_us / (elapsed / 1000) : 0;
+#    if defined(__AVR__)
+        uprintf("%S: %lu xfers, %lu bytes, busy %lu.%lu%%, max %lu us, %u errors, %u timeouts\n", bus_stats_bus_name(bus), stats.transactions, stats.bytes, busy / 10, busy % 10, stats.max_latency_us, stats.errors, stats.timeouts);
+#    else
+        uprintf("%s: %lu xfers, %lu bytes, busy %lu.%lu%%, max %lu us, %u errors, %u timeouts\n", bus_stats_bus_name(bus), stats.transactions, stats.bytes, busy / 10, busy % 10, stats.max_latency_us, stats.errors, stats.timeouts);
+#    endif
+    }
+#endif // NO_PRINT
+}
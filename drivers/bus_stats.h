@@ -0,0 +1,69 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef enum {
+    BUS_STATS_I2C,    // i2c_master, including transfers made by the I2C queue
+    BUS_STATS_SPI,    // spi_master
+    BUS_STATS_SERIAL, // split serial transactions, whichever SERIAL_DRIVER carries them; timeouts count as errors
+    BUS_STATS_BUS_COUNT,
+} bus_stats_bus_t;
+
+// Transaction results, with the same values as the I2C_STATUS_* and SPI_STATUS_* codes
+#define BUS_STATS_SUCCESS (0)
+#define BUS_STATS_ERROR (-1)
+#define BUS_STATS_TIMEOUT (-2)
+
+// Totals since the last bus_stats_reset(). The fields have no padding between them, so the struct can be copied
+// straight into a raw HID report.
+typedef struct {
+    uint32_t transactions;
+    uint32_t bytes;
+    uint32_t busy_us;        // time spent inside transactions
+    uint32_t max_latency_us; // longest single transaction
+    uint16_t errors;
+    uint16_t timeouts;
+} bus_stats_t;
+
+#ifdef BUS_STATS_ENABLE
+
+// Marks the start of a transaction on `bus`. Further starts are ignored until the transaction ends, so a repeated
+// start condition stays part of the transaction it belongs to.
+#    define BUS_STATS_BEGIN(bus) bus_stats_begin(BUS_STATS_##bus)
+// Marks the end of the open transaction on `bus`, which moved `bytes` and finished with `status`
+#    define BUS_STATS_END(bus, bytes, status) bus_stats_end(BUS_STATS_##bus, bytes, status)
+
+#else
+
+#    define BUS_STATS_BEGIN(bus)
+#    define BUS_STATS_END(bus, bytes, status)
+
+#endif
+
+// Don't call directly, use the macros instead
+void bus_stats_begin(bus_stats_bus_t bus);
+void bus_stats_end(bus_stats_bus_t bus, uint32_t bytes, int16_t status);
+
+/**
+ * @brief Copies the totals for `bus` into `stats`.
+ */
+void bus_stats_get(bus_stats_bus_t bus, bus_stats_t *stats);
+
+/**
+ * @brief Time since the totals were last reset, for working out how busy each bus is.
+ */
+uint32_t bus_stats_elapsed_us(void);
+
+/**
+ * @brief Clears the totals of every bus.
+ */
+void bus_stats_reset(void);
+
+/**
+ * @brief Prints the totals of every bus that has been used to the console.
+ */
+void bus_stats_print(void);
@@ -17,11 +17,26 @@
 
 #include "drv2605l.h"
 #include "i2c_master.h"
+#ifdef I2C_QUEUE_ENABLE
+#    include "i2c_queue.h"
+#endif
 #include <math.h>
+#include <string.h>
 
 uint8_t drv2605l_write_buffer[2];
 uint8_t drv2605l_read_buffer;
 
+// The sequence being loaded, terminated by 0 when it does not fill all of the sequencer.
+static uint8_t sequence_buffer[DRV2605L_SEQUENCE_LENGTH + 1];
+
+#ifdef I2C_QUEUE_ENABLE
+// A sequence is queued as one job: stop playback, load the sequencer, start playback.
+static const uint8_t go_stop  = 0x00;
+static const uint8_t go_start = 0x01;
+static i2c_segment_t sequence_segments[3];
+static i2c_job_t     sequence_job;
+#endif
+
 void drv2605l_write(uint8_t reg_addr, uint8_t data) {
     drv2605l_write_buffer[0] = reg_addr;
     drv2605l_write_buffer[1] = data;
@@ -120,7 +135,53 @@ void drv2605l_amplitude(uint8_t amplitude) {
 }
 
 void drv2605l_pulse(uint8_t sequence) {
+    drv2605l_sequence(&sequence, 1);
+}
+
+// Plays up to DRV2605L_SEQUENCE_LENGTH effects back to back, cutting off whatever was playing.
+void drv2605l_sequence(const uint8_t *sequence, uint8_t length) {
+    if (length > DRV2605L_SEQUENCE_LENGTH) {
+        length = DRV2605L_SEQUENCE_LENGTH;
+    }
+
+#ifdef I2C_QUEUE_ENABLE
+    // The job reads sequence_buffer while it runs.
+    while (i2c_job_is_busy(&sequence_job)) {
+        i2c_queue_task();
+    }
+#endif
+
+    memcpy(sequence_buffer, sequence, length);
+    uint8_t count = length;
+    if (count < DRV2605L_SEQUENCE_LENGTH) {
+        sequence_buffer[count++] = 0;
+    }
+
+#ifdef I2C_QUEUE_ENABLE
+    sequence_segments[0] = (i2c_segment_t)I2C_SEGMENT_WRITE(DRV2605L_REG_GO, &go_stop, 1);
+    sequence_segments[1] = (i2c_segment_t)I2C_SEGMENT_WRITE(DRV2605L_REG_WAVEFORM_SEQUENCER_1, sequence_buffer, count);
+    sequence_segments[2] = (i2c_segment_t)I2C_SEGMENT_WRITE(DRV2605L_REG_GO, &go_start, 1);
+
+    sequence_job = (i2c_job_t){
+        .address       = DRV2605L_I2C_ADDRESS << 1,
+        .priority      = I2C_QUEUE_PRIORITY_NORMAL,
+        .segment_count = 3,
+        .segments      = sequence_segments,
+        .timeout       = 100,
+    };
+    i2c_queue_submit(&sequence_job);
+#else
     drv2605l_write(DRV2605L_REG_GO, 0x00);
-    drv2605l_write(DRV2605L_REG_WAVEFORM_SEQUENCER_1, sequence);
+    i2c_write_register(DRV2605L_I2C_ADDRESS << 1, DRV2605L_REG_WAVEFORM_SEQUENCER_1, sequence_buffer, count, 100);
     drv2605l_write(DRV2605L_REG_GO, 0x01);
+#endif
+}
+
+// Whether a sequence is still being sent, in which case drv2605l_sequence() would block.
+bool drv2605l_sequence_is_busy(void) {
+#ifdef I2C_QUEUE_ENABLE
+    return i2c_job_is_busy(&sequence_job);
+#else
+    return false;
+#endif
 }
@@ -18,6 +18,7 @@
 #pragma once
 
 #include <stdint.h>
+#include <stdbool.h>
 
 /* Initialization settings
 
@@ -174,6 +175,13 @@ uint8_t drv2605l_read(const uint8_t reg_addr);
 void    drv2605l_rtp_init(void);
 void    drv2605l_amplitude(const uint8_t amplitude);
 void    drv2605l_pulse(const uint8_t sequence);
+void    drv2605l_sequence(const uint8_t *sequence, uint8_t length);
+bool    drv2605l_sequence_is_busy(void);
+
+/* Number of entries in the waveform sequencer */
+#define DRV2605L_SEQUENCE_LENGTH 8
+/* A sequencer entry that pauses instead of playing an effect, in steps of 10ms up to 1270ms */
+#define DRV2605L_SEQUENCE_WAIT_MS(ms) (0x80 | ((ms) / 10))
 
 typedef enum drv2605l_effect_t {
     DRV2605L_EFFECT_CLEAR_SEQUENCE,
@@ -0,0 +1,137 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "i2c_queue.h"
+#include <string.h>
+#include "util.h"
+
+static bus_queue_t queue;
+static bool        is_initialised = false;
+
+// Where the job whose transfer is on the bus resumes once that transfer succeeds.
+static uint8_t        resume_segment;
+static uint16_t       resume_offset;
+static i2c_transfer_t transfer;
+static uint8_t        transfer_buffer[I2C_QUEUE_BUFFER_SIZE];
+
+static volatile bool         transfer_done;
+static volatile i2c_status_t transfer_status;
+
+void i2c_queue_backend_complete(i2c_status_t status) {
+    transfer_status = status;
+    transfer_done   = true;
+}
+
+bool i2c_queue_submit(i2c_job_t *job) {
+    if (job->link.queued || job->segment_count == 0) {
+        return false;
+    }
+
+    if (!is_initialised) {
+        is_initialised = true;
+        i2c_queue_backend_init();
+    }
+
+    job->attempts = 0;
+    return bus_queue_submit(&queue, &job->link, job->priority, job->address);
+}
+
+bool i2c_queue_cancel(i2c_job_t *job) {
+    return bus_queue_cancel(&queue, &job->link);
+}
+
+bool i2c_job_is_busy(const i2c_job_t *job) {
+    return job->link.queued;
+}
+
+bool i2c_queue_is_idle(void) {
+    return bus_queue_is_idle(&queue);
+}
+
+static void start_transfer(i2c_job_t *job) {
+    const i2c_segment_t *segment = &job->segments[job->link.segment];
+
+    transfer_buffer[0] = segment->reg + job->link.offset;
+    transfer.address   = job->address;
+    transfer.tx_data   = transfer_buffer;
+    transfer.tx_length = 1;
+    transfer.rx_data   = NULL;
+    transfer.rx_length = 0;
+    transfer.timeout   = job->timeout;
+    resume_segment     = job->link.segment;
+    resume_offset      = job->link.offset;
+
+    if (segment->rx_data != NULL) {
+        transfer.rx_data   = segment->rx_data;
+        transfer.rx_length = segment->length;
+        resume_segment++;
+        resume_offset = 0;
+    } else {
+        // Fill the buffer from as many write segments as continue the same run of auto-incremented registers.
+        while (transfer.tx_length < I2C_QUEUE_BUFFER_SIZE) {
+            uint16_t chunk = MIN(segment->length - resume_offset, I2C_QUEUE_BUFFER_SIZE - transfer.tx_length);
+            memcpy(&transfer_buffer[transfer.tx_length], segment->tx_data + resume_offset, chunk);
+            transfer.tx_length += chunk;
+            resume_offset += chunk;
+            if (resume_offset < segment->length) {
+                break;
+            }
+
+            resume_segment++;
+            resume_offset = 0;
+            if (resume_segment == job->segment_count) {
+                break;
+            }
+            const i2c_segment_t *next = &job->segments[resume_segment];
+            if (next->tx_data == NULL || next->reg != segment->reg + segment->length) {
+                break;
+            }
+            segment = next;
+        }
+    }
+
+    queue.in_flight = &job->link;
+    transfer_done   = false;
+    i2c_queue_backend_start(&transfer);
+}
+
+static void finish_job(i2c_job_t *job, i2c_status_t status) {
+    bus_queue_finish(&queue, &job->link);
+    if (job->callback != NULL) {
+        job->callback(job, status);
+    }
+}
+
+void i2c_queue_task(void) {
+    if (queue.in_flight != NULL) {
+        if (!transfer_done) {
+            return;
+        }
+
+        i2c_job_t *job  = BUS_QUEUE_JOB(queue.in_flight, i2c_job_t, link);
+        queue.in_flight = NULL;
+        if (transfer_status == I2C_STATUS_SUCCESS) {
+            job->link.segment = resume_segment;
+            job->link.offset  = resume_offset;
+            job->attempts     = 0;
+            if (job->link.segment == job->segment_count) {
+                finish_job(job, I2C_STATUS_SUCCESS);
+            }
+        } else if (job->attempts < job->retries) {
+            job->attempts++;
+        } else {
+            finish_job(job, transfer_status);
+        }
+    }
+
+    bus_queue_job_t *next = bus_queue_next(&queue);
+    if (next != NULL) {
+        start_transfer(BUS_QUEUE_JOB(next, i2c_job_t, link));
+    }
+}
+
+void i2c_queue_flush(void) {
+    while (!i2c_queue_is_idle()) {
+        i2c_queue_task();
+    }
+}
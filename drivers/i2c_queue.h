@@ -0,0 +1,126 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "i2c_master.h"
+#include "bus_queue.h"
+
+/**
+ * \file
+ *
+ * \defgroup i2c_queue I2C Transaction Queue
+ *
+ * \brief Non-blocking I2C jobs, serviced from the main loop.
+ *
+ * A job is a list of register reads and writes for one device. Jobs are owned by the caller, queued by priority and
+ * executed one transfer at a time by `i2c_queue_task()`, which also invokes the completion callback once the last
+ * segment has been transferred or a transfer has failed. Consecutive write segments covering adjacent registers are
+ * packed into a single transfer, and long writes are split to fit `I2C_QUEUE_BUFFER_SIZE`.
+ *
+ * Between two transfers of a started job, a job of higher priority may run, as long as it targets another device.
+ * \{
+ */
+
+#ifndef I2C_QUEUE_BUFFER_SIZE
+#    define I2C_QUEUE_BUFFER_SIZE 64
+#endif
+
+typedef enum {
+    I2C_QUEUE_PRIORITY_HIGH,
+    I2C_QUEUE_PRIORITY_NORMAL,
+    I2C_QUEUE_PRIORITY_LOW,
+    I2C_QUEUE_PRIORITY_COUNT = BUS_QUEUE_PRIORITY_COUNT,
+} i2c_queue_priority_t;
+
+/**
+ * \brief One register access of a job. Exactly one of `tx_data` and `rx_data` is set.
+ */
+typedef struct {
+    uint8_t        reg;
+    uint16_t       length;
+    const uint8_t *tx_data;
+    uint8_t       *rx_data;
+} i2c_segment_t;
+
+#define I2C_SEGMENT_WRITE(reg_, data, length_) \
+    { .reg = (reg_), .length = (length_), .tx_data = (data), .rx_data = NULL }
+#define I2C_SEGMENT_READ(reg_, data, length_) \
+    { .reg = (reg_), .length = (length_), .tx_data = NULL, .rx_data = (data) }
+
+typedef struct i2c_job_t i2c_job_t;
+
+typedef void (*i2c_job_callback_t)(i2c_job_t *job, i2c_status_t status);
+
+struct i2c_job_t {
+    uint8_t              address; // shifted as for the rest of the I2C API
+    uint8_t              priority;
+    uint8_t              retries; // extra attempts of a failed transfer before the job fails
+    uint8_t              segment_count;
+    const i2c_segment_t *segments;
+    uint16_t             timeout;
+    i2c_job_callback_t   callback;
+    void                *user_data;
+
+    // Managed by the queue.
+    bus_queue_job_t link;
+    uint8_t         attempts;
+};
+
+/**
+ * \brief A single bus transaction handed to the backend: write `tx_data`, then read into `rx_data` if `rx_length` is set.
+ */
+typedef struct {
+    uint8_t        address;
+    const uint8_t *tx_data;
+    uint16_t       tx_length;
+    uint8_t       *rx_data;
+    uint16_t       rx_length;
+    uint16_t       timeout;
+} i2c_transfer_t;
+
+/**
+ * \brief Queue a job. The job and everything it points to must stay valid until its callback has run.
+ *
+ * \return `false` if the job is already queued or has no segments.
+ */
+bool i2c_queue_submit(i2c_job_t *job);
+
+/**
+ * \brief Remove a queued job without running its callback. A job whose transfer is on the bus cannot be cancelled.
+ */
+bool i2c_queue_cancel(i2c_job_t *job);
+
+/**
+ * \brief Whether the job is queued or running.
+ */
+bool i2c_job_is_busy(const i2c_job_t *job);
+
+/**
+ * \brief Whether no job is queued and the bus is free.
+ */
+bool i2c_queue_is_idle(void);
+
+/**
+ * \brief Reap the finished transfer, if any, and start the next one. Called from the main loop.
+ */
+void i2c_queue_task(void);
+
+/**
+ * \brief Run the queue until it is idle. Blocks, and is meant for init and shutdown paths.
+ */
+void i2c_queue_flush(void);
+
+/**
+ * \brief Backend interface, implemented per platform.
+ *
+ * `i2c_queue_backend_start()` starts a transfer and returns; the backend then reports the result exactly once through
+ * `i2c_queue_backend_complete()`, from any context, including from within `i2c_queue_backend_start()` itself.
+ */
+void i2c_queue_backend_init(void);
+void i2c_queue_backend_start(const i2c_transfer_t *transfer);
+void i2c_queue_backend_complete(i2c_status_t status);
+
+/** \} */
@@ -21,8 +21,14 @@
 #include "i2c_master.h"
 #include "gpio.h"
 #include "wait.h"
+#ifdef I2C_QUEUE_ENABLE
+#    include "i2c_queue.h"
+#endif
 
 #define IS31FL3733_PWM_REGISTER_COUNT 192
+// The PWM registers are sent in chunks of 16, and only the chunks that changed.
+#define IS31FL3733_PWM_CHUNK_SIZE 16
+#define IS31FL3733_PWM_CHUNK_COUNT (IS31FL3733_PWM_REGISTER_COUNT / IS31FL3733_PWM_CHUNK_SIZE)
 #define IS31FL3733_LED_CONTROL_REGISTER_COUNT 24
 
 #ifndef IS31FL3733_I2C_TIMEOUT
@@ -95,19 +101,36 @@ const uint8_t driver_sync[IS31FL3733_DRIVER_COUNT] = {
 // buffers and the transfers in is31fl3733_write_pwm_buffer() but it's
 // probably not worth the extra complexity.
 typedef struct is31fl3733_driver_t {
-    uint8_t pwm_buffer[IS31FL3733_PWM_REGISTER_COUNT];
-    bool    pwm_buffer_dirty;
-    uint8_t led_control_buffer[IS31FL3733_LED_CONTROL_REGISTER_COUNT];
-    bool    led_control_buffer_dirty;
+    uint8_t  pwm_buffer[IS31FL3733_PWM_REGISTER_COUNT];
+    uint16_t pwm_buffer_dirty; // one bit per chunk
+    uint8_t  led_control_buffer[IS31FL3733_LED_CONTROL_REGISTER_COUNT];
+    bool     led_control_buffer_dirty;
 } PACKED is31fl3733_driver_t;
 
 is31fl3733_driver_t driver_buffers[IS31FL3733_DRIVER_COUNT] = {{
     .pwm_buffer               = {0},
-    .pwm_buffer_dirty         = false,
+    .pwm_buffer_dirty         = 0,
     .led_control_buffer       = {0},
     .led_control_buffer_dirty = false,
 }};
 
+#ifdef I2C_QUEUE_ENABLE
+// A PWM frame is queued as one job: select page PWM, then write the dirty chunks, which the queue packs into as few
+// transfers as it can. Frames of all drivers are queued together and go out back to back while the main loop carries
+// on. The PWM buffers are read while the job runs, so an update made meanwhile shows up at the latest with the next
+// frame.
+static const uint8_t write_lock_magic = IS31FL3733_COMMAND_WRITE_LOCK_MAGIC;
+static const uint8_t pwm_page         = IS31FL3733_COMMAND_PWM;
+static i2c_segment_t pwm_segments[IS31FL3733_DRIVER_COUNT][2 + IS31FL3733_PWM_CHUNK_COUNT];
+static i2c_job_t     pwm_jobs[IS31FL3733_DRIVER_COUNT];
+
+// A frame flushed while the previous one was still being sent goes out as soon as it is done, so flushing the queue
+// always ends with the latest frame.
+static void pwm_job_done(i2c_job_t *job, i2c_status_t status) {
+    is31fl3733_update_pwm_buffers(job - pwm_jobs);
+}
+#endif
+
 void is31fl3733_write_register(uint8_t index, uint8_t reg, uint8_t data) {
 #if IS31FL3733_I2C_PERSISTENCE > 0
     for (uint8_t i = 0; i < IS31FL3733_I2C_PERSISTENCE; i++) {
@@ -119,26 +142,61 @@ void is31fl3733_write_register(uint8_t index, uint8_t reg, uint8_t data) {
 }
 
 void is31fl3733_select_page(uint8_t index, uint8_t page) {
+#ifdef I2C_QUEUE_ENABLE
+    // A queued frame relies on the page it selected, so let it finish first.
+    while (i2c_job_is_busy(&pwm_jobs[index])) {
+        i2c_queue_task();
+    }
+#endif
     is31fl3733_write_register(index, IS31FL3733_REG_COMMAND_WRITE_LOCK, IS31FL3733_COMMAND_WRITE_LOCK_MAGIC);
     is31fl3733_write_register(index, IS31FL3733_REG_COMMAND, page);
 }
 
 void is31fl3733_write_pwm_buffer(uint8_t index) {
     // Assumes page 1 is already selected.
-    // Transmit PWM registers in 12 transfers of 16 bytes.
+    // Transmit the dirty PWM registers in transfers of 16 bytes.
 
     // Iterate over the pwm_buffer contents at 16 byte intervals.
-    for (uint8_t i = 0; i < IS31FL3733_PWM_REGISTER_COUNT; i += 16) {
+    for (uint8_t i = 0; i < IS31FL3733_PWM_REGISTER_COUNT; i += IS31FL3733_PWM_CHUNK_SIZE) {
+        if (!(driver_buffers[index].pwm_buffer_dirty & (1 << (i / IS31FL3733_PWM_CHUNK_SIZE)))) {
+            continue;
+        }
 #if IS31FL3733_I2C_PERSISTENCE > 0
         for (uint8_t j = 0; j < IS31FL3733_I2C_PERSISTENCE; j++) {
-            if (i2c_write_register(i2c_addresses[index] << 1, i, driver_buffers[index].pwm_buffer + i, 16, IS31FL3733_I2C_TIMEOUT) == I2C_STATUS_SUCCESS) break;
+            if (i2c_write_register(i2c_addresses[index] << 1, i, driver_buffers[index].pwm_buffer + i, IS31FL3733_PWM_CHUNK_SIZE, IS31FL3733_I2C_TIMEOUT) == I2C_STATUS_SUCCESS) break;
         }
 #else
-        i2c_write_register(i2c_addresses[index] << 1, i, driver_buffers[index].pwm_buffer + i, 16, IS31FL3733_I2C_TIMEOUT);
+        i2c_write_register(i2c_addresses[index] << 1, i, driver_buffers[index].pwm_buffer + i, IS31FL3733_PWM_CHUNK_SIZE, IS31FL3733_I2C_TIMEOUT);
 #endif
     }
 }
 
+#ifdef I2C_QUEUE_ENABLE
+static void queue_pwm_buffer(uint8_t index) {
+    i2c_segment_t *segments = pwm_segments[index];
+    uint8_t        count    = 0;
+
+    segments[count++] = (i2c_segment_t)I2C_SEGMENT_WRITE(IS31FL3733_REG_COMMAND_WRITE_LOCK, &write_lock_magic, 1);
+    segments[count++] = (i2c_segment_t)I2C_SEGMENT_WRITE(IS31FL3733_REG_COMMAND, &pwm_page, 1);
+    for (uint8_t i = 0; i < IS31FL3733_PWM_REGISTER_COUNT; i += IS31FL3733_PWM_CHUNK_SIZE) {
+        if (driver_buffers[index].pwm_buffer_dirty & (1 << (i / IS31FL3733_PWM_CHUNK_SIZE))) {
+            segments[count++] = (i2c_segment_t)I2C_SEGMENT_WRITE(i, driver_buffers[index].pwm_buffer + i, IS31FL3733_PWM_CHUNK_SIZE);
+        }
+    }
+
+    pwm_jobs[index] = (i2c_job_t){
+        .address       = i2c_addresses[index] << 1,
+        .priority      = I2C_QUEUE_PRIORITY_LOW,
+        .retries       = IS31FL3733_I2C_PERSISTENCE > 0 ? IS31FL3733_I2C_PERSISTENCE - 1 : 0,
+        .segment_count = count,
+        .segments      = segments,
+        .timeout       = IS31FL3733_I2C_TIMEOUT,
+        .callback      = pwm_job_done,
+    };
+    i2c_queue_submit(&pwm_jobs[index]);
+}
+#endif
+
 void is31fl3733_init_drivers(void) {
     i2c_init();
 
@@ -211,7 +269,7 @@ void is31fl3733_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
         driver_buffers[led.driver].pwm_buffer[led.r] = red;
         driver_buffers[led.driver].pwm_buffer[led.g] = green;
         driver_buffers[led.driver].pwm_buffer[led.b] = blue;
-        driver_buffers[led.driver].pwm_buffer_dirty  = true;
+        driver_buffers[led.driver].pwm_buffer_dirty |= (1 << (led.r / IS31FL3733_PWM_CHUNK_SIZE)) | (1 << (led.g / IS31FL3733_PWM_CHUNK_SIZE)) | (1 << (led.b / IS31FL3733_PWM_CHUNK_SIZE));
     }
 }
 
@@ -252,12 +310,22 @@ void is31fl3733_set_led_control_register(uint8_t index, bool red, bool green, bo
 }
 
 void is31fl3733_update_pwm_buffers(uint8_t index) {
+#ifdef I2C_QUEUE_ENABLE
+    // The previous frame is still being sent; this one goes out once it is done.
+    if (i2c_job_is_busy(&pwm_jobs[index])) {
+        return;
+    }
+#endif
     if (driver_buffers[index].pwm_buffer_dirty) {
+#ifdef I2C_QUEUE_ENABLE
+        queue_pwm_buffer(index);
+#else
         is31fl3733_select_page(index, IS31FL3733_COMMAND_PWM);
 
         is31fl3733_write_pwm_buffer(index);
+#endif
 
-        driver_buffers[index].pwm_buffer_dirty = false;
+        driver_buffers[index].pwm_buffer_dirty = 0;
     }
 }
 
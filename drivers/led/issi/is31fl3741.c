@@ -21,6 +21,9 @@
 #include "i2c_master.h"
 #include "gpio.h"
 #include "wait.h"
+#ifdef I2C_QUEUE_ENABLE
+#    include "i2c_queue.h"
+#endif
 
 #define IS31FL3741_PWM_0_REGISTER_COUNT 180
 #define IS31FL3741_PWM_1_REGISTER_COUNT 171
@@ -92,6 +95,21 @@ is31fl3741_driver_t driver_buffers[IS31FL3741_DRIVER_COUNT] = {{
     .scaling_buffer_dirty = false,
 }};
 
+#ifdef I2C_QUEUE_ENABLE
+// A PWM frame is queued as one job: select page PWM0, write it, select page PWM1, write it. The PWM buffers are read
+// while the job runs, so an update made meanwhile shows up at the latest with the next frame.
+static const uint8_t write_lock_magic = IS31FL3741_COMMAND_WRITE_LOCK_MAGIC;
+static const uint8_t pwm_pages[]      = {IS31FL3741_COMMAND_PWM_0, IS31FL3741_COMMAND_PWM_1};
+static i2c_segment_t pwm_segments[IS31FL3741_DRIVER_COUNT][6];
+static i2c_job_t     pwm_jobs[IS31FL3741_DRIVER_COUNT];
+
+// A frame flushed while the previous one was still being sent goes out as soon as it is done, so flushing the queue
+// always ends with the latest frame.
+static void pwm_job_done(i2c_job_t *job, i2c_status_t status) {
+    is31fl3741_update_pwm_buffers(job - pwm_jobs);
+}
+#endif
+
 void is31fl3741_write_register(uint8_t index, uint8_t reg, uint8_t data) {
 #if IS31FL3741_I2C_PERSISTENCE > 0
     for (uint8_t i = 0; i < IS31FL3741_I2C_PERSISTENCE; i++) {
@@ -103,11 +121,41 @@ void is31fl3741_write_register(uint8_t index, uint8_t reg, uint8_t data) {
 }
 
 void is31fl3741_select_page(uint8_t index, uint8_t page) {
+#ifdef I2C_QUEUE_ENABLE
+    // A queued frame relies on the page it selected, so let it finish first.
+    while (i2c_job_is_busy(&pwm_jobs[index])) {
+        i2c_queue_task();
+    }
+#endif
     is31fl3741_write_register(index, IS31FL3741_REG_COMMAND_WRITE_LOCK, IS31FL3741_COMMAND_WRITE_LOCK_MAGIC);
     is31fl3741_write_register(index, IS31FL3741_REG_COMMAND, page);
 }
 
 void is31fl3741_write_pwm_buffer(uint8_t index) {
+#ifdef I2C_QUEUE_ENABLE
+    if (i2c_job_is_busy(&pwm_jobs[index])) {
+        return;
+    }
+
+    i2c_segment_t *segments = pwm_segments[index];
+    segments[0]             = (i2c_segment_t)I2C_SEGMENT_WRITE(IS31FL3741_REG_COMMAND_WRITE_LOCK, &write_lock_magic, 1);
+    segments[1]             = (i2c_segment_t)I2C_SEGMENT_WRITE(IS31FL3741_REG_COMMAND, &pwm_pages[0], 1);
+    segments[2]             = (i2c_segment_t)I2C_SEGMENT_WRITE(0, driver_buffers[index].pwm_buffer_0, IS31FL3741_PWM_0_REGISTER_COUNT);
+    segments[3]             = (i2c_segment_t)I2C_SEGMENT_WRITE(IS31FL3741_REG_COMMAND_WRITE_LOCK, &write_lock_magic, 1);
+    segments[4]             = (i2c_segment_t)I2C_SEGMENT_WRITE(IS31FL3741_REG_COMMAND, &pwm_pages[1], 1);
+    segments[5]             = (i2c_segment_t)I2C_SEGMENT_WRITE(0, driver_buffers[index].pwm_buffer_1, IS31FL3741_PWM_1_REGISTER_COUNT);
+
+    pwm_jobs[index] = (i2c_job_t){
+        .address       = i2c_addresses[index] << 1,
+        .priority      = I2C_QUEUE_PRIORITY_LOW,
+        .retries       = IS31FL3741_I2C_PERSISTENCE > 0 ? IS31FL3741_I2C_PERSISTENCE - 1 : 0,
+        .segment_count = 6,
+        .segments      = segments,
+        .timeout       = IS31FL3741_I2C_TIMEOUT,
+        .callback      = pwm_job_done,
+    };
+    i2c_queue_submit(&pwm_jobs[index]);
+#else
     is31fl3741_select_page(index, IS31FL3741_COMMAND_PWM_0);
 
     // Transmit PWM0 registers in 6 transfers of 30 bytes.
@@ -137,6 +185,7 @@ void is31fl3741_write_pwm_buffer(uint8_t index) {
         i2c_write_register(i2c_addresses[index] << 1, i, driver_buffers[index].pwm_buffer_1 + i, 19, IS31FL3741_I2C_TIMEOUT);
 #endif
     }
+#endif
 }
 
 void is31fl3741_init_drivers(void) {
@@ -244,6 +293,12 @@ void is31fl3741_set_led_control_register(uint8_t index, bool red, bool green, bo
 }
 
 void is31fl3741_update_pwm_buffers(uint8_t index) {
+#ifdef I2C_QUEUE_ENABLE
+    // The previous frame is still being sent; this one goes out once it is done.
+    if (i2c_job_is_busy(&pwm_jobs[index])) {
+        return;
+    }
+#endif
     if (driver_buffers[index].pwm_buffer_dirty) {
         is31fl3741_write_pwm_buffer(index);
 
@@ -17,8 +17,14 @@
 #include "snled27351.h"
 #include "i2c_master.h"
 #include "gpio.h"
+#ifdef I2C_QUEUE_ENABLE
+#    include "i2c_queue.h"
+#endif
 
 #define SNLED27351_PWM_REGISTER_COUNT 192
+// The PWM registers are sent in chunks of 16, and only the chunks that changed.
+#define SNLED27351_PWM_CHUNK_SIZE 16
+#define SNLED27351_PWM_CHUNK_COUNT (SNLED27351_PWM_REGISTER_COUNT / SNLED27351_PWM_CHUNK_SIZE)
 #define SNLED27351_LED_CONTROL_REGISTER_COUNT 24
 
 #ifndef SNLED27351_I2C_TIMEOUT
@@ -57,19 +63,35 @@ const uint8_t i2c_addresses[SNLED27351_DRIVER_COUNT] = {
 // buffers and the transfers in snled27351_write_pwm_buffer() but it's
 // probably not worth the extra complexity.
 typedef struct snled27351_driver_t {
-    uint8_t pwm_buffer[SNLED27351_PWM_REGISTER_COUNT];
-    bool    pwm_buffer_dirty;
-    uint8_t led_control_buffer[SNLED27351_LED_CONTROL_REGISTER_COUNT];
-    bool    led_control_buffer_dirty;
+    uint8_t  pwm_buffer[SNLED27351_PWM_REGISTER_COUNT];
+    uint16_t pwm_buffer_dirty; // one bit per chunk
+    uint8_t  led_control_buffer[SNLED27351_LED_CONTROL_REGISTER_COUNT];
+    bool     led_control_buffer_dirty;
 } PACKED snled27351_driver_t;
 
 snled27351_driver_t driver_buffers[SNLED27351_DRIVER_COUNT] = {{
     .pwm_buffer               = {0},
-    .pwm_buffer_dirty         = false,
+    .pwm_buffer_dirty         = 0,
     .led_control_buffer       = {0},
     .led_control_buffer_dirty = false,
 }};
 
+#ifdef I2C_QUEUE_ENABLE
+// A PWM frame is queued as one job: select PG1, then write the dirty chunks, which the queue packs into as few
+// transfers as it can. Frames of all drivers are queued together and go out back to back while the main loop carries
+// on. The PWM buffers are read while the job runs, so an update made meanwhile shows up at the latest with the next
+// frame.
+static const uint8_t pwm_page = SNLED27351_COMMAND_PWM;
+static i2c_segment_t pwm_segments[SNLED27351_DRIVER_COUNT][1 + SNLED27351_PWM_CHUNK_COUNT];
+static i2c_job_t     pwm_jobs[SNLED27351_DRIVER_COUNT];
+
+// A frame flushed while the previous one was still being sent goes out as soon as it is done, so flushing the queue
+// always ends with the latest frame.
+static void pwm_job_done(i2c_job_t *job, i2c_status_t status) {
+    snled27351_update_pwm_buffers(job - pwm_jobs);
+}
+#endif
+
 void snled27351_write_register(uint8_t index, uint8_t reg, uint8_t data) {
 #if SNLED27351_I2C_PERSISTENCE > 0
     for (uint8_t i = 0; i < SNLED27351_I2C_PERSISTENCE; i++) {
@@ -81,25 +103,59 @@ void snled27351_write_register(uint8_t index, uint8_t reg, uint8_t data) {
 }
 
 void snled27351_select_page(uint8_t index, uint8_t page) {
+#ifdef I2C_QUEUE_ENABLE
+    // A queued frame relies on the page it selected, so let it finish first.
+    while (i2c_job_is_busy(&pwm_jobs[index])) {
+        i2c_queue_task();
+    }
+#endif
     snled27351_write_register(index, SNLED27351_REG_COMMAND, page);
 }
 
 void snled27351_write_pwm_buffer(uint8_t index) {
     // Assumes PG1 is already selected.
-    // Transmit PWM registers in 12 transfers of 16 bytes.
+    // Transmit the dirty PWM registers in transfers of 16 bytes.
 
     // Iterate over the pwm_buffer contents at 16 byte intervals.
-    for (uint8_t i = 0; i < SNLED27351_PWM_REGISTER_COUNT; i += 16) {
+    for (uint8_t i = 0; i < SNLED27351_PWM_REGISTER_COUNT; i += SNLED27351_PWM_CHUNK_SIZE) {
+        if (!(driver_buffers[index].pwm_buffer_dirty & (1 << (i / SNLED27351_PWM_CHUNK_SIZE)))) {
+            continue;
+        }
 #if SNLED27351_I2C_PERSISTENCE > 0
         for (uint8_t j = 0; j < SNLED27351_I2C_PERSISTENCE; j++) {
-            if (i2c_write_register(i2c_addresses[index] << 1, i, driver_buffers[index].pwm_buffer + i, 16, SNLED27351_I2C_TIMEOUT) == I2C_STATUS_SUCCESS) break;
+            if (i2c_write_register(i2c_addresses[index] << 1, i, driver_buffers[index].pwm_buffer + i, SNLED27351_PWM_CHUNK_SIZE, SNLED27351_I2C_TIMEOUT) == I2C_STATUS_SUCCESS) break;
         }
 #else
-        i2c_write_register(i2c_addresses[index] << 1, i, driver_buffers[index].pwm_buffer + i, 16, SNLED27351_I2C_TIMEOUT);
+        i2c_write_register(i2c_addresses[index] << 1, i, driver_buffers[index].pwm_buffer + i, SNLED27351_PWM_CHUNK_SIZE, SNLED27351_I2C_TIMEOUT);
 #endif
     }
 }
 
+#ifdef I2C_QUEUE_ENABLE
+static void queue_pwm_buffer(uint8_t index) {
+    i2c_segment_t *segments = pwm_segments[index];
+    uint8_t        count    = 0;
+
+    segments[count++] = (i2c_segment_t)I2C_SEGMENT_WRITE(SNLED27351_REG_COMMAND, &pwm_page, 1);
+    for (uint8_t i = 0; i < SNLED27351_PWM_REGISTER_COUNT; i += SNLED27351_PWM_CHUNK_SIZE) {
+        if (driver_buffers[index].pwm_buffer_dirty & (1 << (i / SNLED27351_PWM_CHUNK_SIZE))) {
+            segments[count++] = (i2c_segment_t)I2C_SEGMENT_WRITE(i, driver_buffers[index].pwm_buffer + i, SNLED27351_PWM_CHUNK_SIZE);
+        }
+    }
+
+    pwm_jobs[index] = (i2c_job_t){
+        .address       = i2c_addresses[index] << 1,
+        .priority      = I2C_QUEUE_PRIORITY_LOW,
+        .retries       = SNLED27351_I2C_PERSISTENCE > 0 ? SNLED27351_I2C_PERSISTENCE - 1 : 0,
+        .segment_count = count,
+        .segments      = segments,
+        .timeout       = SNLED27351_I2C_TIMEOUT,
+        .callback      = pwm_job_done,
+    };
+    i2c_queue_submit(&pwm_jobs[index]);
+}
+#endif
+
 void snled27351_init_drivers(void) {
     i2c_init();
 
@@ -180,7 +236,7 @@ void snled27351_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
         driver_buffers[led.driver].pwm_buffer[led.r] = red;
         driver_buffers[led.driver].pwm_buffer[led.g] = green;
         driver_buffers[led.driver].pwm_buffer[led.b] = blue;
-        driver_buffers[led.driver].pwm_buffer_dirty  = true;
+        driver_buffers[led.driver].pwm_buffer_dirty |= (1 << (led.r / SNLED27351_PWM_CHUNK_SIZE)) | (1 << (led.g / SNLED27351_PWM_CHUNK_SIZE)) | (1 << (led.b / SNLED27351_PWM_CHUNK_SIZE));
     }
 }
 
@@ -221,12 +277,22 @@ void snled27351_set_led_control_register(uint8_t index, bool red, bool green, bo
 }
 
 void snled27351_update_pwm_buffers(uint8_t index) {
+#ifdef I2C_QUEUE_ENABLE
+    // The previous frame is still being sent; this one goes out once it is done.
+    if (i2c_job_is_busy(&pwm_jobs[index])) {
+        return;
+    }
+#endif
     if (driver_buffers[index].pwm_buffer_dirty) {
+#ifdef I2C_QUEUE_ENABLE
+        queue_pwm_buffer(index);
+#else
         snled27351_select_page(index, SNLED27351_COMMAND_PWM);
 
         snled27351_write_pwm_buffer(index);
+#endif
 
-        driver_buffers[index].pwm_buffer_dirty = false;
+        driver_buffers[index].pwm_buffer_dirty = 0;
     }
 }
 
@@ -6,6 +6,53 @@
 #    include "spi_master.h"
 #    include "qp_comms_spi.h"
 
+#    ifdef SPI_QUEUE_ENABLE
+#        include "spi_queue.h"
+#    endif // SPI_QUEUE_ENABLE
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// SPI queue support
+
+#    ifdef SPI_QUEUE_ENABLE
+
+// With the SPI queue, each write goes out as a job of its own, and the device is only selected while a job's transfer
+// is on the bus. Pixel data is preemptible, but each write still holds the main loop until it is done, so the only jobs
+// that can run between its chunks are those submitted from an interrupt or from another job's callback. Tasks driven by
+// the main loop, such as pointing device reads, keep waiting for the whole write.
+
+static spi_start_config_t qp_spi_device;
+static spi_segment_t      qp_spi_segment;
+static spi_job_t          qp_spi_job;
+static spi_status_t       qp_spi_status;
+
+static void qp_comms_spi_job_done(spi_job_t *job, spi_status_t status) {
+    qp_spi_status = status;
+}
+
+// The caller's buffers are reused as soon as a send returns, so the queue is run until the job is done.
+static bool qp_comms_spi_queue_write(const uint8_t *data, uint16_t length, bool preemptible) {
+    qp_spi_segment.length  = length;
+    qp_spi_segment.tx_data = data;
+    qp_spi_segment.rx_data = NULL;
+
+    qp_spi_job.device        = &qp_spi_device;
+    qp_spi_job.priority      = SPI_QUEUE_PRIORITY_LOW;
+    qp_spi_job.preemptible   = preemptible;
+    qp_spi_job.segment_count = 1;
+    qp_spi_job.segments      = &qp_spi_segment;
+    qp_spi_job.callback      = qp_comms_spi_job_done;
+    if (!spi_queue_submit(&qp_spi_job)) {
+        return false;
+    }
+
+    while (spi_job_is_busy(&qp_spi_job)) {
+        spi_queue_task();
+    }
+    return qp_spi_status == SPI_STATUS_SUCCESS;
+}
+
+#    endif // SPI_QUEUE_ENABLE
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Base SPI support
 
@@ -13,8 +60,10 @@ bool qp_comms_spi_init(painter_device_t device) {
     painter_driver_t      *driver       = (painter_driver_t *)device;
     qp_comms_spi_config_t *comms_config = (qp_comms_spi_config_t *)driver->comms_config;
 
-    // Initialize the SPI peripheral
+#    ifndef SPI_QUEUE_ENABLE
+    // Initialize the SPI peripheral; the queue does so itself
     spi_init();
+#    endif // SPI_QUEUE_ENABLE
 
     // Set up CS as output high
     gpio_set_pin_output(comms_config->chip_select_pin);
@@ -27,7 +76,16 @@ bool qp_comms_spi_start(painter_device_t device) {
     painter_driver_t      *driver       = (painter_driver_t *)device;
     qp_comms_spi_config_t *comms_config = (qp_comms_spi_config_t *)driver->comms_config;
 
+#    ifdef SPI_QUEUE_ENABLE
+    qp_spi_device.slave_pin     = comms_config->chip_select_pin;
+    qp_spi_device.lsb_first     = comms_config->lsb_first;
+    qp_spi_device.mode          = comms_config->mode;
+    qp_spi_device.divisor       = comms_config->divisor;
+    qp_spi_device.cs_active_low = true;
+    return true;
+#    else
     return spi_start(comms_config->chip_select_pin, comms_config->lsb_first, comms_config->mode, comms_config->divisor);
+#    endif // SPI_QUEUE_ENABLE
 }
 
 uint32_t qp_comms_spi_send_data(painter_device_t device, const void *data, uint32_t byte_count) {
@@ -37,7 +95,13 @@ uint32_t qp_comms_spi_send_data(painter_device_t device, const void *data, uint3
 
     while (bytes_remaining > 0) {
         uint32_t bytes_this_loop = MIN(bytes_remaining, max_msg_length);
+#    ifdef SPI_QUEUE_ENABLE
+        if (!qp_comms_spi_queue_write(p, bytes_this_loop, true)) {
+            break;
+        }
+#    else
         spi_transmit(p, bytes_this_loop);
+#    endif // SPI_QUEUE_ENABLE
         p += bytes_this_loop;
         bytes_remaining -= bytes_this_loop;
     }
@@ -48,7 +112,9 @@ uint32_t qp_comms_spi_send_data(painter_device_t device, const void *data, uint3
 bool qp_comms_spi_stop(painter_device_t device) {
     painter_driver_t      *driver       = (painter_driver_t *)device;
     qp_comms_spi_config_t *comms_config = (qp_comms_spi_config_t *)driver->comms_config;
+#    ifndef SPI_QUEUE_ENABLE
     spi_stop();
+#    endif // SPI_QUEUE_ENABLE
     gpio_write_pin_high(comms_config->chip_select_pin);
     return true;
 }
@@ -102,8 +168,12 @@ bool qp_comms_spi_dc_reset_send_command(painter_device_t device, uint8_t cmd) {
     painter_driver_t               *driver       = (painter_driver_t *)device;
     qp_comms_spi_dc_reset_config_t *comms_config = (qp_comms_spi_dc_reset_config_t *)driver->comms_config;
     gpio_write_pin_low(comms_config->dc_pin);
+#        ifdef SPI_QUEUE_ENABLE
+    return qp_comms_spi_queue_write(&cmd, 1, false);
+#        else
     spi_write(cmd);
     return true;
+#        endif // SPI_QUEUE_ENABLE
 }
 
 bool qp_comms_spi_dc_reset_bulk_command_sequence(painter_device_t device, const uint8_t *sequence, size_t sequence_len) {
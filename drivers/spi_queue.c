@@ -0,0 +1,118 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "spi_queue.h"
+#include <stddef.h>
+#include "util.h"
+
+static bus_queue_t queue;
+static bool        is_initialised = false;
+
+// Where the job whose transfer is on the bus resumes once that transfer succeeds.
+static uint8_t        resume_segment;
+static uint16_t       resume_offset;
+static spi_transfer_t transfer;
+static spi_segment_t  chunk;
+
+static volatile bool         transfer_done;
+static volatile spi_status_t transfer_status;
+
+void spi_queue_backend_complete(spi_status_t status) {
+    transfer_status = status;
+    transfer_done   = true;
+}
+
+bool spi_queue_submit(spi_job_t *job) {
+    if (job->link.queued || job->segment_count == 0 || job->device == NULL) {
+        return false;
+    }
+
+    if (!is_initialised) {
+        is_initialised = true;
+        spi_queue_backend_init();
+    }
+
+    return bus_queue_submit(&queue, &job->link, job->priority, job->device->slave_pin);
+}
+
+bool spi_queue_cancel(spi_job_t *job) {
+    return bus_queue_cancel(&queue, &job->link);
+}
+
+bool spi_job_is_busy(const spi_job_t *job) {
+    return job->link.queued;
+}
+
+bool spi_queue_is_idle(void) {
+    return bus_queue_is_idle(&queue);
+}
+
+static void start_transfer(spi_job_t *job) {
+    transfer.device = job->device;
+
+    if (job->preemptible) {
+        // The next chunk of the current segment, on its own.
+        const spi_segment_t *segment = &job->segments[job->link.segment];
+        uint16_t             length  = MIN(segment->length - job->link.offset, SPI_QUEUE_CHUNK_SIZE);
+
+        chunk.length  = length;
+        chunk.tx_data = segment->tx_data != NULL ? segment->tx_data + job->link.offset : NULL;
+        chunk.rx_data = segment->rx_data != NULL ? segment->rx_data + job->link.offset : NULL;
+
+        transfer.segments      = &chunk;
+        transfer.segment_count = 1;
+        resume_segment         = job->link.segment;
+        resume_offset          = job->link.offset + length;
+        if (resume_offset == segment->length) {
+            resume_segment++;
+            resume_offset = 0;
+        }
+    } else {
+        transfer.segments      = job->segments;
+        transfer.segment_count = job->segment_count;
+        resume_segment         = job->segment_count;
+        resume_offset          = 0;
+    }
+
+    queue.in_flight = &job->link;
+    transfer_done   = false;
+    spi_queue_backend_start(&transfer);
+}
+
+static void finish_job(spi_job_t *job, spi_status_t status) {
+    bus_queue_finish(&queue, &job->link);
+    if (job->callback != NULL) {
+        job->callback(job, status);
+    }
+}
+
+void spi_queue_task(void) {
+    if (queue.in_flight != NULL) {
+        if (!transfer_done) {
+            return;
+        }
+
+        spi_job_t *job  = BUS_QUEUE_JOB(queue.in_flight, spi_job_t, link);
+        queue.in_flight = NULL;
+        if (transfer_status == SPI_STATUS_SUCCESS) {
+            job->link.segment = resume_segment;
+            job->link.offset  = resume_offset;
+            if (job->link.segment == job->segment_count) {
+                finish_job(job, SPI_STATUS_SUCCESS);
+            }
+        } else {
+            finish_job(job, transfer_status);
+        }
+    }
+
+    bus_queue_job_t *next = bus_queue_next(&queue);
+    if (next != NULL) {
+        start_transfer(BUS_QUEUE_JOB(next, spi_job_t, link));
+    }
+}
+
+void spi_queue_flush(void) {
+    while (!spi_queue_is_idle()) {
+        spi_queue_task();
+    }
+}
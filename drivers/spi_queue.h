@@ -0,0 +1,122 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "spi_master.h"
+#include "bus_queue.h"
+
+/**
+ * \file
+ *
+ * \defgroup spi_queue SPI Transaction Queue
+ *
+ * \brief Non-blocking SPI jobs for devices sharing a bus, serviced from the main loop.
+ *
+ * A job is a list of writes and reads for one device, described once by its `spi_start_config_t`. Jobs are owned by
+ * the caller, queued by priority and executed one transfer at a time by `spi_queue_task()`, which also invokes the
+ * completion callback once the last segment has been transferred or a transfer has failed.
+ *
+ * A transfer selects the device, moves its segments back to back and releases the device again. A job normally goes
+ * out as a single transfer. A `preemptible` job is instead split into transfers of at most `SPI_QUEUE_CHUNK_SIZE`
+ * bytes from one segment each, and between two of them a job of higher priority may run, as long as it targets
+ * another device.
+ * \{
+ */
+
+#ifndef SPI_QUEUE_CHUNK_SIZE
+#    define SPI_QUEUE_CHUNK_SIZE 256
+#endif
+
+typedef enum {
+    SPI_QUEUE_PRIORITY_HIGH,
+    SPI_QUEUE_PRIORITY_NORMAL,
+    SPI_QUEUE_PRIORITY_LOW,
+    SPI_QUEUE_PRIORITY_COUNT = BUS_QUEUE_PRIORITY_COUNT,
+} spi_queue_priority_t;
+
+/**
+ * \brief One write or read of a job. Exactly one of `tx_data` and `rx_data` is set.
+ */
+typedef struct {
+    uint16_t       length;
+    const uint8_t *tx_data;
+    uint8_t       *rx_data;
+} spi_segment_t;
+
+#define SPI_SEGMENT_WRITE(data, length_) \
+    { .length = (length_), .tx_data = (data), .rx_data = NULL }
+#define SPI_SEGMENT_READ(data, length_) \
+    { .length = (length_), .tx_data = NULL, .rx_data = (data) }
+
+typedef struct spi_job_t spi_job_t;
+
+typedef void (*spi_job_callback_t)(spi_job_t *job, spi_status_t status);
+
+struct spi_job_t {
+    const spi_start_config_t *device;
+    uint8_t                   priority;
+    bool                      preemptible; // the device accepts being released between any two chunks of the job
+    uint8_t                   segment_count;
+    const spi_segment_t      *segments;
+    spi_job_callback_t        callback;
+    void                     *user_data;
+
+    // Managed by the queue.
+    bus_queue_job_t link;
+};
+
+/**
+ * \brief A single bus transaction handed to the backend: select `device`, move each segment in turn, then release it.
+ */
+typedef struct {
+    const spi_start_config_t *device;
+    const spi_segment_t      *segments;
+    uint8_t                   segment_count;
+} spi_transfer_t;
+
+/**
+ * \brief Queue a job. The job and everything it points to must stay valid until its callback has run.
+ *
+ * \return `false` if the job is already queued or has no segments.
+ */
+bool spi_queue_submit(spi_job_t *job);
+
+/**
+ * \brief Remove a queued job without running its callback. A job whose transfer is on the bus cannot be cancelled.
+ */
+bool spi_queue_cancel(spi_job_t *job);
+
+/**
+ * \brief Whether the job is queued or running.
+ */
+bool spi_job_is_busy(const spi_job_t *job);
+
+/**
+ * \brief Whether no job is queued and the bus is free.
+ */
+bool spi_queue_is_idle(void);
+
+/**
+ * \brief Reap the finished transfer, if any, and start the next one. Called from the main loop.
+ */
+void spi_queue_task(void);
+
+/**
+ * \brief Run the queue until it is idle. Blocks, and is meant for init and shutdown paths.
+ */
+void spi_queue_flush(void);
+
+/**
+ * \brief Backend interface, implemented per platform.
+ *
+ * `spi_queue_backend_start()` starts a transfer and returns; the backend then reports the result exactly once through
+ * `spi_queue_backend_complete()`, from any context, including from within `spi_queue_backend_start()` itself.
+ */
+void spi_queue_backend_init(void);
+void spi_queue_backend_start(const spi_transfer_t *transfer);
+void spi_queue_backend_complete(spi_status_t status);
+
+/** \} */
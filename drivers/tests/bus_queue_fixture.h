@@ -0,0 +1,40 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Helpers shared by the tests of the bus queues. Every queue reports its status as an int16_t.
+
+// The jobs of type `Job` whose callbacks have run, in order, with their status.
+template <typename Job>
+struct JobCompletions {
+    static std::vector<std::pair<Job *, int16_t>> list;
+
+    static void record(Job *job, int16_t status) {
+        list.emplace_back(job, status);
+    }
+};
+
+template <typename Job>
+std::vector<std::pair<Job *, int16_t>> JobCompletions<Job>::list;
+
+// A job that records its completion, with the fields every queue has in common filled in.
+template <typename Job, typename Segment>
+Job make_queue_job(uint8_t priority, const Segment *segments, uint8_t segment_count) {
+    Job job           = {};
+    job.priority      = priority;
+    job.segments      = segments;
+    job.segment_count = segment_count;
+    job.callback      = JobCompletions<Job>::record;
+    return job;
+}
+
+// The bytes a mock backend saw written in one transfer.
+template <typename Transfer>
+std::vector<uint8_t> sent_bytes(const Transfer *transfer) {
+    return std::vector<uint8_t>(transfer->tx_data, transfer->tx_data + transfer->tx_length);
+}
@@ -0,0 +1,121 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "bus_stats.h"
+#include "i2c_queue.h"
+#include "timer.h"
+#include "i2c_queue_backend_mock.h"
+
+void advance_time(uint32_t ms);
+}
+
+class BusStats : public testing::Test {
+   protected:
+    void SetUp() override {
+        timer_clear();
+        mock_i2c_reset();
+        bus_stats_reset();
+    }
+
+    bus_stats_t get(bus_stats_bus_t bus) {
+        bus_stats_t stats;
+        bus_stats_get(bus, &stats);
+        return stats;
+    }
+
+    // Runs `job` through the queue, keeping each transfer on the bus for `busy_ms`.
+    void run(i2c_job_t *job, uint32_t busy_ms, i2c_status_t status = I2C_STATUS_SUCCESS) {
+        ASSERT_TRUE(i2c_queue_submit(job));
+        i2c_queue_task();
+        while (mock_i2c_is_busy()) {
+            advance_time(busy_ms);
+            mock_i2c_complete(status, NULL);
+            i2c_queue_task();
+        }
+    }
+};
+
+TEST_F(BusStats, StartsEmpty) {
+    for (uint8_t bus = 0; bus < BUS_STATS_BUS_COUNT; bus++) {
+        bus_stats_t stats = get((bus_stats_bus_t)bus);
+        EXPECT_EQ(stats.transactions, 0);
+        EXPECT_EQ(stats.bytes, 0);
+        EXPECT_EQ(stats.busy_us, 0);
+    }
+}
+
+TEST_F(BusStats, CountsQueuedTransfers) {
+    const uint8_t       data[] = {1, 2, 3, 4, 5, 6, 7, 8};
+    uint8_t             rx[3];
+    const i2c_segment_t writes[] = {I2C_SEGMENT_WRITE(0x00, data, 8)};
+    const i2c_segment_t reads[]  = {I2C_SEGMENT_READ(0x10, rx, 3)};
+    i2c_job_t           write    = {};
+    write.address                = 0x50;
+    write.segments               = writes;
+    write.segment_count          = 1;
+    i2c_job_t read               = write;
+    read.segments                = reads;
+
+    run(&write, 2);
+    run(&read, 5);
+
+    bus_stats_t stats = get(BUS_STATS_I2C);
+    EXPECT_EQ(stats.transactions, 2);
+    // Each transfer also sends its register address
+    EXPECT_EQ(stats.bytes, (1 + 8) + (1 + 3));
+    EXPECT_EQ(stats.busy_us, 7000);
+    EXPECT_EQ(stats.max_latency_us, 5000);
+    EXPECT_EQ(stats.errors, 0);
+    EXPECT_EQ(stats.timeouts, 0);
+    EXPECT_EQ(get(BUS_STATS_SPI).transactions, 0);
+}
+
+TEST_F(BusStats, CountsFailures) {
+    const uint8_t       data[]     = {1};
+    const i2c_segment_t segments[] = {I2C_SEGMENT_WRITE(0x00, data, 1)};
+    i2c_job_t           job        = {};
+    job.segments                   = segments;
+    job.segment_count              = 1;
+    job.retries                    = 2;
+
+    run(&job, 1, I2C_STATUS_TIMEOUT);
+    job.retries = 0;
+    run(&job, 1, I2C_STATUS_ERROR);
+
+    bus_stats_t stats = get(BUS_STATS_I2C);
+    EXPECT_EQ(stats.transactions, 4);
+    EXPECT_EQ(stats.timeouts, 3);
+    EXPECT_EQ(stats.errors, 1);
+}
+
+TEST_F(BusStats, RepeatedStartStaysInOneTransaction) {
+    bus_stats_begin(BUS_STATS_SPI);
+    advance_time(1);
+    bus_stats_begin(BUS_STATS_SPI);
+    advance_time(1);
+    bus_stats_end(BUS_STATS_SPI, 4, BUS_STATS_SUCCESS);
+    // Ending a transaction that was never started is ignored
+    bus_stats_end(BUS_STATS_SPI, 4, BUS_STATS_SUCCESS);
+
+    bus_stats_t stats = get(BUS_STATS_SPI);
+    EXPECT_EQ(stats.transactions, 1);
+    EXPECT_EQ(stats.bytes, 4);
+    EXPECT_EQ(stats.busy_us, 2000);
+}
+
+TEST_F(BusStats, ResetClearsTotals) {
+    bus_stats_begin(BUS_STATS_SERIAL);
+    advance_time(3);
+    bus_stats_end(BUS_STATS_SERIAL, 10, BUS_STATS_ERROR);
+    advance_time(7);
+    EXPECT_EQ(bus_stats_elapsed_us(), 10000);
+
+    bus_stats_reset();
+
+    EXPECT_EQ(get(BUS_STATS_SERIAL).transactions, 0);
+    EXPECT_EQ(get(BUS_STATS_SERIAL).errors, 0);
+    EXPECT_EQ(bus_stats_elapsed_us(), 0);
+}
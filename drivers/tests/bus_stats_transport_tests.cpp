@@ -0,0 +1,87 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "bus_stats.h"
+#include "serial.h"
+#include "timer.h"
+#include "transactions.h"
+
+void advance_time(uint32_t ms);
+
+split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS];
+}
+
+// How the next serial transactions go: how long each takes and whether the other half answers.
+static uint32_t serial_ms;
+static bool     serial_success;
+
+extern "C" {
+bool soft_serial_transaction(int sstd_index) {
+    advance_time(serial_ms);
+    return serial_success;
+}
+
+void soft_serial_initiator_init(void) {}
+void soft_serial_target_init(void) {}
+
+bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    return true;
+}
+void transactions_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {}
+}
+
+class BusStatsTransport : public testing::Test {
+   protected:
+    void SetUp() override {
+        timer_clear();
+        bus_stats_reset();
+        serial_ms      = 1;
+        serial_success = true;
+
+        // The slave sends back a 5 byte checksum, the master sends a 4 byte timer
+        split_transaction_table[GET_SLAVE_MATRIX_CHECKSUM] = {0, 0, 5, 0, NULL};
+        split_transaction_table[PUT_SYNC_TIMER]            = {4, 0, 0, 0, NULL};
+    }
+
+    bus_stats_t serial() {
+        bus_stats_t stats;
+        bus_stats_get(BUS_STATS_SERIAL, &stats);
+        return stats;
+    }
+};
+
+TEST_F(BusStatsTransport, CountsEachSplitTransaction) {
+    uint8_t       checksum[5];
+    const uint8_t sync_timer[4] = {1, 0, 0, 0};
+
+    serial_ms = 2;
+    EXPECT_TRUE(transport_execute_transaction(GET_SLAVE_MATRIX_CHECKSUM, NULL, 0, checksum, sizeof(checksum)));
+    serial_ms = 3;
+    EXPECT_TRUE(transport_execute_transaction(PUT_SYNC_TIMER, sync_timer, sizeof(sync_timer), NULL, 0));
+
+    bus_stats_t stats = serial();
+    EXPECT_EQ(stats.transactions, 2);
+    EXPECT_EQ(stats.bytes, 5 + 4);
+    EXPECT_EQ(stats.busy_us, 5000);
+    EXPECT_EQ(stats.max_latency_us, 3000);
+    EXPECT_EQ(stats.errors, 0);
+}
+
+TEST_F(BusStatsTransport, CountsTransactionsTheOtherHalfMissedAsErrors) {
+    uint8_t checksum[5];
+
+    serial_success = false;
+    EXPECT_FALSE(transport_execute_transaction(GET_SLAVE_MATRIX_CHECKSUM, NULL, 0, checksum, sizeof(checksum)));
+
+    bus_stats_t stats = serial();
+    EXPECT_EQ(stats.transactions, 1);
+    EXPECT_EQ(stats.errors, 1);
+    EXPECT_EQ(stats.timeouts, 0);
+
+    bus_stats_t i2c;
+    bus_stats_get(BUS_STATS_I2C, &i2c);
+    EXPECT_EQ(i2c.transactions, 0);
+}
@@ -0,0 +1,54 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "i2c_queue_backend_mock.h"
+#include <string.h>
+#include "bus_stats.h"
+
+// Transfers stay on the "bus" until the test completes them, so every interleaving is deterministic. They are
+// recorded in the bus statistics like transfers made by i2c_master.
+
+static mock_i2c_transfer_t   transfers[MOCK_I2C_MAX_TRANSFERS];
+static uint8_t               transfer_count;
+static const i2c_transfer_t *active_transfer;
+
+void mock_i2c_reset(void) {
+    transfer_count  = 0;
+    active_transfer = NULL;
+}
+
+uint8_t mock_i2c_transfer_count(void) {
+    return transfer_count;
+}
+
+const mock_i2c_transfer_t *mock_i2c_transfer(uint8_t index) {
+    return index < transfer_count ? &transfers[index] : NULL;
+}
+
+bool mock_i2c_is_busy(void) {
+    return active_transfer != NULL;
+}
+
+void mock_i2c_complete(i2c_status_t status, const uint8_t *rx_data) {
+    const i2c_transfer_t *transfer = active_transfer;
+    active_transfer                = NULL;
+    BUS_STATS_END(I2C, transfer->tx_length + transfer->rx_length, status);
+    if (transfer->rx_length > 0 && rx_data != NULL && status == I2C_STATUS_SUCCESS) {
+        memcpy(transfer->rx_data, rx_data, transfer->rx_length);
+    }
+    i2c_queue_backend_complete(status);
+}
+
+void i2c_queue_backend_init(void) {}
+
+void i2c_queue_backend_start(const i2c_transfer_t *transfer) {
+    BUS_STATS_BEGIN(I2C);
+    active_transfer = transfer;
+    if (transfer_count < MOCK_I2C_MAX_TRANSFERS) {
+        mock_i2c_transfer_t *copy = &transfers[transfer_count++];
+        copy->address             = transfer->address;
+        copy->tx_length           = transfer->tx_length;
+        copy->rx_length           = transfer->rx_length;
+        memcpy(copy->tx_data, transfer->tx_data, transfer->tx_length);
+    }
+}
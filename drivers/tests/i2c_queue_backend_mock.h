@@ -0,0 +1,34 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "i2c_queue.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MOCK_I2C_MAX_TRANSFERS 32
+#define MOCK_I2C_MAX_LENGTH 256
+
+// Copy of a transfer started by the queue, taken when it was handed to the backend.
+typedef struct {
+    uint8_t  address;
+    uint8_t  tx_data[MOCK_I2C_MAX_LENGTH];
+    uint16_t tx_length;
+    uint16_t rx_length;
+} mock_i2c_transfer_t;
+
+void                       mock_i2c_reset(void);
+uint8_t                    mock_i2c_transfer_count(void);
+const mock_i2c_transfer_t *mock_i2c_transfer(uint8_t index);
+bool                       mock_i2c_is_busy(void);
+/**
+ * \brief Completes the transfer on the bus, filling its read buffer from `rx_data` if it has one.
+ */
+void mock_i2c_complete(i2c_status_t status, const uint8_t *rx_data);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,181 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+#include "gtest/gtest.h"
+#include "bus_queue_fixture.h"
+
+extern "C" {
+#include "i2c_queue.h"
+#include "i2c_queue_backend_mock.h"
+}
+
+static auto &completions = JobCompletions<i2c_job_t>::list;
+
+static i2c_job_t make_job(uint8_t address, uint8_t priority, const i2c_segment_t *segments, uint8_t segment_count) {
+    i2c_job_t job = make_queue_job<i2c_job_t>(priority, segments, segment_count);
+    job.address   = address;
+    job.timeout   = 100;
+    return job;
+}
+
+static std::vector<uint8_t> sent(uint8_t index) {
+    return sent_bytes(mock_i2c_transfer(index));
+}
+
+class I2CQueue : public testing::Test {
+   protected:
+    void SetUp() override {
+        mock_i2c_reset();
+        completions.clear();
+    }
+
+    void TearDown() override {
+        EXPECT_TRUE(i2c_queue_is_idle());
+    }
+
+    // Completes the transfer on the bus and lets the queue move on to the next one.
+    void complete(i2c_status_t status = I2C_STATUS_SUCCESS, const uint8_t *rx_data = NULL) {
+        ASSERT_TRUE(mock_i2c_is_busy());
+        mock_i2c_complete(status, rx_data);
+        i2c_queue_task();
+    }
+};
+
+TEST_F(I2CQueue, AdjacentRegisterWritesShareATransfer) {
+    const uint8_t       a[]        = {1, 2, 3, 4}, b[] = {5, 6, 7, 8}, c[] = {9, 10};
+    const i2c_segment_t segments[] = {I2C_SEGMENT_WRITE(0x10, a, 4), I2C_SEGMENT_WRITE(0x14, b, 4), I2C_SEGMENT_WRITE(0x20, c, 2)};
+    i2c_job_t           job        = make_job(0x50, I2C_QUEUE_PRIORITY_NORMAL, segments, 3);
+
+    ASSERT_TRUE(i2c_queue_submit(&job));
+    EXPECT_FALSE(i2c_queue_submit(&job));
+    i2c_queue_task();
+
+    EXPECT_EQ(mock_i2c_transfer(0)->address, 0x50);
+    EXPECT_EQ(sent(0), (std::vector<uint8_t>{0x10, 1, 2, 3, 4, 5, 6, 7, 8}));
+    complete();
+    EXPECT_EQ(sent(1), (std::vector<uint8_t>{0x20, 9, 10}));
+    EXPECT_TRUE(completions.empty());
+    EXPECT_TRUE(i2c_job_is_busy(&job));
+
+    complete();
+    EXPECT_EQ(mock_i2c_transfer_count(), 2);
+    ASSERT_EQ(completions.size(), 1u);
+    EXPECT_EQ(completions[0].first, &job);
+    EXPECT_EQ(completions[0].second, I2C_STATUS_SUCCESS);
+    EXPECT_FALSE(i2c_job_is_busy(&job));
+}
+
+TEST_F(I2CQueue, LongWritesAreSplitAtTheBufferSize) {
+    uint8_t data[150];
+    for (uint8_t i = 0; i < sizeof(data); i++) {
+        data[i] = i;
+    }
+    const i2c_segment_t segments[] = {I2C_SEGMENT_WRITE(0, data, sizeof(data))};
+    i2c_job_t           job        = make_job(0x50, I2C_QUEUE_PRIORITY_LOW, segments, 1);
+
+    i2c_queue_submit(&job);
+    i2c_queue_task();
+    complete();
+    complete();
+    complete();
+
+    const uint8_t payload = I2C_QUEUE_BUFFER_SIZE - 1;
+    ASSERT_EQ(mock_i2c_transfer_count(), 3);
+    EXPECT_EQ(sent(0)[0], 0);
+    EXPECT_EQ(sent(1)[0], payload);
+    EXPECT_EQ(sent(2)[0], 2 * payload);
+    EXPECT_EQ(sent(0).size() + sent(1).size() + sent(2).size(), sizeof(data) + 3);
+    EXPECT_EQ(sent(2).back(), sizeof(data) - 1);
+    EXPECT_EQ(completions.size(), 1u);
+}
+
+TEST_F(I2CQueue, HigherPriorityJobRunsBetweenTransfers) {
+    const uint8_t       frame[]        = {1, 2, 3};
+    const i2c_segment_t led_segments[] = {I2C_SEGMENT_WRITE(0x00, frame, 3), I2C_SEGMENT_WRITE(0x80, frame, 3)};
+    i2c_job_t           led            = make_job(0x60, I2C_QUEUE_PRIORITY_LOW, led_segments, 2);
+
+    uint8_t             motion[2];
+    const uint8_t       reply[]           = {0xAB, 0xCD};
+    const i2c_segment_t sensor_segments[] = {I2C_SEGMENT_READ(0x02, motion, 2)};
+    i2c_job_t           sensor            = make_job(0x2A, I2C_QUEUE_PRIORITY_HIGH, sensor_segments, 1);
+
+    i2c_queue_submit(&led);
+    i2c_queue_task();
+    i2c_queue_submit(&sensor);
+
+    complete();
+    EXPECT_EQ(mock_i2c_transfer(1)->address, 0x2A);
+    EXPECT_EQ(sent(1), (std::vector<uint8_t>{0x02}));
+    EXPECT_EQ(mock_i2c_transfer(1)->rx_length, 2);
+
+    complete(I2C_STATUS_SUCCESS, reply);
+    ASSERT_EQ(completions.size(), 1u);
+    EXPECT_EQ(completions[0].first, &sensor);
+    EXPECT_EQ(motion[0], 0xAB);
+    EXPECT_EQ(motion[1], 0xCD);
+    EXPECT_EQ(sent(2), (std::vector<uint8_t>{0x80, 1, 2, 3}));
+
+    complete();
+    ASSERT_EQ(completions.size(), 2u);
+    EXPECT_EQ(completions[1].first, &led);
+}
+
+TEST_F(I2CQueue, StartedJobKeepsItsDevice) {
+    const uint8_t       page[]          = {1}, data[] = {2, 3};
+    const i2c_segment_t page_segments[] = {I2C_SEGMENT_WRITE(0xFD, page, 1), I2C_SEGMENT_WRITE(0x00, data, 2)};
+    i2c_job_t           frame           = make_job(0x60, I2C_QUEUE_PRIORITY_LOW, page_segments, 2);
+    i2c_job_t           urgent          = make_job(0x60, I2C_QUEUE_PRIORITY_HIGH, page_segments, 1);
+
+    i2c_queue_submit(&frame);
+    i2c_queue_task();
+    i2c_queue_submit(&urgent);
+
+    complete();
+    EXPECT_EQ(sent(1), (std::vector<uint8_t>{0x00, 2, 3}));
+    complete();
+    EXPECT_EQ(sent(2), (std::vector<uint8_t>{0xFD, 1}));
+    complete();
+
+    ASSERT_EQ(completions.size(), 2u);
+    EXPECT_EQ(completions[0].first, &frame);
+    EXPECT_EQ(completions[1].first, &urgent);
+}
+
+TEST_F(I2CQueue, FailedTransferIsRetriedThenReported) {
+    const uint8_t       data[]     = {7};
+    const i2c_segment_t segments[] = {I2C_SEGMENT_WRITE(0x01, data, 1), I2C_SEGMENT_WRITE(0x05, data, 1)};
+    i2c_job_t           job        = make_job(0x50, I2C_QUEUE_PRIORITY_NORMAL, segments, 2);
+    job.retries                    = 1;
+
+    i2c_queue_submit(&job);
+    i2c_queue_task();
+    complete(I2C_STATUS_ERROR);
+    EXPECT_EQ(sent(1), sent(0));
+    EXPECT_TRUE(completions.empty());
+
+    complete(I2C_STATUS_TIMEOUT);
+    EXPECT_EQ(mock_i2c_transfer_count(), 2);
+    ASSERT_EQ(completions.size(), 1u);
+    EXPECT_EQ(completions[0].second, I2C_STATUS_TIMEOUT);
+    EXPECT_FALSE(mock_i2c_is_busy());
+}
+
+TEST_F(I2CQueue, CancelledJobNeverRuns) {
+    const uint8_t       data[]     = {7};
+    const i2c_segment_t segments[] = {I2C_SEGMENT_WRITE(0x01, data, 1)};
+    i2c_job_t           first      = make_job(0x50, I2C_QUEUE_PRIORITY_NORMAL, segments, 1);
+    i2c_job_t           second     = make_job(0x51, I2C_QUEUE_PRIORITY_NORMAL, segments, 1);
+
+    i2c_queue_submit(&first);
+    i2c_queue_submit(&second);
+    i2c_queue_task();
+    EXPECT_FALSE(i2c_queue_cancel(&first));
+    EXPECT_TRUE(i2c_queue_cancel(&second));
+    EXPECT_FALSE(i2c_job_is_busy(&second));
+
+    complete();
+    EXPECT_EQ(mock_i2c_transfer_count(), 1);
+    ASSERT_EQ(completions.size(), 1u);
+    EXPECT_EQ(completions[0].first, &first);
+}
@@ -0,0 +1,22 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdbool.h>
+#include "spi_queue_config_mock.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// The test platform has no GPIO, so the level written to each pin is kept by the test instead.
+void mock_gpio_write_pin(pin_t pin, bool level);
+
+#ifdef __cplusplus
+}
+#endif
+
+#define gpio_set_pin_output(pin)
+#define gpio_write_pin_high(pin) mock_gpio_write_pin(pin, true)
+#define gpio_write_pin_low(pin) mock_gpio_write_pin(pin, false)
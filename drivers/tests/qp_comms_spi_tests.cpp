@@ -0,0 +1,135 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+#include "gtest/gtest.h"
+#include "bus_queue_fixture.h"
+
+extern "C" {
+#include "qp_comms_spi.h"
+#include "spi_queue.h"
+#include "spi_queue_backend_mock.h"
+}
+
+static const pin_t CS_PIN = 1;
+static const pin_t DC_PIN = 3;
+
+static const spi_start_config_t sensor = {.slave_pin = 2, .lsb_first = false, .mode = 3, .divisor = 8, .cs_active_low = true};
+
+static bool pin_levels[256];
+// The level of the D/C pin as each transfer started.
+static bool dc_levels[MOCK_SPI_MAX_TRANSFERS];
+// A job to submit once the display's first pixel chunk is on the bus, as an interrupt might.
+static spi_job_t *submit_during_pixels;
+
+extern "C" void mock_gpio_write_pin(pin_t pin, bool level) {
+    pin_levels[pin] = level;
+}
+
+static void transfer_started(uint8_t index) {
+    dc_levels[index] = pin_levels[DC_PIN];
+    if (submit_during_pixels != NULL && index == 1) {
+        spi_queue_submit(submit_during_pixels);
+    }
+}
+
+static auto &completions = JobCompletions<spi_job_t>::list;
+
+static std::vector<uint8_t> sent(uint8_t index) {
+    return sent_bytes(mock_spi_transfer(index));
+}
+
+class QPCommsSPI : public testing::Test {
+   protected:
+    qp_comms_spi_dc_reset_config_t config = {};
+    painter_driver_t               driver = {};
+
+    void SetUp() override {
+        mock_spi_reset();
+        mock_spi_set_auto_complete(true);
+        mock_spi_set_start_hook(transfer_started);
+        completions.clear();
+        submit_during_pixels = NULL;
+
+        config.spi_config.chip_select_pin = CS_PIN;
+        config.spi_config.divisor         = 2;
+        config.dc_pin                     = DC_PIN;
+        config.reset_pin                  = NO_PIN;
+        driver.comms_vtable               = &spi_comms_with_dc_vtable.base;
+        driver.comms_config               = &config;
+    }
+
+    void TearDown() override {
+        EXPECT_TRUE(spi_queue_is_idle());
+    }
+
+    // Sends a memory write command followed by `pixels`, as the display drivers do for every pixdata call.
+    void draw(const std::vector<uint8_t> &pixels) {
+        ASSERT_TRUE(qp_comms_spi_start(&driver));
+        EXPECT_TRUE(qp_comms_spi_dc_reset_send_command(&driver, 0x2C));
+        EXPECT_EQ(qp_comms_spi_dc_reset_send_data(&driver, pixels.data(), pixels.size()), pixels.size());
+        EXPECT_TRUE(qp_comms_spi_stop(&driver));
+    }
+};
+
+TEST_F(QPCommsSPI, PixelsAreSentAsPreemptibleChunks) {
+    std::vector<uint8_t> pixels(SPI_QUEUE_CHUNK_SIZE * 2 + 88);
+    for (size_t i = 0; i < pixels.size(); i++) {
+        pixels[i] = i;
+    }
+    draw(pixels);
+
+    ASSERT_EQ(mock_spi_transfer_count(), 4);
+    EXPECT_EQ(sent(0), (std::vector<uint8_t>{0x2C}));
+    EXPECT_FALSE(dc_levels[0]);
+
+    std::vector<uint8_t> received;
+    for (uint8_t i = 1; i < 4; i++) {
+        EXPECT_EQ(mock_spi_transfer(i)->slave_pin, CS_PIN);
+        EXPECT_TRUE(dc_levels[i]);
+        EXPECT_LE(sent(i).size(), SPI_QUEUE_CHUNK_SIZE);
+        auto chunk = sent(i);
+        received.insert(received.end(), chunk.begin(), chunk.end());
+    }
+    EXPECT_EQ(received, pixels);
+}
+
+TEST_F(QPCommsSPI, SensorReadRunsBetweenPixelChunks) {
+    uint8_t             motion[2];
+    const spi_segment_t segments[] = {SPI_SEGMENT_READ(motion, 2)};
+    spi_job_t           read       = make_queue_job<spi_job_t>(SPI_QUEUE_PRIORITY_HIGH, segments, 1);
+    read.device                    = &sensor;
+    submit_during_pixels           = &read;
+
+    std::vector<uint8_t> pixels(SPI_QUEUE_CHUNK_SIZE * 3, 0x5A);
+    draw(pixels);
+
+    // Command, first chunk, the sensor read, then the rest of the frame.
+    ASSERT_EQ(mock_spi_transfer_count(), 5);
+    EXPECT_EQ(mock_spi_transfer(1)->slave_pin, CS_PIN);
+    EXPECT_EQ(mock_spi_transfer(2)->slave_pin, sensor.slave_pin);
+    EXPECT_EQ(mock_spi_transfer(2)->rx_length, 2);
+    EXPECT_EQ(mock_spi_transfer(3)->slave_pin, CS_PIN);
+    EXPECT_EQ(mock_spi_transfer(4)->slave_pin, CS_PIN);
+    EXPECT_EQ(sent(1).size() + sent(3).size() + sent(4).size(), pixels.size());
+
+    ASSERT_EQ(completions.size(), 1u);
+    EXPECT_EQ(completions[0].first, &read);
+    EXPECT_EQ(completions[0].second, SPI_STATUS_SUCCESS);
+}
+
+TEST_F(QPCommsSPI, ReleasesTheBusBetweenDrawCalls) {
+    // Nothing holds the bus between two pixdata calls, so a job queued outside of a draw runs before the next one.
+    uint8_t             motion[2];
+    const spi_segment_t segments[] = {SPI_SEGMENT_READ(motion, 2)};
+    spi_job_t           read       = make_queue_job<spi_job_t>(SPI_QUEUE_PRIORITY_LOW, segments, 1);
+    read.device                    = &sensor;
+
+    draw(std::vector<uint8_t>(16, 0));
+    ASSERT_TRUE(spi_queue_submit(&read));
+    draw(std::vector<uint8_t>(16, 0));
+
+    ASSERT_EQ(mock_spi_transfer_count(), 5);
+    EXPECT_EQ(mock_spi_transfer(2)->slave_pin, sensor.slave_pin);
+    ASSERT_EQ(completions.size(), 1u);
+}
@@ -0,0 +1,46 @@
+i2c_queue_DEFS := -DI2C_QUEUE_ENABLE
+i2c_queue_SRC := \
+	$(DRIVER_PATH)/bus_queue.c \
+	$(DRIVER_PATH)/i2c_queue.c \
+	$(DRIVER_PATH)/tests/i2c_queue_backend.c \
+	$(DRIVER_PATH)/tests/i2c_queue_tests.cpp
+
+spi_queue_DEFS := -DSPI_QUEUE_ENABLE
+spi_queue_CONFIG := $(DRIVER_PATH)/tests/spi_queue_config_mock.h
+spi_queue_SRC := \
+	$(DRIVER_PATH)/bus_queue.c \
+	$(DRIVER_PATH)/spi_queue.c \
+	$(DRIVER_PATH)/tests/spi_queue_backend.c \
+	$(DRIVER_PATH)/tests/spi_queue_tests.cpp
+
+qp_comms_spi_DEFS := -DSPI_QUEUE_ENABLE -DQUANTUM_PAINTER_ENABLE -DQUANTUM_PAINTER_SPI_ENABLE -DQUANTUM_PAINTER_SPI_DC_RESET_ENABLE
+qp_comms_spi_CONFIG := $(DRIVER_PATH)/tests/qp_comms_spi_config_mock.h
+qp_comms_spi_INC := $(QUANTUM_PATH)/painter $(QUANTUM_PATH)/deferred_exec $(DRIVER_PATH)/painter/comms
+qp_comms_spi_SRC := \
+	$(DRIVER_PATH)/bus_queue.c \
+	$(DRIVER_PATH)/spi_queue.c \
+	$(DRIVER_PATH)/painter/comms/qp_comms_spi.c \
+	$(PLATFORM_PATH)/timer.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c \
+	$(DRIVER_PATH)/tests/spi_queue_backend.c \
+	$(DRIVER_PATH)/tests/qp_comms_spi_tests.cpp
+
+bus_stats_DEFS := -DI2C_QUEUE_ENABLE -DBUS_STATS_ENABLE -DNO_PRINT
+bus_stats_SRC := \
+	$(DRIVER_PATH)/bus_stats.c \
+	$(DRIVER_PATH)/bus_queue.c \
+	$(DRIVER_PATH)/i2c_queue.c \
+	$(PLATFORM_PATH)/timer.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c \
+	$(DRIVER_PATH)/tests/i2c_queue_backend.c \
+	$(DRIVER_PATH)/tests/bus_stats_tests.cpp
+
+bus_stats_transport_DEFS := -DSPLIT_KEYBOARD -DBUS_STATS_ENABLE -DNO_PRINT
+bus_stats_transport_CONFIG := $(DRIVER_PATH)/tests/bus_stats_config_mock.h
+bus_stats_transport_INC := $(QUANTUM_PATH)/split_common
+bus_stats_transport_SRC := \
+	$(DRIVER_PATH)/bus_stats.c \
+	$(QUANTUM_PATH)/split_common/transport.c \
+	$(PLATFORM_PATH)/timer.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c \
+	$(DRIVER_PATH)/tests/bus_stats_transport_tests.cpp
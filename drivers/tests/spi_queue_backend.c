@@ -0,0 +1,80 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "spi_queue_backend_mock.h"
+#include <string.h>
+
+// Transfers stay on the "bus" until the test completes them, so every interleaving is deterministic.
+
+static mock_spi_transfer_t   transfers[MOCK_SPI_MAX_TRANSFERS];
+static uint8_t               transfer_count;
+static const spi_transfer_t *active_transfer;
+static bool                  auto_complete;
+static void (*start_hook)(uint8_t index);
+
+void mock_spi_reset(void) {
+    transfer_count  = 0;
+    active_transfer = NULL;
+    auto_complete   = false;
+    start_hook      = NULL;
+}
+
+uint8_t mock_spi_transfer_count(void) {
+    return transfer_count;
+}
+
+const mock_spi_transfer_t *mock_spi_transfer(uint8_t index) {
+    return index < transfer_count ? &transfers[index] : NULL;
+}
+
+bool mock_spi_is_busy(void) {
+    return active_transfer != NULL;
+}
+
+void mock_spi_complete(spi_status_t status, const uint8_t *rx_data) {
+    const spi_transfer_t *transfer = active_transfer;
+    active_transfer                = NULL;
+    for (uint8_t i = 0; i < transfer->segment_count; i++) {
+        const spi_segment_t *segment = &transfer->segments[i];
+        if (segment->rx_data != NULL && rx_data != NULL && status == SPI_STATUS_SUCCESS) {
+            memcpy(segment->rx_data, rx_data, segment->length);
+            rx_data += segment->length;
+        }
+    }
+    spi_queue_backend_complete(status);
+}
+
+void mock_spi_set_auto_complete(bool enable) {
+    auto_complete = enable;
+}
+
+void mock_spi_set_start_hook(void (*hook)(uint8_t index)) {
+    start_hook = hook;
+}
+
+void spi_queue_backend_init(void) {}
+
+void spi_queue_backend_start(const spi_transfer_t *transfer) {
+    active_transfer = transfer;
+    if (transfer_count < MOCK_SPI_MAX_TRANSFERS) {
+        mock_spi_transfer_t *copy = &transfers[transfer_count++];
+        copy->slave_pin           = transfer->device->slave_pin;
+        copy->tx_length           = 0;
+        copy->rx_length           = 0;
+        for (uint8_t i = 0; i < transfer->segment_count; i++) {
+            const spi_segment_t *segment = &transfer->segments[i];
+            if (segment->tx_data != NULL) {
+                memcpy(&copy->tx_data[copy->tx_length], segment->tx_data, segment->length);
+                copy->tx_length += segment->length;
+            } else {
+                copy->rx_length += segment->length;
+            }
+        }
+    }
+    if (start_hook != NULL) {
+        start_hook(transfer_count - 1);
+    }
+    if (auto_complete) {
+        mock_spi_complete(SPI_STATUS_SUCCESS, NULL);
+    }
+}
@@ -0,0 +1,42 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "spi_queue.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MOCK_SPI_MAX_TRANSFERS 32
+#define MOCK_SPI_MAX_LENGTH 512
+
+// Copy of a transfer started by the queue, taken when it was handed to the backend.
+typedef struct {
+    pin_t    slave_pin;
+    uint8_t  tx_data[MOCK_SPI_MAX_LENGTH]; // every write segment, back to back
+    uint16_t tx_length;
+    uint16_t rx_length;
+} mock_spi_transfer_t;
+
+void                       mock_spi_reset(void);
+uint8_t                    mock_spi_transfer_count(void);
+const mock_spi_transfer_t *mock_spi_transfer(uint8_t index);
+bool                       mock_spi_is_busy(void);
+/**
+ * \brief Completes the transfer on the bus, filling its read segments in turn from `rx_data` if it has any.
+ */
+void mock_spi_complete(spi_status_t status, const uint8_t *rx_data);
+/**
+ * \brief Completes every transfer successfully as soon as it starts, for code that waits on its own jobs.
+ */
+void mock_spi_set_auto_complete(bool enable);
+/**
+ * \brief Calls `hook` with the index of each transfer as it starts, before an automatic completion.
+ */
+void mock_spi_set_start_hook(void (*hook)(uint8_t index));
+
+#ifdef __cplusplus
+}
+#endif
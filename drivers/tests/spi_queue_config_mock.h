@@ -0,0 +1,9 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+
+// The test platform has no GPIO, so chip select pins are plain numbers.
+typedef uint8_t pin_t;
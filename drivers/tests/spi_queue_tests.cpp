@@ -0,0 +1,199 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+#include "gtest/gtest.h"
+#include "bus_queue_fixture.h"
+
+extern "C" {
+#include "spi_queue.h"
+#include "spi_queue_backend_mock.h"
+}
+
+static auto &completions = JobCompletions<spi_job_t>::list;
+
+static const spi_start_config_t display = {.slave_pin = 1, .lsb_first = false, .mode = 0, .divisor = 2, .cs_active_low = true};
+static const spi_start_config_t sensor  = {.slave_pin = 2, .lsb_first = false, .mode = 3, .divisor = 8, .cs_active_low = true};
+
+static spi_job_t make_job(const spi_start_config_t *device, uint8_t priority, const spi_segment_t *segments, uint8_t segment_count) {
+    spi_job_t job = make_queue_job<spi_job_t>(priority, segments, segment_count);
+    job.device    = device;
+    return job;
+}
+
+static std::vector<uint8_t> sent(uint8_t index) {
+    return sent_bytes(mock_spi_transfer(index));
+}
+
+class SPIQueue : public testing::Test {
+   protected:
+    void SetUp() override {
+        mock_spi_reset();
+        completions.clear();
+    }
+
+    void TearDown() override {
+        EXPECT_TRUE(spi_queue_is_idle());
+    }
+
+    // Completes the transfer on the bus and lets the queue move on to the next one.
+    void complete(spi_status_t status = SPI_STATUS_SUCCESS, const uint8_t *rx_data = NULL) {
+        ASSERT_TRUE(mock_spi_is_busy());
+        mock_spi_complete(status, rx_data);
+        spi_queue_task();
+    }
+};
+
+TEST_F(SPIQueue, JobIsOneTransfer) {
+    uint8_t             motion[3];
+    const uint8_t       burst[]    = {0x50}, reply[] = {1, 2, 3};
+    const spi_segment_t segments[] = {SPI_SEGMENT_WRITE(burst, 1), SPI_SEGMENT_READ(motion, 3)};
+    spi_job_t           job        = make_job(&sensor, SPI_QUEUE_PRIORITY_HIGH, segments, 2);
+
+    ASSERT_TRUE(spi_queue_submit(&job));
+    EXPECT_FALSE(spi_queue_submit(&job));
+    spi_queue_task();
+
+    EXPECT_EQ(mock_spi_transfer(0)->slave_pin, 2);
+    EXPECT_EQ(sent(0), (std::vector<uint8_t>{0x50}));
+    EXPECT_EQ(mock_spi_transfer(0)->rx_length, 3);
+    complete(SPI_STATUS_SUCCESS, reply);
+
+    EXPECT_EQ(mock_spi_transfer_count(), 1);
+    ASSERT_EQ(completions.size(), 1u);
+    EXPECT_EQ(completions[0].first, &job);
+    EXPECT_EQ(completions[0].second, SPI_STATUS_SUCCESS);
+    EXPECT_EQ(motion[2], 3);
+    EXPECT_FALSE(spi_job_is_busy(&job));
+}
+
+TEST_F(SPIQueue, PreemptibleJobIsSentInChunks) {
+    static uint8_t pixels[SPI_QUEUE_CHUNK_SIZE * 2 + 10];
+    for (size_t i = 0; i < sizeof(pixels); i++) {
+        pixels[i] = i;
+    }
+    const uint8_t       command[]  = {0x2C};
+    const spi_segment_t segments[] = {SPI_SEGMENT_WRITE(command, 1), SPI_SEGMENT_WRITE(pixels, sizeof(pixels))};
+    spi_job_t           job        = make_job(&display, SPI_QUEUE_PRIORITY_LOW, segments, 2);
+    job.preemptible                = true;
+
+    spi_queue_submit(&job);
+    spi_queue_task();
+    for (int i = 0; i < 4; i++) {
+        complete();
+    }
+
+    ASSERT_EQ(mock_spi_transfer_count(), 4);
+    EXPECT_EQ(sent(0), (std::vector<uint8_t>{0x2C}));
+    EXPECT_EQ(sent(1).size(), SPI_QUEUE_CHUNK_SIZE);
+    EXPECT_EQ(sent(2)[0], (uint8_t)SPI_QUEUE_CHUNK_SIZE);
+    EXPECT_EQ(sent(3).size(), 10u);
+    EXPECT_EQ(sent(3).back(), (uint8_t)(sizeof(pixels) - 1));
+    EXPECT_EQ(completions.size(), 1u);
+}
+
+TEST_F(SPIQueue, HigherPriorityJobRunsBetweenChunks) {
+    static uint8_t      pixels[SPI_QUEUE_CHUNK_SIZE * 2] = {};
+    const spi_segment_t frame_segments[]                 = {SPI_SEGMENT_WRITE(pixels, sizeof(pixels))};
+    spi_job_t           frame                            = make_job(&display, SPI_QUEUE_PRIORITY_LOW, frame_segments, 1);
+    frame.preemptible                                    = true;
+
+    uint8_t             motion[2];
+    const spi_segment_t sensor_segments[] = {SPI_SEGMENT_READ(motion, 2)};
+    spi_job_t           read              = make_job(&sensor, SPI_QUEUE_PRIORITY_HIGH, sensor_segments, 1);
+
+    spi_queue_submit(&frame);
+    spi_queue_task();
+    spi_queue_submit(&read);
+
+    complete();
+    EXPECT_EQ(mock_spi_transfer(1)->slave_pin, 2);
+    complete();
+    ASSERT_EQ(completions.size(), 1u);
+    EXPECT_EQ(completions[0].first, &read);
+    EXPECT_EQ(mock_spi_transfer(2)->slave_pin, 1);
+
+    complete();
+    ASSERT_EQ(completions.size(), 2u);
+    EXPECT_EQ(completions[1].first, &frame);
+}
+
+TEST_F(SPIQueue, JobThatIsNotPreemptibleRunsToCompletion) {
+    static uint8_t      data[SPI_QUEUE_CHUNK_SIZE * 2] = {};
+    const spi_segment_t flash_segments[]               = {SPI_SEGMENT_WRITE(data, sizeof(data))};
+    spi_job_t           flash                          = make_job(&display, SPI_QUEUE_PRIORITY_LOW, flash_segments, 1);
+    uint8_t             motion[2];
+    const spi_segment_t sensor_segments[] = {SPI_SEGMENT_READ(motion, 2)};
+    spi_job_t           read              = make_job(&sensor, SPI_QUEUE_PRIORITY_HIGH, sensor_segments, 1);
+
+    spi_queue_submit(&flash);
+    spi_queue_task();
+    spi_queue_submit(&read);
+
+    EXPECT_EQ(sent(0).size(), sizeof(data));
+    complete();
+    ASSERT_EQ(completions.size(), 1u);
+    EXPECT_EQ(completions[0].first, &flash);
+    complete();
+    EXPECT_EQ(mock_spi_transfer_count(), 2);
+}
+
+TEST_F(SPIQueue, StartedJobKeepsItsDevice) {
+    static uint8_t      pixels[SPI_QUEUE_CHUNK_SIZE + 1] = {};
+    const uint8_t       command[]                        = {0x29};
+    const spi_segment_t frame_segments[]                 = {SPI_SEGMENT_WRITE(pixels, sizeof(pixels))};
+    const spi_segment_t command_segments[]               = {SPI_SEGMENT_WRITE(command, 1)};
+    spi_job_t           frame                            = make_job(&display, SPI_QUEUE_PRIORITY_LOW, frame_segments, 1);
+    spi_job_t           urgent                           = make_job(&display, SPI_QUEUE_PRIORITY_HIGH, command_segments, 1);
+    frame.preemptible                                    = true;
+
+    spi_queue_submit(&frame);
+    spi_queue_task();
+    spi_queue_submit(&urgent);
+
+    complete();
+    EXPECT_EQ(sent(1).size(), 1u);
+    EXPECT_EQ(sent(1)[0], 0);
+    complete();
+    EXPECT_EQ(sent(2), (std::vector<uint8_t>{0x29}));
+    complete();
+
+    ASSERT_EQ(completions.size(), 2u);
+    EXPECT_EQ(completions[0].first, &frame);
+    EXPECT_EQ(completions[1].first, &urgent);
+}
+
+TEST_F(SPIQueue, FailedTransferEndsTheJob) {
+    static uint8_t      pixels[SPI_QUEUE_CHUNK_SIZE * 2] = {};
+    const spi_segment_t segments[]                       = {SPI_SEGMENT_WRITE(pixels, sizeof(pixels))};
+    spi_job_t           job                              = make_job(&display, SPI_QUEUE_PRIORITY_NORMAL, segments, 1);
+    job.preemptible                                      = true;
+
+    spi_queue_submit(&job);
+    spi_queue_task();
+    complete(SPI_STATUS_ERROR);
+
+    EXPECT_EQ(mock_spi_transfer_count(), 1);
+    ASSERT_EQ(completions.size(), 1u);
+    EXPECT_EQ(completions[0].second, SPI_STATUS_ERROR);
+    EXPECT_FALSE(mock_spi_is_busy());
+}
+
+TEST_F(SPIQueue, CancelledJobNeverRuns) {
+    const uint8_t       data[]     = {7};
+    const spi_segment_t segments[] = {SPI_SEGMENT_WRITE(data, 1)};
+    spi_job_t           first      = make_job(&display, SPI_QUEUE_PRIORITY_NORMAL, segments, 1);
+    spi_job_t           second     = make_job(&sensor, SPI_QUEUE_PRIORITY_NORMAL, segments, 1);
+
+    spi_queue_submit(&first);
+    spi_queue_submit(&second);
+    spi_queue_task();
+    EXPECT_FALSE(spi_queue_cancel(&first));
+    EXPECT_TRUE(spi_queue_cancel(&second));
+    EXPECT_FALSE(spi_job_is_busy(&second));
+
+    complete();
+    EXPECT_EQ(mock_spi_transfer_count(), 1);
+    ASSERT_EQ(completions.size(), 1u);
+    EXPECT_EQ(completions[0].first, &first);
+}
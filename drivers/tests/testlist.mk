@@ -0,0 +1,6 @@
+TEST_LIST += \
+	i2c_queue \
+	spi_queue \
+	qp_comms_spi \
+	bus_stats \
+	bus_stats_transport
@@ -0,0 +1,158 @@
+"""Generate leader_data.h, a prefix trie of leader sequences.
+
+This reads a leader sequence dictionary and writes "leader_data.h", which the
+leader key feature picks up from the keymap folder:
+
+$ qmk generate-leader-data leader_dict.txt
+
+Each line of the dictionary defines one sequence and the keycode it sends, with
+the syntax "KC_X KC_Y ... -> keycode". Keycodes may be any C expression using
+the core keycode names, e.g. "C(KC_C)" or "SAFE_RANGE+1"; sequence keycodes
+may not contain whitespace. Blank lines or lines starting with '#' are ignored.
+
+Example:
+  KC_F KC_D       -> C(KC_F)
+  KC_E KC_M KC_L  -> SAFE_RANGE+1
+"""
+import textwrap
+from typing import Any, Dict, Iterator, List, Tuple
+
+from milc import cli
+
+from qmk.commands import dump_lines
+from qmk.constants import GPL2_HEADER_C_LIKE, GENERATED_HEADER_C_LIKE
+from qmk.keyboard import keyboard_completer, keyboard_folder
+from qmk.keymap import keymap_completer, locate_keymap
+from qmk.path import normpath
+from qmk.util import maybe_exit
+
+HAS_ACTION = 0x8000
+MAX_CHILDREN = 0x7FFF
+
+
+def parse_file_lines(file_name: str) -> Iterator[Tuple[int, List[str], str]]:
+    """Parses lines read from `file_name` into (line number, sequence, action) tuples."""
+    line_number = 0
+    for line in open(file_name, 'rt'):
+        line_number += 1
+        line = line.strip()
+        if line and line[0] != '#':
+            tokens = [token.strip() for token in line.split('->', 1)]
+            if len(tokens) != 2 or not tokens[0] or not tokens[1]:
+                cli.log.error('{fg_red}Error:%d:{fg_reset} Invalid syntax: "{fg_cyan}%s{fg_reset}"', line_number, line)
+                maybe_exit(1)
+
+            yield line_number, tokens[0].split(), tokens[1]
+
+
+def parse_file(file_name: str) -> List[Tuple[List[str], str]]:
+    """Parses the leader sequence dictionary, rejecting duplicate sequences."""
+    sequences = []
+    seen = set()
+    for line_number, sequence, action in parse_file_lines(file_name):
+        if tuple(sequence) in seen:
+            cli.log.error('{fg_red}Error:%d:{fg_reset} Duplicate sequence: "{fg_cyan}%s{fg_reset}"', line_number, ' '.join(sequence))
+            maybe_exit(1)
+        seen.add(tuple(sequence))
+        sequences.append((sequence, action))
+
+    if not sequences:
+        cli.log.error('{fg_red}Error:{fg_reset} No leader sequences found in "{fg_cyan}%s{fg_reset}".', file_name)
+        maybe_exit(1)
+
+    return sequences
+
+
+def make_trie(sequences: List[Tuple[List[str], str]]) -> Dict[str, Any]:
+    """Makes a prefix trie of the sequences. Children keep dictionary order, actions live under 'LEAF'."""
+    trie = {}
+    for sequence, action in sequences:
+        node = trie
+        for keycode in sequence:
+            node = node.setdefault(keycode, {})
+        node['LEAF'] = action
+
+    return trie
+
+
+def serialize_trie(trie: Dict[str, Any]) -> List[str]:
+    """Serializes the trie into 16-bit words, as C expressions.
+
+    Each node is a header word holding the number of children, with bit 15 set
+    if a sequence ends at that node. The action keycode follows if so, then a
+    (keycode, word offset of child node) pair per child.
+    """
+    table = []
+
+    def traverse(node: Dict[str, Any]) -> Dict[str, Any]:
+        children = [key for key in node if key != 'LEAF']
+        if len(children) > MAX_CHILDREN:
+            cli.log.error('{fg_red}Error:{fg_reset} A leader sequence node has more than %d children.', MAX_CHILDREN)
+            maybe_exit(1)
+
+        entry = {'action': node.get('LEAF'), 'children': children, 'offset': 0}
+        table.append(entry)
+        entry['links'] = [traverse(node[key]) for key in children]
+        return entry
+
+    traverse(trie)
+
+    def size(entry: Dict[str, Any]) -> int:
+        return 1 + (entry['action'] is not None) + 2 * len(entry['children'])
+
+    offset = 0
+    for entry in table:
+        entry['offset'] = offset
+        offset += size(entry)
+    if offset > 0xFFFF:
+        cli.log.error('{fg_red}Error:{fg_reset} The leader sequence table is too large, a node link exceeds the 64K word limit.')
+        maybe_exit(1)
+
+    data = []
+    for entry in table:
+        header = len(entry['children'])
+        if entry['action'] is not None:
+            header |= HAS_ACTION
+        data.append(f'0x{header:04X}')
+        if entry['action'] is not None:
+            data.append(entry['action'])
+        for keycode, link in zip(entry['children'], entry['links']):
+            data += [keycode, str(link['offset'])]
+
+    return data
+
+
+@cli.argument('filename', type=normpath, help='The leader sequence dictionary file')
+@cli.argument('-kb', '--keyboard', type=keyboard_folder, completer=keyboard_completer, help='The keyboard to build a firmware for. Ignored when a output file is supplied.')
+@cli.argument('-km', '--keymap', completer=keymap_completer, help='The keymap to build a firmware for. Ignored when a output file is supplied.')
+@cli.argument('-o', '--output', arg_only=True, type=normpath, help='File to write to')
+@cli.argument('-q', '--quiet', arg_only=True, action='store_true', help="Quiet mode, only output error messages")
+@cli.subcommand('Generate the leader sequence data file from a dictionary file.')
+def generate_leader_data(cli):
+    sequences = parse_file(cli.args.filename)
+    data = serialize_trie(make_trie(sequences))
+
+    current_keyboard = cli.args.keyboard or cli.config.user.keyboard or cli.config.generate_leader_data.keyboard
+    current_keymap = cli.args.keymap or cli.config.user.keymap or cli.config.generate_leader_data.keymap
+
+    if not cli.args.output and current_keyboard and current_keymap:
+        cli.args.output = locate_keymap(current_keyboard, current_keymap).parent / 'leader_data.h'
+
+    max_length = max(len(sequence) for sequence, _ in sequences)
+    width = max(len(' '.join(sequence)) for sequence, _ in sequences)
+
+    leader_data_h_lines = [GPL2_HEADER_C_LIKE, GENERATED_HEADER_C_LIKE, '#pragma once', '']
+
+    leader_data_h_lines.append(f'// Leader sequences ({len(sequences)} entries):')
+    for sequence, action in sequences:
+        leader_data_h_lines.append(f'//   {" ".join(sequence):<{width}} -> {action}')
+
+    leader_data_h_lines.append('')
+    leader_data_h_lines.append(f'#define LEADER_DATA_MAX_LENGTH {max_length}')
+    leader_data_h_lines.append(f'#define LEADER_DATA_SIZE {len(data)}')
+    leader_data_h_lines.append('')
+    leader_data_h_lines.append('static const uint16_t leader_data[LEADER_DATA_SIZE] PROGMEM = {')
+    leader_data_h_lines.append(textwrap.fill('    %s' % (', '.join(data)), width=100, subsequent_indent='    ', break_long_words=False, break_on_hyphens=False))
+    leader_data_h_lines.append('};')
+
+    dump_lines(cli.args.output, leader_data_h_lines, cli.args.quiet)
@@ -319,6 +319,21 @@ def test_generate_version_h():
     assert '#define QMK_VERSION' in result.stdout
 
 
+def test_generate_leader_data():
+    result = check_subcommand('generate-leader-data', 'tests/leader/leader_data/leader_dict.txt')
+    check_returncode(result)
+    with open('tests/leader/leader_data/leader_data.h', encoding='utf-8') as expected:
+        assert result.stdout.split('#pragma once', 1)[1] == expected.read().split('#pragma once', 1)[1]
+
+
+def test_generate_leader_data_duplicate_sequence(tmp_path):
+    dictionary = tmp_path / 'leader_dict.txt'
+    dictionary.write_text('KC_A KC_B -> KC_1\nKC_A KC_B -> KC_2\n')
+    result = check_subcommand('generate-leader-data', str(dictionary))
+    check_returncode(result, [1])
+    assert 'Duplicate sequence' in result.stdout
+
+
 def test_format_json_keyboard():
     result = check_subcommand('format-json', '--format', 'keyboard', 'lib/python/qmk/tests/minimal_info.json')
     check_returncode(result)
@@ -21,6 +21,7 @@
 #include <util/twi.h>
 
 #include "i2c_master.h"
+#include "bus_stats.h"
 #include "timer.h"
 #include "wait.h"
 #include "util.h"
@@ -100,6 +101,7 @@ __attribute__((always_inline)) static inline i2c_status_t i2c_start(uint8_t addr
     uint16_t     timeout_timer = timer_read();
     uint16_t     time_slice    = MAX(1, (timeout == (I2C_TIMEOUT_INFINITE)) ? 5 : (timeout / (I2C_START_RETRY_COUNT))); // if it's infinite, wait 1ms between attempts, otherwise split up the entire timeout into the number of retries
     i2c_status_t status;
+    BUS_STATS_BEGIN(I2C);
     do {
         status = i2c_start_impl(address, time_slice);
     } while ((status < 0) && ((timeout == I2C_TIMEOUT_INFINITE) || (timer_elapsed(timeout_timer) <= timeout)));
@@ -169,6 +171,7 @@ i2c_status_t i2c_transmit(uint8_t address, const uint8_t* data, uint16_t length,
     }
 
     i2c_stop();
+    BUS_STATS_END(I2C, length, status);
 
     return status;
 }
@@ -181,6 +184,7 @@ i2c_status_t i2c_transmit_P(uint8_t address, const uint8_t* data, uint16_t lengt
     }
 
     i2c_stop();
+    BUS_STATS_END(I2C, length, status);
 
     return status;
 }
@@ -203,6 +207,7 @@ i2c_status_t i2c_receive(uint8_t address, uint8_t* data, uint16_t length, uint16
     }
 
     i2c_stop();
+    BUS_STATS_END(I2C, length, status);
 
     return (status < 0) ? status : I2C_STATUS_SUCCESS;
 }
@@ -229,6 +234,7 @@ i2c_status_t i2c_transmit_and_receive(uint8_t address, const uint8_t* tx_data, u
     }
 
     i2c_stop();
+    BUS_STATS_END(I2C, tx_length + rx_length, status);
 
     return status;
 }
@@ -244,6 +250,7 @@ i2c_status_t i2c_write_register(uint8_t devaddr, uint8_t regaddr, const uint8_t*
     }
 
     i2c_stop();
+    BUS_STATS_END(I2C, length + 1, status);
 
     return status;
 }
@@ -263,6 +270,7 @@ i2c_status_t i2c_write_register16(uint8_t devaddr, uint16_t regaddr, const uint8
     }
 
     i2c_stop();
+    BUS_STATS_END(I2C, length + 2, status);
 
     return status;
 }
@@ -296,6 +304,7 @@ i2c_status_t i2c_read_register(uint8_t devaddr, uint8_t regaddr, uint8_t* data,
 
 error:
     i2c_stop();
+    BUS_STATS_END(I2C, length + 1, status);
 
     return (status < 0) ? status : I2C_STATUS_SUCCESS;
 }
@@ -333,6 +342,7 @@ i2c_status_t i2c_read_register16(uint8_t devaddr, uint16_t regaddr, uint8_t* dat
 
 error:
     i2c_stop();
+    BUS_STATS_END(I2C, length + 2, status);
 
     return (status < 0) ? status : I2C_STATUS_SUCCESS;
 }
@@ -340,5 +350,6 @@ error:
 __attribute__((weak)) i2c_status_t i2c_ping_address(uint8_t address, uint16_t timeout) {
     i2c_status_t status = i2c_start(address, timeout);
     i2c_stop();
+    BUS_STATS_END(I2C, 0, status);
     return status;
 }
@@ -0,0 +1,21 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "i2c_queue.h"
+
+// The AVR TWI driver polls, so each transfer runs to completion when started. The queue still spreads a job over
+// several main loop iterations, one transfer per call of i2c_queue_task().
+
+void i2c_queue_backend_init(void) {
+    i2c_init();
+}
+
+void i2c_queue_backend_start(const i2c_transfer_t *transfer) {
+    i2c_status_t status;
+    if (transfer->rx_length > 0) {
+        status = i2c_transmit_and_receive(transfer->address, transfer->tx_data, transfer->tx_length, transfer->rx_data, transfer->rx_length, transfer->timeout);
+    } else {
+        status = i2c_transmit(transfer->address, transfer->tx_data, transfer->tx_length, transfer->timeout);
+    }
+    i2c_queue_backend_complete(status);
+}
@@ -16,6 +16,7 @@
 
 #include "spi_master.h"
 
+#include "bus_stats.h"
 #include "timer.h"
 
 #if defined(__AVR_AT90USB162__) || defined(__AVR_ATmega16U2__) || defined(__AVR_ATmega32U2__) || defined(__AVR_ATmega16U4__) || defined(__AVR_ATmega32U4__) || defined(__AVR_AT90USB646__) || defined(__AVR_AT90USB647__) || defined(__AVR_AT90USB1286__) || defined(__AVR_AT90USB1287__)
@@ -131,7 +132,7 @@ bool spi_start_extended(spi_start_config_t *start_config) {
     return true;
 }
 
-spi_status_t spi_write(uint8_t data) {
+static inline spi_status_t spi_exchange(uint8_t data) {
     SPDR = data;
 
     uint16_t timeout_timer = timer_read();
@@ -144,47 +145,47 @@ spi_status_t spi_write(uint8_t data) {
     return SPDR;
 }
 
-spi_status_t spi_read() {
-    SPDR = 0x00; // Dummy
+spi_status_t spi_write(uint8_t data) {
+    BUS_STATS_BEGIN(SPI);
+    spi_status_t status = spi_exchange(data);
+    BUS_STATS_END(SPI, 1, status);
 
-    uint16_t timeout_timer = timer_read();
-    while (!(SPSR & _BV(SPIF))) {
-        if ((timer_read() - timeout_timer) >= SPI_TIMEOUT) {
-            return SPI_STATUS_TIMEOUT;
-        }
-    }
+    return status;
+}
 
-    return SPDR;
+spi_status_t spi_read() {
+    BUS_STATS_BEGIN(SPI);
+    spi_status_t status = spi_exchange(0x00); // Dummy
+    BUS_STATS_END(SPI, 1, status);
+
+    return status;
 }
 
 spi_status_t spi_transmit(const uint8_t *data, uint16_t length) {
-    spi_status_t status;
-
-    for (uint16_t i = 0; i < length; i++) {
-        status = spi_write(data[i]);
+    spi_status_t status = SPI_STATUS_SUCCESS;
 
-        if (status < 0) {
-            return status;
-        }
+    BUS_STATS_BEGIN(SPI);
+    for (uint16_t i = 0; i < length && status >= 0; i++) {
+        status = spi_exchange(data[i]);
     }
+    BUS_STATS_END(SPI, length, status);
 
-    return SPI_STATUS_SUCCESS;
+    return status < 0 ? status : SPI_STATUS_SUCCESS;
 }
 
 spi_status_t spi_receive(uint8_t *data, uint16_t length) {
-    spi_status_t status;
-
-    for (uint16_t i = 0; i < length; i++) {
-        status = spi_read();
+    spi_status_t status = SPI_STATUS_SUCCESS;
 
+    BUS_STATS_BEGIN(SPI);
+    for (uint16_t i = 0; i < length && status >= 0; i++) {
+        status = spi_exchange(0x00); // Dummy
         if (status >= 0) {
             data[i] = status;
-        } else {
-            return status;
         }
     }
+    BUS_STATS_END(SPI, length, status);
 
-    return SPI_STATUS_SUCCESS;
+    return status < 0 ? status : SPI_STATUS_SUCCESS;
 }
 
 void spi_stop(void) {
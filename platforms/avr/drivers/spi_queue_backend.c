@@ -0,0 +1,28 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "spi_queue.h"
+
+// The AVR SPI driver polls, so each transfer runs to completion when started. The queue still spreads a preemptible
+// job over several main loop iterations, one chunk per call of spi_queue_task().
+
+void spi_queue_backend_init(void) {
+    spi_init();
+}
+
+void spi_queue_backend_start(const spi_transfer_t *transfer) {
+    spi_status_t status = SPI_STATUS_ERROR;
+    if (spi_start_extended((spi_start_config_t *)transfer->device)) {
+        status = SPI_STATUS_SUCCESS;
+        for (uint8_t i = 0; i < transfer->segment_count && status >= 0; i++) {
+            const spi_segment_t *segment = &transfer->segments[i];
+            if (segment->tx_data != NULL) {
+                status = spi_transmit(segment->tx_data, segment->length);
+            } else {
+                status = spi_receive(segment->rx_data, segment->length);
+            }
+        }
+        spi_stop();
+    }
+    spi_queue_backend_complete(status);
+}
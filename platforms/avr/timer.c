@@ -19,6 +19,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include <avr/interrupt.h>
 #include <util/atomic.h>
 #include <stdint.h>
+#include <stdbool.h>
 #include "timer_avr.h"
 #include "timer.h"
 
@@ -125,6 +126,33 @@ inline uint32_t timer_read32(void) {
     return t;
 }
 
+#if defined(__AVR_ATmega32A__)
+#    define TIMER_INTERRUPT_PENDING() (TIFR & _BV(OCF0))
+#elif defined(__AVR_ATtiny85__)
+#    define TIMER_INTERRUPT_PENDING() (TIFR & _BV(OCF0A))
+#else
+#    define TIMER_INTERRUPT_PENDING() (TIFR0 & _BV(OCF0A))
+#endif
+
+uint32_t timer_read_us32(void) {
+    uint32_t t;
+    uint8_t  raw;
+    bool     pending;
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        t       = timer_count;
+        raw     = TIMER_RAW;
+        pending = TIMER_INTERRUPT_PENDING();
+    }
+
+    // The counter wrapped around but the compare match interrupt has not been serviced yet
+    if (pending && raw < TIMER_RAW_TOP / 2) {
+        t++;
+    }
+
+    return t * 1000 + (uint32_t)raw * 1000 / (TIMER_RAW_TOP + 1);
+}
+
 // excecuted once per 1ms.(excess for just timer count?)
 #ifndef __AVR_ATmega32A__
 #    define TIMER_INTERRUPT_VECTOR TIMER0_COMPA_vect
@@ -15,6 +15,9 @@
  */
 
 #include "analog.h"
+#include "analog_scan_filter.h"
+#include "wait.h"
+#include <string.h>
 #include <ch.h>
 #include <hal.h>
 
@@ -396,7 +399,243 @@ static inline void manageAdcInitializationDriver(uint8_t adc, ADCDriver* adcDriv
     }
 }
 
+static inline int16_t adc_scale(adcsample_t sample) {
+#if defined(USE_ADCV2) || defined(RP2040)
+    // fake 12-bit -> N-bit scale
+    return sample >> (12 - ADC_RESOLUTION);
+#else
+    // already handled as part of adcConvert
+    return sample;
+#endif
+}
+
+#ifdef ANALOG_SCAN_PINS
+#    if defined(GD32VF103) || defined(WB32F3G71xx) || defined(WB32FQ95xx) || defined(AT32F415)
+#        error "ANALOG_SCAN_PINS is not supported on this MCU."
+#    endif
+
+// The scan runs without a trigger, so its pace is set by the conversion time alone. scan_end() runs every
+// ANALOG_SCAN_BUFFER_DEPTH / 2 sequences, i.e. every
+//   pins * (sampling time + conversion time) * ANALOG_SCAN_BUFFER_DEPTH / 2
+// ADC clock cycles. The defaults below use the longest sampling time, which on a 72MHz STM32F303 with 4 pins is
+// 4 * (601.5 + 12.5) * 16 cycles, so roughly 550us or under 2000 interrupts per second.
+#    ifndef ANALOG_SCAN_BUFFER_DEPTH
+#        define ANALOG_SCAN_BUFFER_DEPTH 32
+#    elif ANALOG_SCAN_BUFFER_DEPTH < 2 || ANALOG_SCAN_BUFFER_DEPTH % 2 != 0
+#        error "ANALOG_SCAN_BUFFER_DEPTH must be a positive even number."
+#    endif
+
+#    ifndef ANALOG_SCAN_FILTER_SHIFT
+#        define ANALOG_SCAN_FILTER_SHIFT 3
+#    endif
+
+#    if !defined(ANALOG_SCAN_SAMPLING_RATE) && !defined(RP2040)
+#        if defined(ADC_SMPR_SMP_601P5) // STM32F3XX
+#            define ANALOG_SCAN_SAMPLING_RATE ADC_SMPR_SMP_601P5
+#        elif defined(ADC_SMPR_SMP_640P5) // STM32L4XX, STM32L4XXP, STM32G4XX, STM32WBXX
+#            define ANALOG_SCAN_SAMPLING_RATE ADC_SMPR_SMP_640P5
+#        elif defined(ADC_SMPR_SMP_239P5) // STM32F0XX, and ADCv2 through the bodge above
+#            define ANALOG_SCAN_SAMPLING_RATE ADC_SMPR_SMP_239P5
+#        elif defined(ADC_SMPR_SMP_160P5) // STM32L0XX
+#            define ANALOG_SCAN_SAMPLING_RATE ADC_SMPR_SMP_160P5
+#        elif defined(ADC_SMPR_SMP1_160P5) // STM32G0XX
+#            define ANALOG_SCAN_SAMPLING_RATE ADC_SMPR_SMP1_160P5
+#        else
+#            define ANALOG_SCAN_SAMPLING_RATE ADC_SAMPLING_RATE
+#        endif
+#    endif
+
+// The scanned pins are converted back to back in one circular DMA transfer. Every time half of the buffer fills up,
+// its sequences are averaged into the latest value of each pin and folded into an exponential moving average, so
+// reading a scanned pin is a memory load instead of a conversion.
+static const pin_t scanPins[] = ANALOG_SCAN_PINS;
+
+#    define ANALOG_SCAN_PIN_COUNT (sizeof(scanPins) / sizeof(scanPins[0]))
+#    define ANALOG_SCAN_MAX_CHANNELS (ADC_DUMMY_CONVERSIONS_AT_START + ANALOG_SCAN_PIN_COUNT)
+#    define ANALOG_SCAN_NOT_SCANNED 0xFF
+
+_Static_assert(ANALOG_SCAN_MAX_CHANNELS <= 16, "The ADC sequence holds at most 16 conversions.");
+
+static ADCDriver*         scanDriver = NULL;
+static ADCConversionGroup scanConversionGroup;
+static adcsample_t        scanBuffer[ANALOG_SCAN_MAX_CHANNELS * ANALOG_SCAN_BUFFER_DEPTH];
+// Position of each pin's sample within a sequence.
+static uint8_t           scanSlot[ANALOG_SCAN_PIN_COUNT];
+static volatile int16_t  scanLatest[ANALOG_SCAN_PIN_COUNT];
+static volatile uint32_t scanFiltered[ANALOG_SCAN_PIN_COUNT]; // scaled by 1 << ANALOG_SCAN_FILTER_SHIFT
+static volatile bool     scanPrimed = false;
+
+static void scan_end(ADCDriver* adcp) {
+    const uint16_t     channels = scanConversionGroup.num_channels;
+    const adcsample_t* samples  = adcp->samples;
+    if (adcIsBufferComplete(adcp)) {
+        samples += channels * (ANALOG_SCAN_BUFFER_DEPTH / 2);
+    }
+
+    for (uint8_t i = 0; i < ANALOG_SCAN_PIN_COUNT; i++) {
+        if (scanSlot[i] == ANALOG_SCAN_NOT_SCANNED) {
+            continue;
+        }
+
+        int16_t value = adc_scale(analog_scan_average(samples, channels, scanSlot[i], ANALOG_SCAN_BUFFER_DEPTH / 2));
+
+        scanLatest[i] = value;
+        if (scanPrimed) {
+            scanFiltered[i] = analog_scan_filter(scanFiltered[i], value, ANALOG_SCAN_FILTER_SHIFT);
+        } else {
+            scanFiltered[i] = analog_scan_filter_start(value, ANALOG_SCAN_FILTER_SHIFT);
+        }
+    }
+    scanPrimed = true;
+}
+
+#    if !defined(USE_ADCV1) && !defined(RP2040)
+static void scan_sampling_rate_set(uint16_t input) {
+    // 3 bits per channel, channels 0..9 in the first register and 10..18 in the second
+    uint32_t mask  = 7UL << (3 * (input % 10));
+    uint32_t field = (uint32_t)ANALOG_SCAN_SAMPLING_RATE << (3 * (input % 10));
+#        if defined(USE_ADCV2)
+    if (input < 10) {
+        scanConversionGroup.smpr2 = (scanConversionGroup.smpr2 & ~mask) | field;
+    } else {
+        scanConversionGroup.smpr1 = (scanConversionGroup.smpr1 & ~mask) | field;
+    }
+#        else
+    scanConversionGroup.smpr[input / 10] = (scanConversionGroup.smpr[input / 10] & ~mask) | field;
+#        endif
+}
+
+static void scan_sequence_set(uint8_t rank, uint16_t input) {
+#        if defined(USE_ADCV2)
+    // SQ1..SQ6 in SQR3, SQ7..SQ12 in SQR2, SQ13..SQ16 in SQR1, 5 bits each
+    uint32_t field = (uint32_t)input << (5 * (rank % 6));
+    if (rank < 6) {
+        scanConversionGroup.sqr3 |= field;
+    } else if (rank < 12) {
+        scanConversionGroup.sqr2 |= field;
+    } else {
+        scanConversionGroup.sqr1 |= field;
+    }
+#        else
+    // SQ1..SQ4 in SQR1 after the length field, then five per register, 6 bits each
+    scanConversionGroup.sqr[(rank + 1) / 5] |= (uint32_t)input << (6 * ((rank + 1) % 5));
+#        endif
+}
+#    endif
+
+/**
+ * @brief Builds the conversion sequence for the scanned pins that share an ADC with the first one. The others are
+ * left to single conversions.
+ */
+static void scan_build_sequence(uint8_t adc) {
+    scanConversionGroup          = adcConversionGroup;
+    scanConversionGroup.circular = TRUE;
+    scanConversionGroup.end_cb   = scan_end;
+
+#    if defined(USE_ADCV1) || defined(RP2040)
+    // The channels of a mask are converted in ascending order.
+    uint32_t mask = 0;
+    for (uint8_t i = 0; i < ANALOG_SCAN_PIN_COUNT; i++) {
+        adc_mux mux = pinToMux(scanPins[i]);
+        if (mux.adc == adc) {
+            mask |= 1UL << mux.input;
+        }
+    }
+    for (uint8_t i = 0; i < ANALOG_SCAN_PIN_COUNT; i++) {
+        adc_mux mux = pinToMux(scanPins[i]);
+        scanSlot[i] = mux.adc == adc ? __builtin_popcount(mask & ((1UL << mux.input) - 1)) : ANALOG_SCAN_NOT_SCANNED;
+    }
+    scanConversionGroup.num_channels = __builtin_popcount(mask);
+#        if defined(USE_ADCV1)
+    scanConversionGroup.chselr = mask;
+    scanConversionGroup.smpr   = ANALOG_SCAN_SAMPLING_RATE;
+#        else
+    scanConversionGroup.channel_mask = mask;
+#        endif
+#    else
+#        if defined(USE_ADCV2)
+    scanConversionGroup.sqr1 = scanConversionGroup.sqr2 = scanConversionGroup.sqr3 = 0;
+#        else
+    memset(scanConversionGroup.sqr, 0, sizeof(scanConversionGroup.sqr));
+#        endif
+
+    uint8_t rank = 0;
+    for (uint8_t i = 0; i < ANALOG_SCAN_PIN_COUNT; i++) {
+        adc_mux mux = pinToMux(scanPins[i]);
+        if (mux.adc != adc) {
+            scanSlot[i] = ANALOG_SCAN_NOT_SCANNED;
+            continue;
+        }
+#        if ADC_DUMMY_CONVERSIONS_AT_START > 0
+        // Repeat the first channel as the dummy conversions the errata workaround needs.
+        while (rank < ADC_DUMMY_CONVERSIONS_AT_START) {
+            scan_sequence_set(rank++, mux.input);
+        }
+#        endif
+        scanSlot[i] = rank;
+        scan_sequence_set(rank++, mux.input);
+        scan_sampling_rate_set(mux.input);
+    }
+    scanConversionGroup.num_channels = rank;
+#        if defined(USE_ADCV2) && defined(ADC_SQR1_NUM_CH)
+    scanConversionGroup.sqr1 |= ADC_SQR1_NUM_CH(rank);
+#        endif
+#    endif
+}
+
+void analog_scan_init(void) {
+    if (scanDriver) {
+        return;
+    }
+
+    uint8_t    adc    = pinToMux(scanPins[0]).adc;
+    ADCDriver* driver = intToADCDriver(adc);
+    if (!driver) {
+        return;
+    }
+
+    for (uint8_t i = 0; i < ANALOG_SCAN_PIN_COUNT; i++) {
+        palSetLineMode(scanPins[i], PAL_MODE_INPUT_ANALOG);
+    }
+    scan_build_sequence(adc);
+
+    manageAdcInitializationDriver(adc, driver);
+    scanDriver = driver;
+    adcStartConversion(scanDriver, &scanConversionGroup, scanBuffer, ANALOG_SCAN_BUFFER_DEPTH);
+
+    // The first half of the buffer takes up to a few milliseconds; don't hand out zeroes before it lands.
+    for (uint16_t i = 0; i < 1000 && !scanPrimed; i++) {
+        wait_us(10);
+    }
+}
+
+static int8_t scan_index(pin_t pin) {
+    analog_scan_init();
+    for (uint8_t i = 0; i < ANALOG_SCAN_PIN_COUNT; i++) {
+        if (scanPins[i] == pin && scanSlot[i] != ANALOG_SCAN_NOT_SCANNED && scanDriver) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+int16_t analogReadPinFiltered(pin_t pin) {
+    int8_t index = scan_index(pin);
+    if (index < 0) {
+        return analogReadPin(pin);
+    }
+    return analog_scan_filter_value(scanFiltered[index], ANALOG_SCAN_FILTER_SHIFT);
+}
+#endif
+
 int16_t analogReadPin(pin_t pin) {
+#ifdef ANALOG_SCAN_PINS
+    int8_t index = scan_index(pin);
+    if (index >= 0) {
+        return scanLatest[index];
+    }
+#endif
+
     palSetLineMode(pin, PAL_MODE_INPUT_ANALOG);
 
     return adc_read(pinToMux(pin));
@@ -436,15 +675,26 @@ int16_t adc_read(adc_mux mux) {
     }
 
     manageAdcInitializationDriver(mux.adc, targetDriver);
-    if (adcConvert(targetDriver, &adcConversionGroup, &sampleBuffer[0], ADC_BUFFER_DEPTH) != MSG_OK) {
-        return 0;
+
+#ifdef ANALOG_SCAN_PINS
+    // A single conversion on the scanning ADC has to pause the scan.
+    bool pause_scan = targetDriver == scanDriver;
+    if (pause_scan) {
+        adcStopConversion(targetDriver);
     }
+#endif
 
-#if defined(USE_ADCV2) || defined(RP2040)
-    // fake 12-bit -> N-bit scale
-    return (sampleBuffer[ADC_DUMMY_CONVERSIONS_AT_START]) >> (12 - ADC_RESOLUTION);
-#else
-    // already handled as part of adcConvert
-    return sampleBuffer[ADC_DUMMY_CONVERSIONS_AT_START];
+    msg_t status = adcConvert(targetDriver, &adcConversionGroup, &sampleBuffer[0], ADC_BUFFER_DEPTH);
+
+#ifdef ANALOG_SCAN_PINS
+    if (pause_scan) {
+        adcStartConversion(scanDriver, &scanConversionGroup, scanBuffer, ANALOG_SCAN_BUFFER_DEPTH);
+    }
 #endif
+
+    if (status != MSG_OK) {
+        return 0;
+    }
+
+    return adc_scale(sampleBuffer[ADC_DUMMY_CONVERSIONS_AT_START]);
 }
@@ -38,6 +38,18 @@ adc_mux pinToMux(pin_t pin);
 
 int16_t adc_read(adc_mux mux);
 
+#ifdef ANALOG_SCAN_PINS
+/**
+ * @brief Starts sampling `ANALOG_SCAN_PINS` continuously. Called on the first read of any pin otherwise.
+ */
+void analog_scan_init(void);
+
+/**
+ * @brief Reads the moving average of a scanned pin, or a single conversion for any other pin.
+ */
+int16_t analogReadPinFiltered(pin_t pin);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,41 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * @brief Averages one channel over `count` back to back sequences of `channels` samples each.
+ *
+ * @param slot the position of the channel within a sequence
+ */
+static inline uint16_t analog_scan_average(const uint16_t *samples, uint16_t channels, uint8_t slot, uint16_t count) {
+    uint32_t sum = 0;
+    for (uint16_t i = 0; i < count; i++) {
+        sum += samples[i * channels + slot];
+    }
+    return sum / count;
+}
+
+/**
+ * @brief Starts an exponential moving average at `value`. The average is kept scaled by 2^`shift`, so the fractions
+ * that a right shift would drop on every step are carried instead.
+ */
+static inline uint32_t analog_scan_filter_start(uint16_t value, uint8_t shift) {
+    return (uint32_t)value << shift;
+}
+
+/**
+ * @brief Folds `value` into the scaled average, with a weight of 1/2^`shift`.
+ */
+static inline uint32_t analog_scan_filter(uint32_t average, uint16_t value, uint8_t shift) {
+    return average - (average >> shift) + value;
+}
+
+/**
+ * @brief Reads the value of a scaled average.
+ */
+static inline uint16_t analog_scan_filter_value(uint32_t average, uint8_t shift) {
+    return average >> shift;
+}
@@ -145,6 +145,9 @@
 #endif
 
 /**
- *user overridable sample generation/processing
+ * user provided sample generation/processing, for the dac_additive driver
+ *
+ * Declared weak: when a keyboard implements it, it is called once per sample
+ * instead of rendering the active tones through the wavetable mixer.
  */
-uint16_t dac_value_generate(void);
+uint16_t dac_value_generate(void) __attribute__((weak));
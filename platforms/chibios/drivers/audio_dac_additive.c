@@ -16,8 +16,8 @@
  */
 
 #include "audio.h"
+#include "audio_mixer.h"
 #include "gpio.h"
-#include <math.h>
 #include "util.h"
 
 // Need to disable GCC's "tautological-compare" warning for this file, as it causes issues when running `KEEP_INTERMEDIATES=yes`. Corresponding pop at the end of the file.
@@ -29,9 +29,10 @@
 
   which utilizes the dac unit many STM32 are equipped with, to output a modulated waveform from samples stored in the dac_buffer_* array who are passed to the hardware through DMA
 
-  it is also possible to have a custom sample-LUT by implementing/overriding 'dac_value_generate'
+  it is also possible to have a custom sample-LUT by implementing 'dac_value_generate'
 
-  this driver allows for multiple simultaneous tones to be played through one single channel by doing additive wave-synthesis
+  this driver allows for multiple simultaneous tones to be played through one single channel by doing additive wave-synthesis,
+  which is left to the fixed-point wavetable mixer in quantum/audio/audio_mixer.c
 */
 
 #if !defined(AUDIO_PIN)
@@ -66,12 +67,6 @@ static const dacsample_t dac_buffer_triangle[] = {
     0xfff, 0xfdf, 0xfbf, 0xf9f, 0xf7f, 0xf5f, 0xf3f, 0xf1f, 0xeff, 0xedf, 0xebf, 0xe9f, 0xe7f, 0xe5f, 0xe3f, 0xe1f, 0xdff, 0xddf, 0xdbf, 0xd9f, 0xd7f, 0xd5f, 0xd3f, 0xd1f, 0xcff, 0xcdf, 0xcbf, 0xc9f, 0xc7f, 0xc5f, 0xc3f, 0xc1f, 0xbff, 0xbdf, 0xbbf, 0xb9f, 0xb7f, 0xb5f, 0xb3f, 0xb1f, 0xaff, 0xadf, 0xabf, 0xa9f, 0xa7f, 0xa5f, 0xa3f, 0xa1f, 0x9ff, 0x9df, 0x9bf, 0x99f, 0x97f, 0x95f, 0x93f, 0x91f, 0x8ff, 0x8df, 0x8bf, 0x89f, 0x87f, 0x85f, 0x83f, 0x81f, 0x800, 0x7e0, 0x7c0, 0x7a0, 0x780, 0x760, 0x740, 0x720, 0x700, 0x6e0, 0x6c0, 0x6a0, 0x680, 0x660, 0x640, 0x620, 0x600, 0x5e0, 0x5c0, 0x5a0, 0x580, 0x560, 0x540, 0x520, 0x500, 0x4e0, 0x4c0, 0x4a0, 0x480, 0x460, 0x440, 0x420, 0x400, 0x3e0, 0x3c0, 0x3a0, 0x380, 0x360, 0x340, 0x320, 0x300, 0x2e0, 0x2c0, 0x2a0, 0x280, 0x260, 0x240, 0x220, 0x200, 0x1e0, 0x1c0, 0x1a0, 0x180, 0x160, 0x140, 0x120, 0x100, 0xe0,  0xc0,  0xa0,  0x80,  0x60,  0x40,  0x20,
 };
 #endif // AUDIO_DAC_SAMPLE_WAVEFORM_TRIANGLE
-#ifdef AUDIO_DAC_SAMPLE_WAVEFORM_SQUARE
-static const dacsample_t dac_buffer_square[] = {
-    AUDIO_DAC_OFF_VALUE,  // first and
-    AUDIO_DAC_SAMPLE_MAX, // second steps
-};
-#endif // AUDIO_DAC_SAMPLE_WAVEFORM_SQUARE
 /*
 // four steps: 0, 1/3, 2/3 and 1
 static const dacsample_t dac_buffer_staircase[] = {
@@ -88,23 +83,28 @@ static const dacsample_t dac_buffer_trapezoid[] = {
 };
 #endif // AUDIO_DAC_SAMPLE_WAVEFORM_TRAPEZOID
 
-static dacsample_t dac_buffer[AUDIO_DAC_BUFFER_SIZE];
+#if defined(AUDIO_DAC_SAMPLE_WAVEFORM_SINE)
+#    define DAC_WAVEFORM dac_buffer_sine
+#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_TRIANGLE)
+#    define DAC_WAVEFORM dac_buffer_triangle
+#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_TRAPEZOID)
+#    define DAC_WAVEFORM dac_buffer_trapezoid
+#endif
 
-/* keep track of the sample position for for each frequency */
-static float dac_if[AUDIO_MAX_SIMULTANEOUS_TONES] = {0.0};
+#if AUDIO_MAX_SIMULTANEOUS_TONES > AUDIO_MIXER_VOICES
+#    error "AUDIO_DAC: AUDIO_MAX_SIMULTANEOUS_TONES is larger than AUDIO_MIXER_VOICES, raise the latter to match"
+#endif
 
-static float   active_tones_snapshot[AUDIO_MAX_SIMULTANEOUS_TONES] = {0};
-static uint8_t active_tones_snapshot_length                        = 0;
+static dacsample_t dac_buffer[AUDIO_DAC_BUFFER_SIZE];
+
+/* the selected waveform, converted once to the signed samples the mixer works with */
+static int16_t wavetable[AUDIO_MIXER_WAVETABLE_LENGTH];
 
 typedef enum {
     OUTPUT_SHOULD_START,
     OUTPUT_RUN_NORMALLY,
-    // path 1: wait for zero, then change/update active tones
-    OUTPUT_TONES_CHANGED,
-    OUTPUT_REACHED_ZERO_BEFORE_TONE_CHANGE,
-    // path 2: hardware should stop, wait for zero then turn output off = stop the timer
+    // hardware should stop, let the voices fade out then turn output off = stop the timer
     OUTPUT_SHOULD_STOP,
-    OUTPUT_REACHED_ZERO_BEFORE_OFF,
     OUTPUT_OFF,
     OUTPUT_OFF_1,
     OUTPUT_OFF_2, // trailing off: giving the DAC two more conversion cycles until the AUDIO_DAC_OFF_VALUE reaches the output, then turn the timer off, which leaves the output at that level
@@ -112,75 +112,50 @@ typedef enum {
 } output_states_t;
 output_states_t state = OUTPUT_OFF_2;
 
-/**
- * Generation of the waveform being passed to the callback. Declared weak so users
- * can override it with their own wave-forms/noises.
- */
-__attribute__((weak)) uint16_t dac_value_generate(void) {
-    // DAC is running/asking for values but snapshot length is zero -> must be playing a pause
-    if (active_tones_snapshot_length == 0) {
-        return AUDIO_DAC_OFF_VALUE;
-    }
-
-    /* doing additive wave synthesis over all currently playing tones = adding up
-     * sine-wave-samples for each frequency, scaled by the number of active tones
-     */
-    uint_fast16_t value     = 0;
-    float         frequency = 0.0f;
-
-#if defined(AUDIO_DAC_SAMPLE_WAVEFORM_SINE)
-    const size_t wavetable_length = ARRAY_SIZE(dac_buffer_sine);
-#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_TRIANGLE)
-    const size_t wavetable_length = ARRAY_SIZE(dac_buffer_triangle);
-#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_TRAPEZOID)
-    const size_t wavetable_length = ARRAY_SIZE(dac_buffer_trapezoid);
-#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_SQUARE)
-    const size_t wavetable_length = ARRAY_SIZE(dac_buffer_square);
+static void wavetable_init(void) {
+    for (size_t i = 0; i < AUDIO_MIXER_WAVETABLE_LENGTH; i++) {
+#if defined(AUDIO_DAC_SAMPLE_WAVEFORM_SQUARE)
+        wavetable[i] = i < AUDIO_MIXER_WAVETABLE_LENGTH / 2 ? -INT16_MAX : INT16_MAX;
+#else
+        // the tables span 0..0xfff, centered around 0x800
+        dacsample_t sample = DAC_WAVEFORM[i * ARRAY_SIZE(DAC_WAVEFORM) / AUDIO_MIXER_WAVETABLE_LENGTH];
+        wavetable[i]       = ((int32_t)sample * 2 - 0xfff) * 8;
 #endif
+    }
+}
 
-    for (size_t i = 0; i < active_tones_snapshot_length; i++) {
-        /* Note: a user implementation does not have to rely on the active_tones_snapshot, but
-         * could directly query the active frequencies through audio_get_processed_frequency */
-        frequency = active_tones_snapshot[i];
-
-        float new_dac_if = dac_if[i];
-        new_dac_if += frequency * ((float)wavetable_length / AUDIO_DAC_SAMPLE_RATE * 2.0f / 3.0f);
-        /*Note: the 2/3 are necessary to get the correct frequencies on the
-         *      DAC output (as measured with an oscilloscope), since the gpt
-         *      timer runs with 3*AUDIO_DAC_SAMPLE_RATE; and the DAC callback
-         *      is called twice per conversion.*/
-
-        while (new_dac_if >= wavetable_length)
-            new_dac_if -= wavetable_length;
-        dac_if[i] = new_dac_if;
+/**
+ * Hands the currently active tones to the mixer, one voice per tone. Rests and
+ * tones that ended fade out on their voice, new tones fade in, and tones that
+ * moved to another frequency are retuned without restarting their waveform.
+ */
+static void update_voices(void) {
+    uint8_t active_tones = MIN(AUDIO_MAX_SIMULTANEOUS_TONES, audio_get_number_of_active_tones());
 
-        // Wavetable generation/lookup
-        size_t dac_i = (size_t)new_dac_if;
+    for (uint8_t i = 0; i < AUDIO_MIXER_VOICES; i++) {
+        float frequency = i < active_tones ? audio_get_processed_frequency(i) : 0.0f;
+        if (frequency > 0) {
+            audio_mixer_voice_play(i, frequency);
+        } else {
+            audio_mixer_voice_release(i);
+        }
+    }
+}
 
-#if defined(AUDIO_DAC_SAMPLE_WAVEFORM_SINE)
-        value += dac_buffer_sine[dac_i] / active_tones_snapshot_length;
-#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_TRIANGLE)
-        value += dac_buffer_triangle[dac_i] / active_tones_snapshot_length;
-#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_TRAPEZOID)
-        value += dac_buffer_trapezoid[dac_i] / active_tones_snapshot_length;
-#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_SQUARE)
-        value += dac_buffer_square[dac_i] / active_tones_snapshot_length;
-#endif
-        /*
-        // SINE
-        value += dac_buffer_sine[dac_i] / active_tones_snapshot_length / 3;
-        // TRIANGLE
-        value += dac_buffer_triangle[dac_i] / active_tones_snapshot_length / 3;
-        // SQUARE
-        value += dac_buffer_square[dac_i] / active_tones_snapshot_length / 3;
-        //NOTE: combination of these three wave-forms is more exemplary - and doesn't sound particularly good :-P
-        */
-
-        // STAIRS (mostly usefully as test-pattern)
-        // value_avg = dac_buffer_staircase[dac_i] / active_tones_snapshot_length;
+/**
+ * Fills the buffer with the next samples. The mixer renders the whole half
+ * buffer at once; a user implementation of dac_value_generate still takes
+ * precedence and is called once per sample.
+ */
+static void dac_samples_generate(dacsample_t *samples, size_t count) {
+    if (dac_value_generate) {
+        for (size_t s = 0; s < count; s++) {
+            samples[s] = dac_value_generate();
+        }
+        return;
     }
 
-    return value;
+    audio_mixer_render(samples, count);
 }
 
 /**
@@ -196,71 +171,32 @@ static void dac_end(DACDriver *dacp) {
         sample_p += AUDIO_DAC_BUFFER_SIZE / 2; // 'half_index'
     }
 
-    for (uint8_t s = 0; s < AUDIO_DAC_BUFFER_SIZE / 2; s++) {
-        if (OUTPUT_OFF <= state) {
-            sample_p[s] = AUDIO_DAC_OFF_VALUE;
-            continue;
-        } else {
-            sample_p[s] = dac_value_generate();
-        }
-
-        /* zero crossing (or approach, whereas zero == DAC_OFF_VALUE, which can be configured to anything from 0 to DAC_SAMPLE_MAX)
-         * ============================*=*========================== AUDIO_DAC_SAMPLE_MAX
-         *                          *       *
-         *                        *           *
-         * ---------------------------------------------------------
-         *                     *                 *                  } AUDIO_DAC_SAMPLE_MAX/100
-         * --------------------------------------------------------- AUDIO_DAC_OFF_VALUE
-         *                  *                       *               } AUDIO_DAC_SAMPLE_MAX/100
-         * ---------------------------------------------------------
-         *               *
-         * *           *
-         *   *       *
-         * =====*=*================================================= 0x0
-         */
-        if (((sample_p[s] + (AUDIO_DAC_SAMPLE_MAX / 100)) > AUDIO_DAC_OFF_VALUE) && // value approaches from below
-            (sample_p[s] < (AUDIO_DAC_OFF_VALUE + (AUDIO_DAC_SAMPLE_MAX / 100)))    // or above
-        ) {
-            if ((OUTPUT_SHOULD_START == state) && (active_tones_snapshot_length > 0)) {
-                state = OUTPUT_RUN_NORMALLY;
-            } else if (OUTPUT_TONES_CHANGED == state) {
-                state = OUTPUT_REACHED_ZERO_BEFORE_TONE_CHANGE;
-            } else if (OUTPUT_SHOULD_STOP == state) {
-                state = OUTPUT_REACHED_ZERO_BEFORE_OFF;
-            }
-        }
+    /* voices are only ever touched from this callback, the start/stop functions
+     * just request a state change, which is picked up here */
+    if (OUTPUT_SHOULD_START == state) {
+        update_voices();
+        state = OUTPUT_RUN_NORMALLY;
+    } else if (OUTPUT_SHOULD_STOP == state) {
+        audio_mixer_release_all();
+    }
 
-        // still 'ramping up', reset the output to OFF_VALUE until the generated values reach that value, to do a smooth handover
-        if (OUTPUT_SHOULD_START == state) {
+    if (OUTPUT_OFF <= state) {
+        for (uint8_t s = 0; s < AUDIO_DAC_BUFFER_SIZE / 2; s++) {
             sample_p[s] = AUDIO_DAC_OFF_VALUE;
         }
-
-        if ((OUTPUT_SHOULD_START == state) || (OUTPUT_REACHED_ZERO_BEFORE_OFF == state) || (OUTPUT_REACHED_ZERO_BEFORE_TONE_CHANGE == state)) {
-            uint8_t active_tones         = MIN(AUDIO_MAX_SIMULTANEOUS_TONES, audio_get_number_of_active_tones());
-            active_tones_snapshot_length = 0;
-            // update the snapshot - once, and only on occasion that something changed;
-            // -> saves cpu cycles (?)
-            for (uint8_t i = 0; i < active_tones; i++) {
-                float freq = audio_get_processed_frequency(i);
-                if (freq > 0) { // disregard 'rest' notes, with valid frequency 0.0f; which would only lower the resulting waveform volume during the additive synthesis step
-                    active_tones_snapshot[active_tones_snapshot_length++] = freq;
-                }
-            }
-
-            if ((0 == active_tones_snapshot_length) && (OUTPUT_REACHED_ZERO_BEFORE_OFF == state)) {
-                state = OUTPUT_OFF;
-            }
-            if (OUTPUT_REACHED_ZERO_BEFORE_TONE_CHANGE == state) {
-                state = OUTPUT_RUN_NORMALLY;
-            }
-        }
+    } else {
+        dac_samples_generate(sample_p, AUDIO_DAC_BUFFER_SIZE / 2);
     }
 
     // update audio internal state (note position, current_note, ...)
-    if (audio_update_state()) {
-        if (OUTPUT_SHOULD_STOP != state) {
-            state = OUTPUT_TONES_CHANGED;
-        }
+    if (audio_update_state() && OUTPUT_RUN_NORMALLY == state) {
+        update_voices();
+    }
+
+    /* the release ramps replace waiting for a zero crossing: once every voice
+     * has faded out the mixer glides the output back to AUDIO_DAC_OFF_VALUE */
+    if (OUTPUT_SHOULD_STOP == state && (dac_value_generate || audio_mixer_is_silent())) {
+        state = OUTPUT_OFF;
     }
 
     if (OUTPUT_OFF <= state) {
@@ -347,6 +283,14 @@ void audio_driver_initialize_impl(void) {
     }
 #endif
 
+    wavetable_init();
+    /* the gpt timer runs with 3*AUDIO_DAC_SAMPLE_RATE, and the DAC callback is
+     * called twice per conversion; which puts the actual sample rate at 3/2 of
+     * the nominal one (as measured with an oscilloscope) */
+    audio_mixer_init(AUDIO_DAC_SAMPLE_RATE * 3 / 2, wavetable, AUDIO_DAC_SAMPLE_MAX / 2, AUDIO_DAC_SAMPLE_MAX / 2);
+    // the output idles at AUDIO_DAC_OFF_VALUE, which need not be the center of the mix
+    audio_mixer_set_rest(AUDIO_DAC_OFF_VALUE);
+
     gptStart(&GPTD6, &gpt6cfg1);
 }
 
@@ -355,14 +299,8 @@ void audio_driver_stop_impl(void) {
 }
 
 void audio_driver_start_impl(void) {
+    state = OUTPUT_SHOULD_START;
     gptStartContinuous(&GPTD6, 2U);
-
-    for (uint8_t i = 0; i < AUDIO_MAX_SIMULTANEOUS_TONES; i++) {
-        dac_if[i]                = 0.0f;
-        active_tones_snapshot[i] = 0.0f;
-    }
-    active_tones_snapshot_length = 0;
-    state                        = OUTPUT_SHOULD_START;
 }
 
 #pragma GCC diagnostic pop
@@ -7,9 +7,8 @@
 #endif
 
 // Platform specific implementations
-static void     backlight_timer_configure(bool enable);
-static void     backlight_timer_set_duty(uint16_t duty);
-static uint16_t backlight_timer_get_duty(void);
+static void backlight_timer_configure(bool enable);
+static void backlight_timer_set_duty(uint16_t duty);
 
 // See http://jared.geek.nz/2013/feb/linear-led-pwm
 static uint16_t cie_lightness(uint16_t v) {
@@ -54,10 +53,6 @@ static void backlight_timer_top(void) {
         breathing_task();
     }
 #endif
-
-    if (backlight_timer_get_duty() > 256) {
-        backlight_pins_on();
-    }
 }
 
 static void backlight_timer_cmp(void) {
@@ -114,54 +109,65 @@ void breathing_pulse(void) {
 #endif
 
 #ifdef PROTOCOL_CHIBIOS
-// On Platforms where timers fire every tick and have no capture/top events
-//   - fake event in the normal timer callback
-uint16_t s_duty = 0;
-
-static void timerCallback(void) {
-    /* Software PWM
-     * timer:1111 1111 1111 1111
-     *       \______/| \_______/____  count(0-255)
-     *          \    \______________  unused(1)
-     *           \__________________  index of step table(0-127)
-     */
-
-    // this works for cca 65536 irqs/sec
-    static union {
-        uint16_t raw;
-        struct {
-            uint16_t count : 8;
-            uint8_t  dummy : 1;
-            uint8_t  index : 7;
-        } pwm;
-    } timer = {.raw = 0};
-
-    timer.raw++;
-
-    if (timer.pwm.count == 0) {
-        // LED on
-        backlight_timer_top();
-    } else if (timer.pwm.count == (s_duty / 256)) {
-        // LED off
-        backlight_timer_cmp();
-    }
-}
+// Software PWM driven by one-shot GPT timeouts: the pins are switched on at the start of each period and off once the
+// duty cycle has elapsed, so the timer only interrupts twice per period rather than on every step of the counter.
+#    ifndef BACKLIGHT_PWM_FREQUENCY
+#        define BACKLIGHT_PWM_FREQUENCY 256
+#    endif
+#    define BACKLIGHT_GPT_FREQUENCY 1000000
+#    define BACKLIGHT_PWM_PERIOD (BACKLIGHT_GPT_FREQUENCY / BACKLIGHT_PWM_FREQUENCY)
+
+// On and off times shorter than this are rounded to a full period of off or on, so the interrupts never pile up.
+#    ifndef BACKLIGHT_PWM_MIN_TICKS
+#        define BACKLIGHT_PWM_MIN_TICKS 10
+#    endif
+
+#    if BACKLIGHT_PWM_PERIOD > 0xFFFF || BACKLIGHT_PWM_PERIOD < 4 * BACKLIGHT_PWM_MIN_TICKS
+#        error "BACKLIGHT_PWM_FREQUENCY is out of range"
+#    endif
+
+static gptcnt_t s_on_ticks = 0;
+static gptcnt_t s_off_ticks;
+static bool     s_pins_on = false;
 
 static void backlight_timer_set_duty(uint16_t duty) {
-    s_duty = duty;
-}
-static uint16_t backlight_timer_get_duty(void) {
-    return s_duty;
+    s_on_ticks = (uint32_t)duty * BACKLIGHT_PWM_PERIOD / 0xFFFFU;
 }
 
-// ChibiOS - Map GPT timer onto Software PWM
 static void gptTimerCallback(GPTDriver *gptp) {
-    (void)gptp;
-    timerCallback();
+    gptcnt_t next;
+
+    if (s_pins_on) {
+        // End of the duty cycle
+        backlight_timer_cmp();
+        s_pins_on = false;
+        next      = s_off_ticks;
+    } else {
+        // Start of the period
+        backlight_timer_top();
+
+        gptcnt_t on_ticks = s_on_ticks;
+        if (on_ticks < BACKLIGHT_PWM_MIN_TICKS) {
+            backlight_pins_off();
+            next = BACKLIGHT_PWM_PERIOD;
+        } else if (on_ticks > BACKLIGHT_PWM_PERIOD - BACKLIGHT_PWM_MIN_TICKS) {
+            backlight_pins_on();
+            next = BACKLIGHT_PWM_PERIOD;
+        } else {
+            backlight_pins_on();
+            s_pins_on   = true;
+            s_off_ticks = BACKLIGHT_PWM_PERIOD - on_ticks;
+            next        = on_ticks;
+        }
+    }
+
+    chSysLockFromISR();
+    gptStartOneShotI(gptp, next);
+    chSysUnlockFromISR();
 }
 
 static void backlight_timer_configure(bool enable) {
-    static const GPTConfig gptcfg = {1000000, gptTimerCallback, 0, 0};
+    static const GPTConfig gptcfg = {BACKLIGHT_GPT_FREQUENCY, gptTimerCallback, 0, 0};
 
     static bool s_init = false;
     if (!s_init) {
@@ -169,10 +175,16 @@ static void backlight_timer_configure(bool enable) {
         s_init = true;
     }
 
+    osalSysLock();
     if (enable) {
-        gptStartContinuous(&BACKLIGHT_GPT_DRIVER, gptcfg.frequency / 0xFFFF);
+        if (BACKLIGHT_GPT_DRIVER.state == GPT_READY) {
+            s_pins_on = false;
+            gptStartOneShotI(&BACKLIGHT_GPT_DRIVER, BACKLIGHT_PWM_MIN_TICKS);
+        }
     } else {
-        gptStopTimer(&BACKLIGHT_GPT_DRIVER);
+        gptStopTimerI(&BACKLIGHT_GPT_DRIVER);
+        s_pins_on = false;
     }
+    osalSysUnlock();
 }
 #endif
@@ -27,6 +27,7 @@
  */
 
 #include "i2c_master.h"
+#include "bus_stats.h"
 #include "gpio.h"
 #include "chibios_config.h"
 #include <ch.h>
@@ -107,16 +108,38 @@ static const I2CConfig i2cconfig = {
 #endif
 };
 
+/**
+ * @brief Starts the I2C peripheral for a transaction. When the transaction
+ * queue is enabled its worker thread shares the bus with callers of this API,
+ * so the bus is also locked until i2c_epilogue.
+ */
+static void i2c_start(void) {
+#if defined(I2C_QUEUE_ENABLE) && (I2C_USE_MUTUAL_EXCLUSION == TRUE)
+    i2cAcquireBus(&I2C_DRIVER);
+#endif
+    BUS_STATS_BEGIN(I2C);
+    i2cStart(&I2C_DRIVER, &i2cconfig);
+}
+
+static void i2c_release(void) {
+#if defined(I2C_QUEUE_ENABLE) && (I2C_USE_MUTUAL_EXCLUSION == TRUE)
+    i2cReleaseBus(&I2C_DRIVER);
+#endif
+}
+
 /**
  * @brief Handles any I2C error condition by stopping the I2C peripheral and
  * aborting any ongoing transactions. Furthermore ChibiOS status codes are
  * converted into QMK codes.
  *
  * @param status ChibiOS specific I2C status code
+ * @param length number of bytes the transaction moved, for the bus statistics
  * @return i2c_status_t QMK specific I2C status code
  */
-static i2c_status_t i2c_epilogue(const msg_t status) {
+static i2c_status_t i2c_epilogue(const msg_t status, uint16_t length) {
     if (status == MSG_OK) {
+        BUS_STATS_END(I2C, length, I2C_STATUS_SUCCESS);
+        i2c_release();
         return I2C_STATUS_SUCCESS;
     }
 
@@ -125,7 +148,10 @@ static i2c_status_t i2c_epilogue(const msg_t status) {
     // hard stop in case of any error.
     i2cStop(&I2C_DRIVER);
 
-    return status == MSG_TIMEOUT ? I2C_STATUS_TIMEOUT : I2C_STATUS_ERROR;
+    i2c_status_t result = status == MSG_TIMEOUT ? I2C_STATUS_TIMEOUT : I2C_STATUS_ERROR;
+    BUS_STATS_END(I2C, length, result);
+    i2c_release();
+    return result;
 }
 
 __attribute__((weak)) void i2c_init(void) {
@@ -149,25 +175,25 @@ __attribute__((weak)) void i2c_init(void) {
 }
 
 i2c_status_t i2c_transmit(uint8_t address, const uint8_t* data, uint16_t length, uint16_t timeout) {
-    i2cStart(&I2C_DRIVER, &i2cconfig);
+    i2c_start();
     msg_t status = i2cMasterTransmitTimeout(&I2C_DRIVER, (address >> 1), data, length, 0, 0, TIME_MS2I(timeout));
-    return i2c_epilogue(status);
+    return i2c_epilogue(status, length);
 }
 
 i2c_status_t i2c_receive(uint8_t address, uint8_t* data, uint16_t length, uint16_t timeout) {
-    i2cStart(&I2C_DRIVER, &i2cconfig);
+    i2c_start();
     msg_t status = i2cMasterReceiveTimeout(&I2C_DRIVER, (address >> 1), data, length, TIME_MS2I(timeout));
-    return i2c_epilogue(status);
+    return i2c_epilogue(status, length);
 }
 
 i2c_status_t i2c_transmit_and_receive(uint8_t address, const uint8_t* tx_data, uint16_t tx_length, uint8_t* rx_data, uint16_t rx_length, uint16_t timeout) {
-    i2cStart(&I2C_DRIVER, &i2cconfig);
+    i2c_start();
     msg_t status = i2cMasterTransmitTimeout(&I2C_DRIVER, (address >> 1), tx_data, tx_length, rx_data, rx_length, TIME_MS2I(timeout));
-    return i2c_epilogue(status);
+    return i2c_epilogue(status, tx_length + rx_length);
 }
 
 i2c_status_t i2c_write_register(uint8_t devaddr, uint8_t regaddr, const uint8_t* data, uint16_t length, uint16_t timeout) {
-    i2cStart(&I2C_DRIVER, &i2cconfig);
+    i2c_start();
 
     uint8_t complete_packet[length + 1];
     for (uint16_t i = 0; i < length; i++) {
@@ -176,11 +202,11 @@ i2c_status_t i2c_write_register(uint8_t devaddr, uint8_t regaddr, const uint8_t*
     complete_packet[0] = regaddr;
 
     msg_t status = i2cMasterTransmitTimeout(&I2C_DRIVER, (devaddr >> 1), complete_packet, length + 1, 0, 0, TIME_MS2I(timeout));
-    return i2c_epilogue(status);
+    return i2c_epilogue(status, length + 1);
 }
 
 i2c_status_t i2c_write_register16(uint8_t devaddr, uint16_t regaddr, const uint8_t* data, uint16_t length, uint16_t timeout) {
-    i2cStart(&I2C_DRIVER, &i2cconfig);
+    i2c_start();
 
     uint8_t complete_packet[length + 2];
     for (uint16_t i = 0; i < length; i++) {
@@ -190,20 +216,20 @@ i2c_status_t i2c_write_register16(uint8_t devaddr, uint16_t regaddr, const uint8
     complete_packet[1] = regaddr & 0xFF;
 
     msg_t status = i2cMasterTransmitTimeout(&I2C_DRIVER, (devaddr >> 1), complete_packet, length + 2, 0, 0, TIME_MS2I(timeout));
-    return i2c_epilogue(status);
+    return i2c_epilogue(status, length + 2);
 }
 
 i2c_status_t i2c_read_register(uint8_t devaddr, uint8_t regaddr, uint8_t* data, uint16_t length, uint16_t timeout) {
-    i2cStart(&I2C_DRIVER, &i2cconfig);
+    i2c_start();
     msg_t status = i2cMasterTransmitTimeout(&I2C_DRIVER, (devaddr >> 1), &regaddr, 1, data, length, TIME_MS2I(timeout));
-    return i2c_epilogue(status);
+    return i2c_epilogue(status, length + 1);
 }
 
 i2c_status_t i2c_read_register16(uint8_t devaddr, uint16_t regaddr, uint8_t* data, uint16_t length, uint16_t timeout) {
-    i2cStart(&I2C_DRIVER, &i2cconfig);
+    i2c_start();
     uint8_t register_packet[2] = {regaddr >> 8, regaddr & 0xFF};
     msg_t   status             = i2cMasterTransmitTimeout(&I2C_DRIVER, (devaddr >> 1), register_packet, 2, data, length, TIME_MS2I(timeout));
-    return i2c_epilogue(status);
+    return i2c_epilogue(status, length + 2);
 }
 
 __attribute__((weak)) i2c_status_t i2c_ping_address(uint8_t address, uint16_t timeout) {
@@ -0,0 +1,52 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "i2c_queue.h"
+#include <ch.h>
+#include <hal.h>
+
+#if defined(I2C_QUEUE_ENABLE) && (I2C_USE_MUTUAL_EXCLUSION != TRUE)
+#    error "You need to set I2C_USE_MUTUAL_EXCLUSION to TRUE in your halconf.h to use the I2C transaction queue."
+#endif
+
+// ChibiOS I2C transfers block the calling thread, so they are run on a worker thread instead of the main loop. The
+// worker sleeps on the driver while the peripheral moves the bytes, which hands the CPU back to the main loop; it runs
+// above NORMALPRIO so a queued transfer starts as soon as it is signalled. i2c_master.c takes the bus lock around
+// every transfer, so drivers that still use the blocking API can share the bus with the queue.
+
+#ifndef I2C_QUEUE_THREAD_STACK_SIZE
+#    define I2C_QUEUE_THREAD_STACK_SIZE 256
+#endif
+
+static THD_WORKING_AREA(waI2CQueueThread, I2C_QUEUE_THREAD_STACK_SIZE);
+static binary_semaphore_t    transfer_ready;
+static const i2c_transfer_t *pending_transfer;
+
+static THD_FUNCTION(I2CQueueThread, arg) {
+    (void)arg;
+    chRegSetThreadName("i2c_queue");
+
+    while (true) {
+        chBSemWait(&transfer_ready);
+
+        const i2c_transfer_t *transfer = pending_transfer;
+        i2c_status_t          status;
+        if (transfer->rx_length > 0) {
+            status = i2c_transmit_and_receive(transfer->address, transfer->tx_data, transfer->tx_length, transfer->rx_data, transfer->rx_length, transfer->timeout);
+        } else {
+            status = i2c_transmit(transfer->address, transfer->tx_data, transfer->tx_length, transfer->timeout);
+        }
+        i2c_queue_backend_complete(status);
+    }
+}
+
+void i2c_queue_backend_init(void) {
+    i2c_init();
+    chBSemObjectInit(&transfer_ready, true);
+    chThdCreateStatic(waI2CQueueThread, sizeof(waI2CQueueThread), NORMALPRIO + 1, I2CQueueThread, NULL);
+}
+
+void i2c_queue_backend_start(const i2c_transfer_t *transfer) {
+    pending_transfer = transfer;
+    chBSemSignal(&transfer_ready);
+}
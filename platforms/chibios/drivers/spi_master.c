@@ -15,6 +15,7 @@
  */
 
 #include "spi_master.h"
+#include "bus_stats.h"
 #include "chibios_config.h"
 #include <ch.h>
 #include <hal.h>
@@ -438,25 +439,33 @@ bool spi_start(pin_t slavePin, bool lsbFirst, uint8_t mode, uint16_t divisor) {
 
 spi_status_t spi_write(uint8_t data) {
     uint8_t rxData;
+    BUS_STATS_BEGIN(SPI);
     spiExchange(&SPI_DRIVER, 1, &data, &rxData);
+    BUS_STATS_END(SPI, 1, SPI_STATUS_SUCCESS);
 
     return rxData;
 }
 
 spi_status_t spi_read(void) {
     uint8_t data = 0;
+    BUS_STATS_BEGIN(SPI);
     spiReceive(&SPI_DRIVER, 1, &data);
+    BUS_STATS_END(SPI, 1, SPI_STATUS_SUCCESS);
 
     return data;
 }
 
 spi_status_t spi_transmit(const uint8_t *data, uint16_t length) {
+    BUS_STATS_BEGIN(SPI);
     spiSend(&SPI_DRIVER, length, data);
+    BUS_STATS_END(SPI, length, SPI_STATUS_SUCCESS);
     return SPI_STATUS_SUCCESS;
 }
 
 spi_status_t spi_receive(uint8_t *data, uint16_t length) {
+    BUS_STATS_BEGIN(SPI);
     spiReceive(&SPI_DRIVER, length, data);
+    BUS_STATS_END(SPI, length, SPI_STATUS_SUCCESS);
     return SPI_STATUS_SUCCESS;
 }
 
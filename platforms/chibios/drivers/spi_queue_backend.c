@@ -0,0 +1,59 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "spi_queue.h"
+#include <ch.h>
+#include <hal.h>
+
+#if defined(SPI_QUEUE_ENABLE) && (SPI_USE_MUTUAL_EXCLUSION != TRUE)
+#    error "You need to set SPI_USE_MUTUAL_EXCLUSION to TRUE in your halconf.h to use the SPI transaction queue."
+#endif
+
+// ChibiOS SPI transfers block the calling thread while the peripheral's DMA moves the bytes, so they are run on a
+// worker thread instead of the main loop. It runs above NORMALPRIO so a queued transfer starts as soon as it is
+// signalled. Each transfer is a complete spi_start() to spi_stop() session, which holds the bus lock, so drivers that
+// still use the blocking API can share the bus with the queue.
+
+#ifndef SPI_QUEUE_THREAD_STACK_SIZE
+#    define SPI_QUEUE_THREAD_STACK_SIZE 256
+#endif
+
+static THD_WORKING_AREA(waSPIQueueThread, SPI_QUEUE_THREAD_STACK_SIZE);
+static binary_semaphore_t    transfer_ready;
+static const spi_transfer_t *pending_transfer;
+
+static THD_FUNCTION(SPIQueueThread, arg) {
+    (void)arg;
+    chRegSetThreadName("spi_queue");
+
+    while (true) {
+        chBSemWait(&transfer_ready);
+
+        const spi_transfer_t *transfer = pending_transfer;
+        spi_status_t          status   = SPI_STATUS_ERROR;
+        if (spi_start_extended((spi_start_config_t *)transfer->device)) {
+            status = SPI_STATUS_SUCCESS;
+            for (uint8_t i = 0; i < transfer->segment_count && status >= 0; i++) {
+                const spi_segment_t *segment = &transfer->segments[i];
+                if (segment->tx_data != NULL) {
+                    status = spi_transmit(segment->tx_data, segment->length);
+                } else {
+                    status = spi_receive(segment->rx_data, segment->length);
+                }
+            }
+            spi_stop();
+        }
+        spi_queue_backend_complete(status);
+    }
+}
+
+void spi_queue_backend_init(void) {
+    spi_init();
+    chBSemObjectInit(&transfer_ready, true);
+    chThdCreateStatic(waSPIQueueThread, sizeof(waSPIQueueThread), NORMALPRIO + 1, SPIQueueThread, NULL);
+}
+
+void spi_queue_backend_start(const spi_transfer_t *transfer) {
+    pending_transfer = transfer;
+    chBSemSignal(&transfer_ready);
+}
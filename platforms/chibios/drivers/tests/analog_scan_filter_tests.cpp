@@ -0,0 +1,72 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "analog_scan_filter.h"
+}
+
+static const uint8_t SHIFT = 3;
+
+TEST(AnalogScanFilter, AveragesOneChannelOfInterleavedSequences) {
+    // Three channels, four sequences
+    const uint16_t samples[] = {
+        10, 100, 4095, //
+        20, 101, 4095, //
+        30, 102, 4095, //
+        41, 103, 4095, //
+    };
+
+    EXPECT_EQ(analog_scan_average(samples, 3, 0, 4), 25);
+    EXPECT_EQ(analog_scan_average(samples, 3, 1, 4), 101);
+    EXPECT_EQ(analog_scan_average(samples, 3, 2, 4), 4095);
+    EXPECT_EQ(analog_scan_average(samples, 3, 1, 1), 100);
+}
+
+TEST(AnalogScanFilter, AverageOfFullScaleDoesNotOverflow) {
+    uint16_t samples[256];
+    for (auto &sample : samples) {
+        sample = 4095;
+    }
+
+    EXPECT_EQ(analog_scan_average(samples, 1, 0, 256), 4095);
+}
+
+TEST(AnalogScanFilter, StartsAtFirstValue) {
+    EXPECT_EQ(analog_scan_filter_value(analog_scan_filter_start(1234, SHIFT), SHIFT), 1234);
+}
+
+TEST(AnalogScanFilter, ConstantInputDoesNotDrift) {
+    uint32_t average = analog_scan_filter_start(1000, SHIFT);
+    for (int i = 0; i < 1000; i++) {
+        average = analog_scan_filter(average, 1000, SHIFT);
+    }
+
+    EXPECT_EQ(average, 1000u << SHIFT);
+    EXPECT_EQ(analog_scan_filter_value(average, SHIFT), 1000);
+}
+
+TEST(AnalogScanFilter, StepMovesByOneEighthOfTheDifference) {
+    uint32_t average = analog_scan_filter_start(0, SHIFT);
+
+    average = analog_scan_filter(average, 800, SHIFT);
+    EXPECT_EQ(analog_scan_filter_value(average, SHIFT), 100);
+
+    average = analog_scan_filter(average, 800, SHIFT);
+    EXPECT_EQ(analog_scan_filter_value(average, SHIFT), 187); // 100 + 700 / 8
+}
+
+TEST(AnalogScanFilter, StepSettlesOnTheNewValue) {
+    // Truncating the unscaled average would get stuck 2^SHIFT - 1 below the input
+    uint32_t average = analog_scan_filter_start(0, SHIFT);
+    for (int i = 0; i < 200; i++) {
+        average = analog_scan_filter(average, 4095, SHIFT);
+    }
+    EXPECT_EQ(analog_scan_filter_value(average, SHIFT), 4095);
+
+    for (int i = 0; i < 200; i++) {
+        average = analog_scan_filter(average, 0, SHIFT);
+    }
+    EXPECT_EQ(analog_scan_filter_value(average, SHIFT), 0);
+}
@@ -0,0 +1,4 @@
+analog_scan_filter_INC := $(PLATFORM_PATH)/chibios/drivers
+
+analog_scan_filter_SRC := \
+	$(PLATFORM_PATH)/chibios/drivers/tests/analog_scan_filter_tests.cpp
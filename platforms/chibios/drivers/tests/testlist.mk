@@ -0,0 +1 @@
+TEST_LIST += analog_scan_filter
@@ -43,3 +43,11 @@ typedef ioline_t pin_t;
 #define gpio_read_pin(pin) palReadLine(pin)
 
 #define gpio_toggle_pin(pin) palToggleLine(pin)
+
+/* Operation of GPIO by port. */
+
+typedef ioportid_t gpio_port_t;
+
+#define gpio_pin_port(pin) PAL_PORT(pin)
+#define gpio_pin_bit(pin) PAL_PAD(pin)
+#define gpio_read_port(port) palReadPort(port)
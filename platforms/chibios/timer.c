@@ -94,6 +94,22 @@ void timer_save(void) {
     platform_timer_save_value(timer_read32());
 }
 
+uint32_t timer_read_us32(void) {
+    syssts_t sts            = chSysGetStatusAndLockX();
+    uint32_t ticks          = get_system_time_ticks() - ticks_offset;
+    uint32_t ms_offset_copy = ms_offset; // read while still holding the lock to ensure a consistent value
+    chSysRestoreStatusX(sts);
+
+    // Same epoch as timer_read32(): ticks_offset and ms_offset are always adjusted by equivalent amounts
+#if (1000000 % CH_CFG_ST_FREQUENCY) == 0
+    // Wraps around consistently with the tick counter, as 2**32 ticks is a multiple of 2**32 microseconds
+    return ticks * (1000000 / CH_CFG_ST_FREQUENCY) + ms_offset_copy * 1000;
+#else
+    // Only wraps around correctly when the tick counter itself overflows, which takes days at common frequencies
+    return (uint32_t)(((uint64_t)ticks * 1000000) / CH_CFG_ST_FREQUENCY) + ms_offset_copy * 1000;
+#endif
+}
+
 uint16_t timer_read(void) {
     return (uint16_t)timer_read32();
 }
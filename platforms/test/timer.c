@@ -20,6 +20,7 @@
 static atomic_uint_least32_t current_time      = 0;
 static atomic_uint_least32_t async_tick_amount = 0;
 static atomic_uint_least32_t access_counter    = 0;
+static atomic_uint_least32_t current_time_us   = 0; // below the current millisecond
 
 void simulate_async_tick(uint32_t t) {
     async_tick_amount = t;
@@ -41,12 +42,14 @@ void timer_init(void) {
     current_time      = 0;
     async_tick_amount = 0;
     access_counter    = 0;
+    current_time_us   = 0;
 }
 
 void timer_clear(void) {
     current_time      = 0;
     async_tick_amount = 0;
     access_counter    = 0;
+    current_time_us   = 0;
 }
 
 uint16_t timer_read(void) {
@@ -60,9 +63,21 @@ uint32_t timer_read32(void) {
     return current_time;
 }
 
+uint32_t timer_read_us32(void) {
+    return timer_read32() * 1000 + current_time_us;
+}
+
 void set_time(uint32_t t) {
-    current_time   = t;
-    access_counter = 0;
+    current_time    = t;
+    current_time_us = 0;
+    access_counter  = 0;
+}
+
+void advance_time_us(uint32_t us) {
+    us += current_time_us;
+    current_time += us / 1000;
+    current_time_us = us % 1000;
+    access_counter  = 0;
 }
 
 void advance_time(uint32_t ms) {
@@ -14,3 +14,7 @@ uint16_t timer_elapsed(uint16_t last) {
 uint32_t timer_elapsed32(uint32_t last) {
     return TIMER_DIFF_32(timer_read32(), last);
 }
+
+uint32_t timer_elapsed_us32(uint32_t last) {
+    return TIMER_DIFF_32(timer_read_us32(), last);
+}
@@ -40,7 +40,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #    include "pointing_device.h"
 #endif
 
-#if defined(ENCODER_ENABLE) && defined(ENCODER_MAP_ENABLE) && defined(SWAP_HANDS_ENABLE)
+#if defined(ENCODER_ENABLE) && defined(ENCODER_MAP_ENABLE) && (defined(SWAP_HANDS_ENABLE) || (defined(ENCODER_MAP_COALESCE_SCROLL) && defined(POINTING_DEVICE_ENABLE)))
 #    include "encoder.h"
 #endif
 
@@ -577,6 +577,12 @@ void process_action(keyrecord_t *record, action_t action) {
 #endif // EXTRAKEY_ENABLE
         /* Mouse key */
         case ACT_MOUSEKEY:
+#if defined(ENCODER_ENABLE) && defined(ENCODER_MAP_ENABLE) && defined(ENCODER_MAP_COALESCE_SCROLL) && defined(POINTING_DEVICE_ENABLE)
+            // Encoder wheel turns go out with the next pointing device report rather than a report per detent
+            if (IS_ENCODEREVENT(event) && encoder_map_scroll(action.key.code, event.pressed)) {
+                break;
+            }
+#endif
             register_mouse(action.key.code, event.pressed);
             break;
 #ifndef NO_ACTION_LAYER
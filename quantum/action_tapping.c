@@ -24,8 +24,14 @@
 #    else
 #        define IS_TAPPING_RECORD(r) (KEYEQ(tapping_key.event.key, (r->event.key)) && tapping_key.keycode == r->keycode)
 #    endif
-#    define WITHIN_TAPPING_TERM(e) (TIMER_DIFF_16(e.time, tapping_key.event.time) < GET_TAPPING_TERM(get_record_keycode(&tapping_key, false), &tapping_key))
-#    define WITHIN_QUICK_TAP_TERM(e) (TIMER_DIFF_16(e.time, tapping_key.event.time) < GET_QUICK_TAP_TERM(get_record_keycode(&tapping_key, false), &tapping_key))
+#    ifdef KEYEVENT_TIME_US
+// Compare against the microsecond timestamps, so a tap that lasted TAPPING_TERM - 1 ms plus a fraction is not rounded up
+#        define WITHIN_TAPPING_TERM(e) (TIMER_DIFF_32(e.time_us, tapping_key.event.time_us) < (uint32_t)GET_TAPPING_TERM(get_record_keycode(&tapping_key, false), &tapping_key) * 1000)
+#        define WITHIN_QUICK_TAP_TERM(e) (TIMER_DIFF_32(e.time_us, tapping_key.event.time_us) < (uint32_t)GET_QUICK_TAP_TERM(get_record_keycode(&tapping_key, false), &tapping_key) * 1000)
+#    else
+#        define WITHIN_TAPPING_TERM(e) (TIMER_DIFF_16(e.time, tapping_key.event.time) < GET_TAPPING_TERM(get_record_keycode(&tapping_key, false), &tapping_key))
+#        define WITHIN_QUICK_TAP_TERM(e) (TIMER_DIFF_16(e.time, tapping_key.event.time) < GET_QUICK_TAP_TERM(get_record_keycode(&tapping_key, false), &tapping_key))
+#    endif
 
 #    ifdef DYNAMIC_TAPPING_TERM_ENABLE
 uint16_t g_tapping_term = TAPPING_TERM;
@@ -146,6 +152,13 @@ static void debug_waiting_buffer(void);
  * FIXME: Needs doc
  */
 void action_tapping_process(keyrecord_t record) {
+#    ifdef KEYEVENT_TIME_US
+    // Events built by hand rather than by MAKE_EVENT() may leave the microsecond time unset
+    if (IS_EVENT(record.event) && record.event.time_us == 0) {
+        record.event.time_us = keyevent_time_us(record.event.time);
+    }
+#    endif
+
 #    ifdef SPECULATIVE_HOLD
     prev_speculative_mods = speculative_mods;
     if (record.event.pressed) {
@@ -520,6 +533,9 @@ bool process_tapping(keyrecord_t *keyp) {
                             .event.time    = event.time,
                             .event.pressed = false,
                             .event.type    = tapping_key.event.type,
+#    ifdef KEYEVENT_TIME_US
+                            .event.time_us = event.time_us,
+#    endif
 #    ifdef COMBO_ENABLE
                             .keycode = tapping_key.keycode,
 #    endif
@@ -571,6 +587,9 @@ bool process_tapping(keyrecord_t *keyp) {
                             .event.time    = event.time,
                             .event.pressed = false,
                             .event.type    = tapping_key.event.type,
+#    ifdef KEYEVENT_TIME_US
+                            .event.time_us = event.time_us,
+#    endif
 #    ifdef COMBO_ENABLE
                             .keycode = tapping_key.keycode,
 #    endif
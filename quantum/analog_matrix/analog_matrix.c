@@ -0,0 +1,262 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "analog_matrix.h"
+#include "nvm_analog_matrix.h"
+
+#ifdef SPLIT_KEYBOARD
+#    error "The analog matrix does not support split keyboards"
+#endif
+
+// Each scan reads every sensor, converts the reading into travel using the key's calibration, and runs the key's
+// state machine on that travel. Without rapid trigger a key presses at its actuation point and releases below its
+// release point. With rapid trigger, a pressed key also releases once it has risen by the sensitivity from the deepest
+// point reached, and while it stays above the release point it presses again once it has gone down by the sensitivity
+// from the shallowest point reached. The resulting rows go through debounce() and into action_exec() like those of a
+// switch matrix.
+
+typedef struct {
+    uint8_t extreme; // deepest travel while pressed, shallowest while released during a rapid trigger run
+    bool    pressed : 1;
+    bool    rapid : 1; // released by rapid trigger and not yet back above the release point
+} analog_key_state_t;
+
+static analog_key_config_t key_configs[MATRIX_ROWS][MATRIX_COLS];
+static analog_key_state_t  key_states[MATRIX_ROWS][MATRIX_COLS];
+static uint8_t             key_travel[MATRIX_ROWS][MATRIX_COLS];
+static uint16_t            raw_values[MATRIX_ROWS][MATRIX_COLS];
+static bool                calibrating = false;
+
+static void set_default_config(analog_key_config_t *config, uint16_t rest) {
+    int32_t bottom = (int32_t)rest + (ANALOG_MATRIX_TRAVEL_RANGE);
+    if (bottom < 0) {
+        bottom = 0;
+    } else if (bottom > UINT16_MAX) {
+        bottom = UINT16_MAX;
+    }
+
+    config->rest          = rest;
+    config->bottom        = bottom;
+    config->actuation     = ANALOG_MATRIX_ACTUATION_POINT;
+    config->release       = ANALOG_MATRIX_RELEASE_POINT;
+    config->rapid_trigger = ANALOG_MATRIX_RAPID_TRIGGER_SENSITIVITY;
+}
+
+static void save_all(void) {
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            nvm_analog_matrix_update_key(row, col, &key_configs[row][col]);
+        }
+    }
+    nvm_analog_matrix_set_valid();
+}
+
+static uint8_t travel_of(const analog_key_config_t *config, uint16_t value) {
+    int32_t range = (int32_t)config->bottom - config->rest;
+    int32_t delta = (int32_t)value - config->rest;
+    if (range < 0) {
+        range = -range;
+        delta = -delta;
+    }
+
+    if (delta <= 0 || range == 0) {
+        return 0;
+    }
+    if (delta >= range) {
+        return ANALOG_MATRIX_TRAVEL_MAX;
+    }
+    return (delta * ANALOG_MATRIX_TRAVEL_MAX) / range;
+}
+
+static void update_key(const analog_key_config_t *config, analog_key_state_t *state, uint8_t travel) {
+    uint8_t sensitivity = config->rapid_trigger;
+
+    if (state->pressed) {
+        if (travel > state->extreme) {
+            state->extreme = travel;
+        }
+        if (travel <= config->release) {
+            state->pressed = false;
+            state->rapid   = false;
+            state->extreme = travel;
+        } else if (sensitivity > 0 && travel + sensitivity <= state->extreme) {
+            state->pressed = false;
+            state->rapid   = true;
+            state->extreme = travel;
+        }
+        return;
+    }
+
+    if (state->rapid) {
+        if (travel <= config->release) {
+            state->rapid = false;
+        } else {
+            if (travel < state->extreme) {
+                state->extreme = travel;
+            }
+            if (travel >= state->extreme + sensitivity) {
+                state->pressed = true;
+                state->extreme = travel;
+            }
+            return;
+        }
+    }
+
+    if (travel >= config->actuation) {
+        state->pressed = true;
+        state->extreme = travel;
+    }
+}
+
+static void calibrate_key(analog_key_config_t *config, uint16_t value) {
+    int32_t learned = (int32_t)config->bottom - config->rest;
+    int32_t delta   = (int32_t)value - config->rest;
+    if ((delta < 0 ? -delta : delta) > (learned < 0 ? -learned : learned)) {
+        config->bottom = value;
+    }
+}
+
+bool analog_matrix_process(const uint16_t values[MATRIX_ROWS][MATRIX_COLS], matrix_row_t current_matrix[]) {
+    bool changed = false;
+
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        matrix_row_t row_state = 0;
+
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            analog_key_config_t *config = &key_configs[row][col];
+            analog_key_state_t  *state  = &key_states[row][col];
+
+            if (calibrating) {
+                calibrate_key(config, values[row][col]);
+                continue;
+            }
+
+            key_travel[row][col] = travel_of(config, values[row][col]);
+            update_key(config, state, key_travel[row][col]);
+            if (state->pressed) {
+                row_state |= MATRIX_ROW_SHIFTER << col;
+            }
+        }
+
+        if (current_matrix[row] != row_state) {
+            current_matrix[row] = row_state;
+            changed             = true;
+        }
+    }
+
+    return changed;
+}
+
+void analog_matrix_init(void) {
+    bool valid = nvm_analog_matrix_is_valid();
+
+    analog_matrix_sample(raw_values);
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            if (valid) {
+                nvm_analog_matrix_read_key(row, col, &key_configs[row][col]);
+            } else {
+                set_default_config(&key_configs[row][col], raw_values[row][col]);
+            }
+            key_states[row][col] = (analog_key_state_t){0};
+            key_travel[row][col] = 0;
+        }
+    }
+    calibrating = false;
+}
+
+uint8_t analog_matrix_get_travel(uint8_t row, uint8_t col) {
+    return key_travel[row][col];
+}
+
+uint16_t analog_matrix_get_raw(uint8_t row, uint8_t col) {
+    return raw_values[row][col];
+}
+
+void analog_matrix_get_key_config(uint8_t row, uint8_t col, analog_key_config_t *config) {
+    *config = key_configs[row][col];
+}
+
+void analog_matrix_set_key_config(uint8_t row, uint8_t col, const analog_key_config_t *config) {
+    key_configs[row][col] = *config;
+    if (nvm_analog_matrix_is_valid()) {
+        nvm_analog_matrix_update_key(row, col, config);
+    } else {
+        save_all();
+    }
+}
+
+void analog_matrix_set_actuation(uint8_t actuation, uint8_t release, uint8_t rapid_trigger) {
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            key_configs[row][col].actuation     = actuation;
+            key_configs[row][col].release       = release;
+            key_configs[row][col].rapid_trigger = rapid_trigger;
+        }
+    }
+    save_all();
+}
+
+void analog_matrix_calibration_start(void) {
+    if (calibrating) {
+        return;
+    }
+
+    analog_matrix_sample(raw_values);
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            key_configs[row][col].rest   = raw_values[row][col];
+            key_configs[row][col].bottom = raw_values[row][col];
+            key_states[row][col]         = (analog_key_state_t){0};
+            key_travel[row][col]         = 0;
+        }
+    }
+    calibrating = true;
+}
+
+void analog_matrix_calibration_stop(void) {
+    if (!calibrating) {
+        return;
+    }
+
+    bool valid = nvm_analog_matrix_is_valid();
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            analog_key_config_t *config = &key_configs[row][col];
+            int32_t              range  = (int32_t)config->bottom - config->rest;
+
+            // Keys that were never pressed down keep their previous calibration.
+            if ((range < 0 ? -range : range) < ANALOG_MATRIX_CALIBRATION_THRESHOLD) {
+                analog_key_config_t previous;
+                if (valid) {
+                    nvm_analog_matrix_read_key(row, col, &previous);
+                } else {
+                    set_default_config(&previous, config->rest);
+                }
+                config->rest   = previous.rest;
+                config->bottom = previous.bottom;
+            }
+        }
+    }
+    calibrating = false;
+    save_all();
+}
+
+bool analog_matrix_calibration_is_active(void) {
+    return calibrating;
+}
+
+void analog_matrix_reset(void) {
+    nvm_analog_matrix_erase();
+    analog_matrix_init();
+}
+
+// CUSTOM MATRIX 'LITE'
+void matrix_init_custom(void) {
+    analog_matrix_init();
+}
+
+bool matrix_scan_custom(matrix_row_t current_matrix[]) {
+    analog_matrix_sample(raw_values);
+    return analog_matrix_process(raw_values, current_matrix);
+}
@@ -0,0 +1,90 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "compiler_support.h"
+#include "matrix.h"
+
+// Travel is normalised per key, from 0 at rest to ANALOG_MATRIX_TRAVEL_MAX when bottomed out.
+#define ANALOG_MATRIX_TRAVEL_MAX 255
+
+#ifndef ANALOG_MATRIX_ACTUATION_POINT
+#    define ANALOG_MATRIX_ACTUATION_POINT 128
+#endif
+
+#ifndef ANALOG_MATRIX_RELEASE_POINT
+#    define ANALOG_MATRIX_RELEASE_POINT 96
+#endif
+
+// Travel a key must move against its direction to re-trigger; 0 disables rapid trigger.
+#ifndef ANALOG_MATRIX_RAPID_TRIGGER_SENSITIVITY
+#    define ANALOG_MATRIX_RAPID_TRIGGER_SENSITIVITY 0
+#endif
+
+// Raw reading change from rest to bottom-out assumed for an uncalibrated key; negative if readings fall when pressed.
+#ifndef ANALOG_MATRIX_TRAVEL_RANGE
+#    define ANALOG_MATRIX_TRAVEL_RANGE 1000
+#endif
+
+// Raw reading change a key must exceed before calibration accepts it as a bottom-out.
+#ifndef ANALOG_MATRIX_CALIBRATION_THRESHOLD
+#    define ANALOG_MATRIX_CALIBRATION_THRESHOLD 100
+#endif
+
+typedef struct PACKED {
+    uint16_t rest;      // raw reading with the key released
+    uint16_t bottom;    // raw reading with the key bottomed out
+    uint8_t  actuation; // travel at which the key is pressed
+    uint8_t  release;   // travel below which the key is released
+    uint8_t  rapid_trigger;
+} analog_key_config_t;
+
+/**
+ * \brief Reads every key of the matrix in one pass.
+ *
+ * Provided by the selected ANALOG_MATRIX_DRIVER, or by the keyboard when it is `custom`. Readings are raw ADC counts;
+ * keys without a sensor should report the same value on every scan.
+ */
+void analog_matrix_sample(uint16_t values[MATRIX_ROWS][MATRIX_COLS]);
+
+/**
+ * \brief Converts a full set of readings into key states.
+ *
+ * \return true if any key changed state.
+ */
+bool analog_matrix_process(const uint16_t values[MATRIX_ROWS][MATRIX_COLS], matrix_row_t current_matrix[]);
+
+void analog_matrix_init(void);
+
+uint8_t  analog_matrix_get_travel(uint8_t row, uint8_t col);
+uint16_t analog_matrix_get_raw(uint8_t row, uint8_t col);
+
+void analog_matrix_get_key_config(uint8_t row, uint8_t col, analog_key_config_t *config);
+/**
+ * \brief Replaces the settings of a key and writes them to non-volatile memory.
+ */
+void analog_matrix_set_key_config(uint8_t row, uint8_t col, const analog_key_config_t *config);
+/**
+ * \brief Applies actuation settings to every key, keeping their calibration.
+ */
+void analog_matrix_set_actuation(uint8_t actuation, uint8_t release, uint8_t rapid_trigger);
+
+/**
+ * \brief Starts learning rest and bottom-out readings. No key events are produced until calibration stops.
+ *
+ * All keys must be released when calibration starts; each should then be pressed down fully at least once.
+ */
+void analog_matrix_calibration_start(void);
+/**
+ * \brief Stops calibration and saves the learned readings of every key that was bottomed out.
+ */
+void analog_matrix_calibration_stop(void);
+bool analog_matrix_calibration_is_active(void);
+
+/**
+ * \brief Drops the saved settings, returning every key to the defaults.
+ */
+void analog_matrix_reset(void);
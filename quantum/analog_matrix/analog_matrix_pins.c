@@ -0,0 +1,25 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "analog_matrix.h"
+#include "gpio.h"
+#include "analog.h"
+
+// One sensor per key, wired straight to an ADC pin. List the same pins in ANALOG_SCAN_PINS on ChibiOS so that each
+// read is served from the continuously sampled table instead of starting a conversion.
+
+#ifndef ANALOG_MATRIX_PINS
+#    error "ANALOG_MATRIX_PINS must be defined for ANALOG_MATRIX_DRIVER = pins"
+#endif
+
+static const pin_t sensor_pins[MATRIX_ROWS][MATRIX_COLS] = ANALOG_MATRIX_PINS;
+
+void analog_matrix_sample(uint16_t values[MATRIX_ROWS][MATRIX_COLS]) {
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            pin_t pin = sensor_pins[row][col];
+            // Unused positions never move, so they never leave rest.
+            values[row][col] = pin == NO_PIN ? 0 : analogReadPin(pin);
+        }
+    }
+}
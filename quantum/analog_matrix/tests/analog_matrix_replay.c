@@ -0,0 +1,57 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "analog_matrix_replay.h"
+
+// Stands in for the sensors: each scan advances every loaded trace by one reading, so a recording always produces the
+// same key events on the same scans.
+
+typedef struct {
+    const uint16_t *trace;
+    uint16_t        length;
+    uint16_t        position;
+    uint16_t        value;
+} replay_sensor_t;
+
+static replay_sensor_t sensors[MATRIX_ROWS][MATRIX_COLS];
+
+void analog_matrix_replay_reset(uint16_t value) {
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            sensors[row][col] = (replay_sensor_t){.value = value};
+        }
+    }
+}
+
+void analog_matrix_replay_set(uint8_t row, uint8_t col, uint16_t value) {
+    sensors[row][col] = (replay_sensor_t){.value = value};
+}
+
+void analog_matrix_replay_load(uint8_t row, uint8_t col, const uint16_t *trace, uint16_t length) {
+    sensors[row][col].trace    = trace;
+    sensors[row][col].length   = length;
+    sensors[row][col].position = 0;
+}
+
+bool analog_matrix_replay_is_running(void) {
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            if (sensors[row][col].position < sensors[row][col].length) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void analog_matrix_sample(uint16_t values[MATRIX_ROWS][MATRIX_COLS]) {
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            replay_sensor_t *sensor = &sensors[row][col];
+            if (sensor->position < sensor->length) {
+                sensor->value = sensor->trace[sensor->position++];
+            }
+            values[row][col] = sensor->value;
+        }
+    }
+}
@@ -0,0 +1,33 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "analog_matrix.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief Makes every sensor read `value` and drops any loaded traces.
+ */
+void analog_matrix_replay_reset(uint16_t value);
+/**
+ * \brief Makes one sensor read `value` until it is changed again.
+ */
+void analog_matrix_replay_set(uint8_t row, uint8_t col, uint16_t value);
+/**
+ * \brief Replays a recorded trace on one sensor, one reading per scan, then holds the last reading.
+ *
+ * The trace is not copied and must outlive the replay.
+ */
+void analog_matrix_replay_load(uint8_t row, uint8_t col, const uint16_t *trace, uint16_t length);
+/**
+ * \brief Returns true while any loaded trace still has readings left.
+ */
+bool analog_matrix_replay_is_running(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,157 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "analog_matrix.h"
+#include "nvm_analog_matrix.h"
+#include "analog_matrix_replay.h"
+
+bool matrix_scan_custom(matrix_row_t current_matrix[]);
+}
+
+static const uint16_t REST = 2000;
+
+// Reading that converts back to exactly `travel` with the default calibration.
+static uint16_t at(uint8_t travel) {
+    return REST + (travel * ANALOG_MATRIX_TRAVEL_RANGE + ANALOG_MATRIX_TRAVEL_MAX - 1) / ANALOG_MATRIX_TRAVEL_MAX;
+}
+
+struct KeyEvent {
+    int  scan;
+    bool pressed;
+
+    bool operator==(const KeyEvent &other) const {
+        return scan == other.scan && pressed == other.pressed;
+    }
+};
+
+class AnalogMatrix : public testing::Test {
+   protected:
+    matrix_row_t matrix[MATRIX_ROWS] = {};
+
+    void SetUp() override {
+        nvm_analog_matrix_erase();
+        analog_matrix_replay_reset(REST);
+        analog_matrix_init();
+    }
+
+    // Plays a travel trace on one key through the matrix scan and returns the scans on which the key changed state.
+    std::vector<KeyEvent> replay(uint8_t row, uint8_t col, const std::vector<uint8_t> &travel) {
+        std::vector<uint16_t> trace;
+        for (uint8_t t : travel) {
+            trace.push_back(at(t));
+        }
+        return replay_raw(row, col, trace);
+    }
+
+    std::vector<KeyEvent> replay_raw(uint8_t row, uint8_t col, const std::vector<uint16_t> &trace) {
+        std::vector<KeyEvent> events;
+        analog_matrix_replay_load(row, col, trace.data(), trace.size());
+        for (int scan = 0; analog_matrix_replay_is_running(); scan++) {
+            bool was_pressed = matrix[row] & (MATRIX_ROW_SHIFTER << col);
+            bool changed     = matrix_scan_custom(matrix);
+            bool pressed     = matrix[row] & (MATRIX_ROW_SHIFTER << col);
+            EXPECT_EQ(changed, was_pressed != pressed) << "scan " << scan;
+            if (was_pressed != pressed) {
+                events.push_back({scan, pressed});
+            }
+        }
+        return events;
+    }
+};
+
+TEST_F(AnalogMatrix, PressesAtActuationAndReleasesAtReleasePoint) {
+    auto events = replay(0, 1, {0, 100, 127, 128, 200, 255, 100, 97, 96, 0});
+
+    EXPECT_EQ(events, (std::vector<KeyEvent>{{3, true}, {8, false}}));
+    EXPECT_EQ(matrix[0], 0);
+    EXPECT_EQ(matrix[1], 0);
+}
+
+TEST_F(AnalogMatrix, RapidTriggerFollowsDirectionChanges) {
+    analog_matrix_set_actuation(128, 32, 16);
+
+    auto events = replay(1, 0, {0, 130, 200, 185, 184, 190, 200, 150, 40, 56, 20, 60, 127, 128});
+
+    EXPECT_EQ(events, (std::vector<KeyEvent>{
+                          {1, true},   // actuation point
+                          {4, false},  // 16 up from the deepest point, 200
+                          {6, true},   // 16 down from the shallowest point, 184
+                          {7, false},  //
+                          {9, true},   // re-triggered without returning to the actuation point
+                          {10, false}, // below the release point, which ends the rapid trigger run
+                          {13, true},  // back to the actuation point
+                      }));
+}
+
+TEST_F(AnalogMatrix, KeysAreIndependent) {
+    analog_matrix_set_actuation(128, 32, 16);
+    analog_matrix_replay_set(0, 0, at(255));
+    matrix_scan_custom(matrix);
+    ASSERT_EQ(matrix[0], 0b01);
+
+    auto events = replay(0, 1, {0, 200, 150});
+
+    EXPECT_EQ(events, (std::vector<KeyEvent>{{1, true}, {2, false}}));
+    EXPECT_EQ(matrix[0], 0b01);
+    EXPECT_EQ(analog_matrix_get_travel(0, 0), 255);
+}
+
+TEST_F(AnalogMatrix, ReadingsThatFallWhenPressed) {
+    analog_key_config_t config;
+    analog_matrix_get_key_config(0, 0, &config);
+    config.rest   = 3000;
+    config.bottom = 2000;
+    analog_matrix_set_key_config(0, 0, &config);
+
+    auto events = replay_raw(0, 0, {3000, 3100, 2600, 2400, 2000, 2700, 3000});
+
+    EXPECT_EQ(events, (std::vector<KeyEvent>{{3, true}, {5, false}}));
+    EXPECT_EQ(analog_matrix_get_travel(0, 0), 0);
+}
+
+TEST_F(AnalogMatrix, CalibrationIsLearnedAndPersisted) {
+    analog_matrix_replay_reset(1500);
+    analog_matrix_calibration_start();
+    ASSERT_TRUE(analog_matrix_calibration_is_active());
+
+    // Bottoming out a key during calibration produces no key events.
+    EXPECT_TRUE(replay_raw(0, 0, {1500, 1800, 2300, 2400, 2350, 1500}).empty());
+    EXPECT_TRUE(replay_raw(1, 1, {1500, 1550, 1500}).empty());
+    analog_matrix_calibration_stop();
+    EXPECT_FALSE(analog_matrix_calibration_is_active());
+
+    analog_key_config_t config;
+    analog_matrix_get_key_config(0, 0, &config);
+    EXPECT_EQ(config.rest, 1500);
+    EXPECT_EQ(config.bottom, 2400);
+    // Never pressed down, so it keeps the default travel range from its new rest.
+    analog_matrix_get_key_config(1, 1, &config);
+    EXPECT_EQ(config.rest, 1500);
+    EXPECT_EQ(config.bottom, 1500 + ANALOG_MATRIX_TRAVEL_RANGE);
+
+    ASSERT_TRUE(nvm_analog_matrix_is_valid());
+    analog_matrix_init();
+    analog_matrix_get_key_config(0, 0, &config);
+    EXPECT_EQ(config.bottom, 2400);
+
+    auto events = replay_raw(0, 0, {1500, 2000, 2400});
+    EXPECT_EQ(events, (std::vector<KeyEvent>{{1, true}}));
+    EXPECT_EQ(analog_matrix_get_travel(0, 0), 255);
+}
+
+TEST_F(AnalogMatrix, ResetDropsSavedSettings) {
+    analog_matrix_set_actuation(10, 5, 0);
+    ASSERT_TRUE(nvm_analog_matrix_is_valid());
+
+    analog_matrix_reset();
+
+    EXPECT_FALSE(nvm_analog_matrix_is_valid());
+    analog_key_config_t config;
+    analog_matrix_get_key_config(1, 0, &config);
+    EXPECT_EQ(config.actuation, ANALOG_MATRIX_ACTUATION_POINT);
+    EXPECT_EQ(config.release, ANALOG_MATRIX_RELEASE_POINT);
+}
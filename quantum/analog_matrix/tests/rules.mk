@@ -0,0 +1,9 @@
+analog_matrix_DEFS := -DANALOG_MATRIX_ENABLE -DMATRIX_ROWS=2 -DMATRIX_COLS=2 -DEEPROM_CUSTOM -DEEPROM_SIZE=128
+analog_matrix_INC := $(QUANTUM_PATH)/analog_matrix
+
+analog_matrix_SRC := \
+	$(QUANTUM_PATH)/analog_matrix/analog_matrix.c \
+	$(QUANTUM_PATH)/nvm/eeprom/nvm_analog_matrix.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/eeprom.c \
+	$(QUANTUM_PATH)/analog_matrix/tests/analog_matrix_replay.c \
+	$(QUANTUM_PATH)/analog_matrix/tests/analog_matrix_tests.cpp
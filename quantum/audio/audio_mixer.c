@@ -0,0 +1,224 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "audio_mixer.h"
+#include <string.h>
+#include "util.h"
+
+// Envelope levels carry 8 fractional bits below the Q15 gain applied to the wavetable, so that long ramps still
+// move on every sample.
+#define LEVEL_SHIFT 8
+#define LEVEL_FULL ((int32_t)1 << (15 + LEVEL_SHIFT))
+
+// Top bits of the phase accumulator index the wavetable.
+#define PHASE_SHIFT (32 - 8)
+// Half a turn per sample, the Nyquist frequency.
+#define MAX_INCREMENT (UINT32_MAX / 2)
+
+typedef struct {
+    uint32_t phase;
+    uint32_t increment; // phase step per sample
+    int32_t  level;     // envelope level, LEVEL_FULL at full volume
+    int32_t  step;      // level change per sample while ramping
+    uint32_t ramp;      // samples left until the envelope reaches its target
+    bool     sounding;
+} mixer_voice_t;
+
+static mixer_voice_t  voices[AUDIO_MIXER_VOICES];
+static int32_t        accumulator[AUDIO_MIXER_BLOCK_SIZE];
+static int32_t        level_sum[AUDIO_MIXER_BLOCK_SIZE]; // summed Q15 envelope levels of the voices
+static const int16_t *wavetable;
+static float          phase_per_hz;
+static uint32_t       attack_samples;
+static uint32_t       release_samples;
+static uint16_t       output_center;
+static uint16_t       output_amplitude;
+static uint16_t       output_rest;
+static int32_t        rest_step; // bias change per sample while gliding
+static int32_t        bias;      // LEVEL_FULL when the output is centered, 0 when it is at rest
+
+void audio_mixer_init(uint32_t sample_rate, const int16_t table[AUDIO_MIXER_WAVETABLE_LENGTH], uint16_t center, uint16_t amplitude) {
+    wavetable        = table;
+    phase_per_hz     = 4294967296.0f / sample_rate;
+    attack_samples   = (sample_rate * AUDIO_MIXER_ATTACK_MS) / 1000;
+    release_samples  = (sample_rate * AUDIO_MIXER_RELEASE_MS) / 1000;
+    output_center    = center;
+    output_amplitude = MIN(amplitude, INT16_MAX);
+    output_rest      = center;
+    rest_step        = LEVEL_FULL / MAX((sample_rate * AUDIO_MIXER_REST_MS) / 1000, (uint32_t)1);
+    bias             = LEVEL_FULL;
+    memset(voices, 0, sizeof(voices));
+}
+
+// Ramps the envelope to `target`, taking `duration` samples for a full-scale change.
+static void start_ramp(mixer_voice_t *voice, int32_t target, uint32_t duration) {
+    int32_t  distance = target - voice->level;
+    uint32_t ramp     = (duration * (uint32_t)((distance < 0 ? -distance : distance) >> LEVEL_SHIFT)) >> 15;
+
+    if (ramp == 0) {
+        voice->level    = target;
+        voice->ramp     = 0;
+        voice->sounding = target > 0;
+        return;
+    }
+    voice->step = distance / (int32_t)ramp;
+    voice->ramp = ramp;
+}
+
+void audio_mixer_voice_play(uint8_t index, float frequency) {
+    if (index >= AUDIO_MIXER_VOICES) {
+        return;
+    }
+
+    mixer_voice_t *voice     = &voices[index];
+    float          increment = frequency * phase_per_hz;
+    voice->increment         = increment >= MAX_INCREMENT ? MAX_INCREMENT : (uint32_t)increment;
+
+    if (!voice->sounding) {
+        voice->phase    = 0;
+        voice->level    = 0;
+        voice->ramp     = 0;
+        voice->sounding = true;
+    }
+    if (voice->level < LEVEL_FULL && (voice->ramp == 0 || voice->step < 0)) {
+        start_ramp(voice, LEVEL_FULL, attack_samples);
+    }
+}
+
+void audio_mixer_voice_release(uint8_t index) {
+    if (index >= AUDIO_MIXER_VOICES) {
+        return;
+    }
+
+    mixer_voice_t *voice = &voices[index];
+    if (voice->sounding && (voice->ramp == 0 || voice->step > 0)) {
+        start_ramp(voice, 0, release_samples);
+    }
+}
+
+void audio_mixer_release_all(void) {
+    for (uint8_t i = 0; i < AUDIO_MIXER_VOICES; i++) {
+        audio_mixer_voice_release(i);
+    }
+}
+
+static bool voices_sounding(void) {
+    for (uint8_t i = 0; i < AUDIO_MIXER_VOICES; i++) {
+        if (voices[i].sounding) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool audio_mixer_is_silent(void) {
+    return !voices_sounding() && (output_rest == output_center || bias == 0);
+}
+
+void audio_mixer_set_rest(uint16_t rest) {
+    output_rest = rest;
+    bias        = voices_sounding() ? LEVEL_FULL : 0;
+}
+
+// Adds `count` samples of one voice into the accumulator, and its envelope level into level_sum. The loops keep
+// the voice's state in locals, so the steady-state loop is a table lookup, a multiply and three adds per sample.
+// Returns true if the envelope moved.
+static bool render_voice(mixer_voice_t *voice, size_t count) {
+    uint32_t       phase     = voice->phase;
+    const uint32_t increment = voice->increment;
+    int32_t        level     = voice->level;
+    size_t         i         = 0;
+    const bool     ramping   = voice->ramp > 0;
+
+    if (ramping) {
+        const int32_t step = voice->step;
+        size_t        run  = MIN(count, voice->ramp);
+        for (; i < run; i++) {
+            level += step;
+            accumulator[i] += (wavetable[phase >> PHASE_SHIFT] * (level >> LEVEL_SHIFT)) >> 15;
+            level_sum[i] += level >> LEVEL_SHIFT;
+            phase += increment;
+        }
+        voice->ramp -= run;
+        if (voice->ramp == 0) {
+            level = step > 0 ? LEVEL_FULL : 0;
+            if (level == 0) {
+                voice->sounding = false;
+                i               = count;
+            }
+        }
+    }
+
+    const int32_t gain = level >> LEVEL_SHIFT;
+    for (; i < count; i++) {
+        accumulator[i] += (wavetable[phase >> PHASE_SHIFT] * gain) >> 15;
+        level_sum[i] += gain;
+        phase += increment;
+    }
+
+    voice->phase = phase;
+    voice->level = level;
+    return ramping;
+}
+
+// Output gain in Q15 for a summed envelope level. The mix is divided by the total level of the voices rather than
+// by how many are sounding, so the gain follows the envelopes smoothly as voices fade in and out. Below one
+// voice's full level the gain stays at full scale, so a lone voice still fades in and out.
+static inline int32_t output_gain(int32_t level) {
+    return ((int32_t)output_amplitude << 15) / MAX(level, (int32_t)1 << 15);
+}
+
+// Renders a block while the output glides between its rest level and the center. Both the offset from the rest
+// level and the voices are scaled by the bias, which moves towards its target on every sample.
+static void render_gliding(uint16_t *samples, size_t block, bool sounding) {
+    const int32_t distance = (int32_t)output_center - output_rest;
+
+    for (size_t i = 0; i < block; i++) {
+        bias = sounding ? MIN(bias + rest_step, LEVEL_FULL) : MAX(bias - rest_step, 0);
+
+        const int32_t scale = bias >> LEVEL_SHIFT;
+        int32_t       mix   = 0;
+        if (sounding) {
+            mix = (((accumulator[i] * output_gain(level_sum[i])) >> 15) * scale) >> 15;
+        }
+        samples[i] = output_rest + ((distance * scale) >> 15) + mix;
+    }
+}
+
+void audio_mixer_render(uint16_t *samples, size_t count) {
+    while (count > 0) {
+        size_t block    = MIN(count, AUDIO_MIXER_BLOCK_SIZE);
+        bool   sounding = false;
+        bool   ramping  = false;
+
+        memset(accumulator, 0, block * sizeof(accumulator[0]));
+        memset(level_sum, 0, block * sizeof(level_sum[0]));
+        for (uint8_t i = 0; i < AUDIO_MIXER_VOICES; i++) {
+            if (voices[i].sounding) {
+                sounding = true;
+                ramping |= render_voice(&voices[i], block);
+            }
+        }
+
+        if (output_rest != output_center && bias != (sounding ? LEVEL_FULL : 0)) {
+            render_gliding(samples, block, sounding);
+        } else if (!sounding) {
+            for (size_t i = 0; i < block; i++) {
+                samples[i] = output_rest;
+            }
+        } else if (ramping) {
+            // An envelope is moving, so the gain is worked out per sample.
+            for (size_t i = 0; i < block; i++) {
+                samples[i] = output_center + ((accumulator[i] * output_gain(level_sum[i])) >> 15);
+            }
+        } else {
+            const int32_t gain = output_gain(level_sum[0]);
+            for (size_t i = 0; i < block; i++) {
+                samples[i] = output_center + ((accumulator[i] * gain) >> 15);
+            }
+        }
+
+        samples += block;
+        count -= block;
+    }
+}
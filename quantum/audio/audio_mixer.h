@@ -0,0 +1,83 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * Fixed-point wavetable mixer for drivers that synthesise their output, such as the additive DAC driver.
+ *
+ * Each voice steps a 32 bit phase accumulator through a 256 entry wavetable, so a full turn of the accumulator is one
+ * period of the waveform. The step is worked out once when a voice is tuned, which leaves only integer adds, shifts
+ * and multiplies per sample. Voices fade in and out with linear attack and release ramps, so tones can start, stop or
+ * change at any point without clicks.
+ */
+
+#ifndef AUDIO_MIXER_VOICES
+#    define AUDIO_MIXER_VOICES 8
+#endif
+
+// Envelope times, in milliseconds.
+#ifndef AUDIO_MIXER_ATTACK_MS
+#    define AUDIO_MIXER_ATTACK_MS 2
+#endif
+#ifndef AUDIO_MIXER_RELEASE_MS
+#    define AUDIO_MIXER_RELEASE_MS 4
+#endif
+// Time taken to glide between the rest level and the center, see audio_mixer_set_rest().
+#ifndef AUDIO_MIXER_REST_MS
+#    define AUDIO_MIXER_REST_MS 10
+#endif
+
+// Number of samples rendered per pass over the voices; sets the size of the static accumulator.
+#ifndef AUDIO_MIXER_BLOCK_SIZE
+#    define AUDIO_MIXER_BLOCK_SIZE 32
+#endif
+
+#define AUDIO_MIXER_WAVETABLE_LENGTH 256
+
+/**
+ * \brief Sets up the mixer and silences every voice.
+ *
+ * \param sample_rate rate at which samples are rendered, in Hz
+ * \param wavetable one period of the waveform, as signed 16 bit samples; not copied
+ * \param center output value when silent
+ * \param amplitude largest distance from `center` the output can reach
+ */
+void audio_mixer_init(uint32_t sample_rate, const int16_t wavetable[AUDIO_MIXER_WAVETABLE_LENGTH], uint16_t center, uint16_t amplitude);
+
+/**
+ * \brief Sets the output value while no voice is sounding, for outputs that idle away from `center`.
+ *
+ * The output then glides from `rest` to `center` as the first voice starts, and back once the last one has faded out,
+ * instead of stepping between them. The voices are scaled down along with the distance covered, so the output never
+ * goes past `rest`. Defaults to `center`.
+ */
+void audio_mixer_set_rest(uint16_t rest);
+
+/**
+ * \brief Plays `frequency` on a voice, fading it in if it was silent. A sounding voice changes pitch without
+ * restarting its waveform.
+ */
+void audio_mixer_voice_play(uint8_t voice, float frequency);
+/**
+ * \brief Fades a voice out.
+ */
+void audio_mixer_voice_release(uint8_t voice);
+void audio_mixer_release_all(void);
+
+/**
+ * \brief Returns true once every voice has faded out and the output is back at its rest value.
+ */
+bool audio_mixer_is_silent(void);
+
+/**
+ * \brief Renders the next `count` samples of the mix.
+ *
+ * The mix is scaled by the summed envelope levels of the voices, so the output stays within `center` +/- `amplitude`
+ * whatever the polyphony, and the level of one voice changes smoothly as others fade in and out.
+ */
+void audio_mixer_render(uint16_t *samples, size_t count);
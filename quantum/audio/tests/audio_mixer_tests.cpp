@@ -0,0 +1,220 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "audio_mixer.h"
+}
+
+static const uint32_t SAMPLE_RATE = 16384;
+static const uint16_t CENTER      = 2048;
+static const uint16_t AMPLITUDE   = 2047;
+
+static int16_t sine[AUDIO_MIXER_WAVETABLE_LENGTH];
+
+// Power of one frequency in a block of samples, relative to the signal's mean.
+static double goertzel(const std::vector<uint16_t> &samples, double frequency) {
+    double coefficient = 2.0 * std::cos(2.0 * M_PI * frequency / SAMPLE_RATE);
+    double s1 = 0, s2 = 0;
+    for (uint16_t sample : samples) {
+        double s0 = (sample - (double)CENTER) + coefficient * s1 - s2;
+        s2        = s1;
+        s1        = s0;
+    }
+    return (s1 * s1 + s2 * s2 - coefficient * s1 * s2) / samples.size();
+}
+
+class AudioMixer : public testing::Test {
+   protected:
+    void SetUp() override {
+        for (size_t i = 0; i < AUDIO_MIXER_WAVETABLE_LENGTH; i++) {
+            sine[i] = std::lround(32767.0 * std::sin(2.0 * M_PI * i / AUDIO_MIXER_WAVETABLE_LENGTH));
+        }
+        audio_mixer_init(SAMPLE_RATE, sine, CENTER, AMPLITUDE);
+    }
+
+    std::vector<uint16_t> render(size_t count) {
+        std::vector<uint16_t> samples(count);
+        audio_mixer_render(samples.data(), count);
+        return samples;
+    }
+
+    // Skips past the attack ramp, so that the following samples are at full level.
+    void settle() {
+        render(SAMPLE_RATE * AUDIO_MIXER_ATTACK_MS / 1000 + 1);
+    }
+};
+
+TEST_F(AudioMixer, SilentUntilAVoicePlays) {
+    EXPECT_TRUE(audio_mixer_is_silent());
+    for (uint16_t sample : render(100)) {
+        EXPECT_EQ(sample, CENTER);
+    }
+}
+
+TEST_F(AudioMixer, SingleVoiceIsAPureTone) {
+    audio_mixer_voice_play(0, 512.0f);
+    settle();
+    auto samples = render(4096);
+
+    double tone = goertzel(samples, 512);
+    EXPECT_GT(tone, 1000 * goertzel(samples, 256));
+    EXPECT_GT(tone, 1000 * goertzel(samples, 1024));
+    EXPECT_GT(tone, 1000 * goertzel(samples, 1536));
+    EXPECT_GT(tone, 1000 * goertzel(samples, 3000));
+
+    auto [low, high] = std::minmax_element(samples.begin(), samples.end());
+    EXPECT_NEAR(*low, CENTER - AMPLITUDE, 4);
+    EXPECT_NEAR(*high, CENTER + AMPLITUDE, 4);
+}
+
+TEST_F(AudioMixer, PitchIsAccurate) {
+    audio_mixer_voice_play(0, 440.0f);
+    settle();
+    auto samples = render(SAMPLE_RATE);
+
+    int crossings = 0;
+    for (size_t i = 1; i < samples.size(); i++) {
+        crossings += samples[i - 1] < CENTER && samples[i] >= CENTER;
+    }
+    EXPECT_NEAR(crossings, 440, 1);
+}
+
+TEST_F(AudioMixer, VoicesAreMixedAtEqualLevels) {
+    audio_mixer_voice_play(0, 512.0f);
+    audio_mixer_voice_play(1, 1536.0f);
+    audio_mixer_voice_play(2, 2048.0f);
+    settle();
+    auto samples = render(4096);
+
+    double first = goertzel(samples, 512), second = goertzel(samples, 1536), third = goertzel(samples, 2048);
+    EXPECT_NEAR(second / first, 1.0, 0.01);
+    EXPECT_NEAR(third / first, 1.0, 0.01);
+    EXPECT_GT(first, 1000 * goertzel(samples, 1024));
+    for (uint16_t sample : samples) {
+        EXPECT_LE(std::abs(sample - CENTER), AMPLITUDE);
+    }
+}
+
+TEST_F(AudioMixer, EnvelopeFadesInAndOut) {
+    const size_t attack  = SAMPLE_RATE * AUDIO_MIXER_ATTACK_MS / 1000;
+    const size_t release = SAMPLE_RATE * AUDIO_MIXER_RELEASE_MS / 1000;
+
+    audio_mixer_voice_play(0, 1024.0f);
+    auto fade_in = render(attack);
+    // Each period of the tone is 16 samples; its peak grows with the envelope.
+    int previous_peak = 0;
+    for (size_t period = 0; period < attack / 16; period++) {
+        int peak = 0;
+        for (size_t i = period * 16; i < (period + 1) * 16; i++) {
+            peak = std::max(peak, std::abs(fade_in[i] - CENTER));
+        }
+        EXPECT_GE(peak, previous_peak);
+        previous_peak = peak;
+    }
+    EXPECT_LT(std::abs(fade_in[0] - CENTER), AMPLITUDE / 16);
+
+    audio_mixer_voice_release(0);
+    EXPECT_FALSE(audio_mixer_is_silent());
+    auto fade_out = render(release + 1);
+    EXPECT_TRUE(audio_mixer_is_silent());
+    EXPECT_EQ(fade_out.back(), CENTER);
+    EXPECT_LT(std::abs(fade_out[release - 2] - CENTER), AMPLITUDE / 16);
+}
+
+TEST_F(AudioMixer, RetuningKeepsTheWaveformContinuous) {
+    audio_mixer_voice_play(0, 500.0f);
+    settle();
+    auto before = render(37);
+    audio_mixer_voice_play(0, 700.0f);
+    auto after = render(64);
+
+    // The largest step between samples of a full-scale 700Hz sine.
+    double max_step = AMPLITUDE * 2.0 * M_PI * 700 / SAMPLE_RATE + 2;
+    EXPECT_LE(std::abs(after[0] - before.back()), max_step);
+    for (size_t i = 1; i < after.size(); i++) {
+        EXPECT_LE(std::abs(after[i] - after[i - 1]), max_step);
+    }
+}
+
+TEST_F(AudioMixer, OtherVoicesStartingAndStoppingDoNotStepTheLevel) {
+    audio_mixer_voice_play(0, 64.0f);
+    settle();
+    // Wait for the peak of the slow tone, where a change of gain would show the most.
+    std::vector<uint16_t> samples;
+    do {
+        samples.push_back(render(1)[0]);
+    } while (samples.back() < CENTER + AMPLITUDE * 9 / 10);
+
+    audio_mixer_voice_play(1, 96.0f);
+    auto joined = render(SAMPLE_RATE * AUDIO_MIXER_ATTACK_MS / 1000 + 64);
+    samples.insert(samples.end(), joined.begin(), joined.end());
+    audio_mixer_voice_release(1);
+    auto left = render(SAMPLE_RATE * AUDIO_MIXER_RELEASE_MS / 1000 + 64);
+    samples.insert(samples.end(), left.begin(), left.end());
+
+    // Dividing by the number of voices jumps by about half the amplitude; the steepest either tone alone can
+    // move is a few dozen steps per sample.
+    for (size_t i = 1; i < samples.size(); i++) {
+        EXPECT_LE(std::abs(samples[i] - samples[i - 1]), AMPLITUDE / 16) << "at sample " << i;
+    }
+    for (uint16_t sample : samples) {
+        EXPECT_LE(std::abs(sample - CENTER), AMPLITUDE);
+    }
+}
+
+TEST_F(AudioMixer, ReplayingAReleasingVoiceFadesBackIn) {
+    audio_mixer_voice_play(0, 512.0f);
+    settle();
+    audio_mixer_voice_release(0);
+    render(10);
+    audio_mixer_voice_play(0, 512.0f);
+    settle();
+    render(SAMPLE_RATE * AUDIO_MIXER_RELEASE_MS / 1000);
+
+    EXPECT_FALSE(audio_mixer_is_silent());
+    auto samples = render(64);
+    auto [low, high] = std::minmax_element(samples.begin(), samples.end());
+    EXPECT_NEAR(*high - *low, 2 * AMPLITUDE, 8);
+}
+
+TEST_F(AudioMixer, OutOfRangeVoicesAreIgnored) {
+    audio_mixer_voice_play(AUDIO_MIXER_VOICES, 512.0f);
+    audio_mixer_voice_release(AUDIO_MIXER_VOICES);
+    EXPECT_TRUE(audio_mixer_is_silent());
+}
+
+TEST_F(AudioMixer, GlidesBetweenAnOffCenterRestAndTheCenter) {
+    const size_t glide = SAMPLE_RATE * AUDIO_MIXER_REST_MS / 1000;
+    audio_mixer_set_rest(0);
+
+    for (uint16_t sample : render(64)) {
+        EXPECT_EQ(sample, 0);
+    }
+
+    audio_mixer_voice_play(0, 64.0f);
+    auto samples = render(glide + SAMPLE_RATE / 64);
+    auto [low, high] = std::minmax_element(samples.end() - SAMPLE_RATE / 64, samples.end());
+    EXPECT_NEAR(*low, CENTER - AMPLITUDE, 8);
+    EXPECT_NEAR(*high, CENTER + AMPLITUDE, 8);
+
+    audio_mixer_voice_release(0);
+    auto fade_out = render(SAMPLE_RATE * AUDIO_MIXER_RELEASE_MS / 1000 + 1);
+    EXPECT_FALSE(audio_mixer_is_silent());
+    samples.insert(samples.end(), fade_out.begin(), fade_out.end());
+    auto glide_out = render(glide + 1);
+    EXPECT_TRUE(audio_mixer_is_silent());
+    samples.insert(samples.end(), glide_out.begin(), glide_out.end());
+    EXPECT_EQ(samples.back(), 0);
+
+    // Stepping from the rest value to the center would jump by half the output range at once.
+    double max_step = AMPLITUDE * 2.0 * M_PI * 64 / SAMPLE_RATE + (double)CENTER / glide + 2;
+    EXPECT_LE(samples[0], max_step);
+    for (size_t i = 1; i < samples.size(); i++) {
+        EXPECT_LE(std::abs(samples[i] - samples[i - 1]), max_step) << "at sample " << i;
+    }
+}
@@ -0,0 +1,137 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "boot_trace.h"
+#include "atomic_util.h"
+#include "timer.h"
+#include "print.h"
+#include "progmem.h"
+#include "compiler_support.h"
+
+static boot_trace_entry_t boot_trace_log[BOOT_TRACE_STAGE_COUNT];
+static uint8_t            boot_trace_length;
+static uint32_t           boot_trace_seen;    // bitmask of recorded stages
+static uint32_t           boot_trace_pending; // bitmask of stages reached before keyboard_init() started the timer
+
+STATIC_ASSERT(BOOT_TRACE_STAGE_COUNT <= 32, "Too many boot trace stages for the seen mask");
+
+static void boot_trace_append(uint8_t stage, uint32_t time_us) {
+    boot_trace_seen |= 1UL << stage;
+    boot_trace_log[boot_trace_length++] = (boot_trace_entry_t){.stage = stage, .time_us = time_us};
+}
+
+void boot_trace_mark(boot_trace_stage_t stage) {
+    // USB milestones may be reported from interrupt context
+    ATOMIC_BLOCK_RESTORESTATE {
+        if (stage < BOOT_TRACE_STAGE_COUNT && !((boot_trace_seen | boot_trace_pending) & (1UL << stage))) {
+            if (stage != BOOT_TRACE_KEYBOARD_INIT && !(boot_trace_seen & (1UL << BOOT_TRACE_KEYBOARD_INIT))) {
+                // The protocol layer starts before keyboard_init() has started the timer, so these can't be timed yet
+                boot_trace_pending |= 1UL << stage;
+            } else {
+                uint32_t now = timer_read_us32();
+                if (stage == BOOT_TRACE_KEYBOARD_INIT) {
+                    for (uint8_t i = 0; i < BOOT_TRACE_STAGE_COUNT; i++) {
+                        if (boot_trace_pending & (1UL << i)) {
+                            boot_trace_append(i, now);
+                        }
+                    }
+                    boot_trace_pending = 0;
+                }
+                boot_trace_append(stage, now);
+            }
+        }
+    }
+}
+
+void boot_trace_reset(void) {
+    ATOMIC_BLOCK_RESTORESTATE {
+        boot_trace_length  = 0;
+        boot_trace_seen    = 0;
+        boot_trace_pending = 0;
+    }
+}
+
+uint8_t boot_trace_count(void) {
+    return boot_trace_length;
+}
+
+bool boot_trace_get(uint8_t index, boot_trace_entry_t *entry) {
+    if (index >= boot_trace_length) {
+        return false;
+    }
+    ATOMIC_BLOCK_RESTORESTATE {
+        *entry = boot_trace_log[index];
+    }
+    return true;
+}
+
+#ifndef NO_PRINT
+static const char *boot_trace_stage_name(uint8_t stage) {
+    switch (stage) {
+        case BOOT_TRACE_USB_INIT:
+            return PSTR("usb init");
+        case BOOT_TRACE_KEYBOARD_INIT:
+            return PSTR("keyboard_init");
+        case BOOT_TRACE_VIA:
+            return PSTR("via");
+        case BOOT_TRACE_SPLIT_PRE:
+            return PSTR("split pre init");
+        case BOOT_TRACE_ENCODER:
+            return PSTR("encoder");
+        case BOOT_TRACE_MATRIX:
+            return PSTR("matrix");
+        case BOOT_TRACE_QUANTUM:
+            return PSTR("quantum");
+        case BOOT_TRACE_CONNECTION:
+            return PSTR("connection");
+        case BOOT_TRACE_HOST:
+            return PSTR("host");
+        case BOOT_TRACE_AUDIO:
+            return PSTR("audio");
+        case BOOT_TRACE_LED_MATRIX:
+            return PSTR("led matrix");
+        case BOOT_TRACE_RGB_MATRIX:
+            return PSTR("rgb matrix");
+        case BOOT_TRACE_DISPLAY:
+            return PSTR("display");
+        case BOOT_TRACE_BACKLIGHT:
+            return PSTR("backlight");
+        case BOOT_TRACE_RGBLIGHT:
+            return PSTR("rgblight");
+        case BOOT_TRACE_SPLIT_POST:
+            return PSTR("split post init");
+        case BOOT_TRACE_POINTING:
+            return PSTR("pointing device");
+        case BOOT_TRACE_HAPTIC:
+            return PSTR("haptic");
+        case BOOT_TRACE_POST_INIT:
+            return PSTR("post init");
+        case BOOT_TRACE_USB_RESET:
+            return PSTR("usb reset");
+        case BOOT_TRACE_USB_CONFIGURED:
+            return PSTR("usb configured");
+        case BOOT_TRACE_FIRST_REPORT:
+            return PSTR("first report");
+        default:
+            return PSTR("?");
+    }
+}
+
+#endif // NO_PRINT
+
+void boot_trace_print(void) {
+#ifndef NO_PRINT
+    uprintf("boot trace: %u stages\n", boot_trace_count());
+
+    boot_trace_entry_t entry;
+    uint32_t           previous = 0;
+    for (uint8_t i = 0; boot_trace_get(i, &entry); i++) {
+#    if defined(__AVR__)
+        uprintf("%10lu us  +%8lu us  %S\n", entry.time_us, entry.time_us - previous, boot_trace_stage_name(entry.stage));
+#    else
+        uprintf("%10lu us  +%8lu us  %s\n", entry.time_us, entry.time_us - previous, boot_trace_stage_name(entry.stage));
+#    endif
+        previous = entry.time_us;
+    }
+#endif // NO_PRINT
+}
@@ -0,0 +1,76 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Boot stages in the order keyboard_init() normally completes them. Each is recorded once, when it first happens.
+ * Stages reached before keyboard_init() has started the timer are recorded along with BOOT_TRACE_KEYBOARD_INIT. */
+typedef enum {
+    BOOT_TRACE_USB_INIT,      // USB device state initialised by the protocol layer
+    BOOT_TRACE_KEYBOARD_INIT, // keyboard_init() entered, timer running
+    BOOT_TRACE_VIA,
+    BOOT_TRACE_SPLIT_PRE,
+    BOOT_TRACE_ENCODER,
+    BOOT_TRACE_MATRIX,
+    BOOT_TRACE_QUANTUM, // eeconfig loaded, bootmagic done
+    BOOT_TRACE_CONNECTION,
+    BOOT_TRACE_HOST,
+    BOOT_TRACE_AUDIO,
+    BOOT_TRACE_LED_MATRIX,
+    BOOT_TRACE_RGB_MATRIX,
+    BOOT_TRACE_DISPLAY, // OLED or ST7565
+    BOOT_TRACE_BACKLIGHT,
+    BOOT_TRACE_RGBLIGHT,
+    BOOT_TRACE_SPLIT_POST,
+    BOOT_TRACE_POINTING,
+    BOOT_TRACE_HAPTIC,
+    BOOT_TRACE_POST_INIT, // keyboard_post_init_*() returned, keyboard_init() done
+    BOOT_TRACE_USB_RESET,
+    BOOT_TRACE_USB_CONFIGURED,
+    BOOT_TRACE_FIRST_REPORT,
+    BOOT_TRACE_STAGE_COUNT,
+} boot_trace_stage_t;
+
+typedef struct {
+    uint8_t  stage;
+    uint32_t time_us; // timer_read_us32() when the stage completed, or keyboard_init() started
+} boot_trace_entry_t;
+
+#ifdef BOOT_TRACE_ENABLE
+
+// Records the time `stage` completed, unless it was already recorded
+#    define BOOT_TRACE(stage) boot_trace_mark(BOOT_TRACE_##stage)
+
+#else
+
+#    define BOOT_TRACE(stage)
+
+#endif
+
+// Don't call directly, use the macro instead
+void boot_trace_mark(boot_trace_stage_t stage);
+
+/**
+ * @brief Forgets all recorded entries, so every stage can be recorded again.
+ */
+void boot_trace_reset(void);
+
+/**
+ * @brief Number of entries recorded so far.
+ */
+uint8_t boot_trace_count(void);
+
+/**
+ * @brief Copies the `index`th recorded entry, in the order they were recorded, into `entry`.
+ *
+ * @return false if there is no such entry
+ */
+bool boot_trace_get(uint8_t index, boot_trace_entry_t *entry);
+
+/**
+ * @brief Prints the recorded entries to the console, with the time spent in each stage.
+ */
+void boot_trace_print(void);
@@ -18,19 +18,32 @@
 #    define DEBOUNCE UINT8_MAX
 #endif
 
-#if DEBOUNCE > 0
+// DEBOUNCE_US sets a settle time in microseconds instead, measured on the microsecond timebase
+#ifdef DEBOUNCE_US
+typedef uint32_t debounce_timer_t;
+#    define debounce_timer_read() timer_read_us32()
+#    define debounce_timer_elapsed(last) timer_elapsed_us32(last)
+#    define DEBOUNCE_TIME DEBOUNCE_US
+#else
+typedef fast_timer_t debounce_timer_t;
+#    define debounce_timer_read() timer_read_fast()
+#    define debounce_timer_elapsed(last) timer_elapsed_fast(last)
+#    define DEBOUNCE_TIME DEBOUNCE
+#endif
+
+#if DEBOUNCE_TIME > 0
 
 void debounce_init(void) {}
 
 bool debounce(matrix_row_t raw[], matrix_row_t cooked[], bool changed) {
-    static fast_timer_t debouncing_time;
-    static bool         debouncing     = false;
-    bool                cooked_changed = false;
+    static debounce_timer_t debouncing_time;
+    static bool             debouncing     = false;
+    bool                    cooked_changed = false;
 
     if (changed) {
         debouncing      = true;
-        debouncing_time = timer_read_fast();
-    } else if (debouncing && timer_elapsed_fast(debouncing_time) >= DEBOUNCE) {
+        debouncing_time = debounce_timer_read();
+    } else if (debouncing && debounce_timer_elapsed(debouncing_time) >= DEBOUNCE_TIME) {
         size_t matrix_size = MATRIX_ROWS_PER_HAND * sizeof(matrix_row_t);
         if (memcmp(cooked, raw, matrix_size) != 0) {
             memcpy(cooked, raw, matrix_size);
@@ -29,6 +29,11 @@ debounce_sym_defer_g_SRC := $(DEBOUNCE_COMMON_SRC) \
 	$(QUANTUM_PATH)/debounce/sym_defer_g.c \
 	$(QUANTUM_PATH)/debounce/tests/sym_defer_g_tests.cpp
 
+debounce_sym_defer_g_us_DEFS := $(DEBOUNCE_COMMON_DEFS) -DDEBOUNCE_US=1500
+debounce_sym_defer_g_us_SRC := $(DEBOUNCE_COMMON_SRC) \
+	$(QUANTUM_PATH)/debounce/sym_defer_g.c \
+	$(QUANTUM_PATH)/debounce/tests/sym_defer_g_us_tests.cpp
+
 debounce_sym_defer_pk_DEFS := $(DEBOUNCE_COMMON_DEFS)
 debounce_sym_defer_pk_SRC := $(DEBOUNCE_COMMON_SRC) \
 	$(QUANTUM_PATH)/debounce/sym_defer_pk.c \
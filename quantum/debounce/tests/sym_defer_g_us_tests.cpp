@@ -0,0 +1,46 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+#include "debounce_test_common.h"
+
+/* DEBOUNCE_US is 1500, the test timer advances in whole milliseconds */
+
+TEST_F(DebounceTest, OneKeyShort) {
+    addEvents({
+        /* Time, Inputs, Outputs */
+        {0, {{0, 1, DOWN}}, {}},
+
+        {2, {}, {{0, 1, DOWN}}},
+        /* 0ms delay (fast scan rate) */
+        {2, {{0, 1, UP}}, {}},
+
+        {4, {}, {{0, 1, UP}}},
+    });
+    runEvents();
+}
+
+TEST_F(DebounceTest, OneKeyBouncing) {
+    addEvents({
+        /* Time, Inputs, Outputs */
+        {0, {{0, 1, DOWN}}, {}},
+        {1, {{0, 1, UP}}, {}},
+        {2, {{0, 1, DOWN}}, {}},
+
+        /* Settle time restarts on every change */
+        {4, {}, {{0, 1, DOWN}}},
+    });
+    runEvents();
+}
+
+TEST_F(DebounceTest, TwoKeysShort) {
+    addEvents({
+        /* Time, Inputs, Outputs */
+        {0, {{0, 1, DOWN}}, {}},
+        {1, {{3, 8, DOWN}}, {}},
+
+        {3, {}, {{0, 1, DOWN}, {3, 8, DOWN}}},
+    });
+    runEvents();
+}
@@ -9,27 +9,29 @@
 #    define MAX_DEFERRED_EXECUTORS 8
 #endif
 
+#if MAX_DEFERRED_EXECUTORS > 254
+#    error "MAX_DEFERRED_EXECUTORS cannot exceed 254, as deferred tokens are 8-bit and unique within a table"
+#endif
+
 //------------------------------------
 // Helpers
 //
+// Each executor table is kept as a binary min-heap ordered by trigger time: the in-use entries are packed at the start
+// of the table and table[0] is always the next one due. Checking for due executors is therefore O(1), and inserting,
+// rescheduling or removing an entry is O(log n).
 
 static deferred_token current_token = 0;
 
-static inline bool token_can_be_used(deferred_executor_t *table, size_t table_count, deferred_token token) {
-    if (token == INVALID_DEFERRED_TOKEN) {
-        return false;
+static deferred_token allocate_token(deferred_executor_t *table, size_t count) {
+    // Tokens only have to be unique within their own table, so mark the ones it uses in a single pass rather than
+    // rescanning the table for every candidate
+    uint8_t used_tokens[256 / 8] = {0};
+    for (size_t i = 0; i < count; ++i) {
+        used_tokens[table[i].token / 8] |= (1 << (table[i].token % 8));
     }
-    for (int i = 0; i < table_count; ++i) {
-        if (table[i].token == token) {
-            return false;
-        }
-    }
-    return true;
-}
 
-static inline deferred_token allocate_token(deferred_executor_t *table, size_t table_count) {
     deferred_token first = ++current_token;
-    while (!token_can_be_used(table, table_count, current_token)) {
+    while (current_token == INVALID_DEFERRED_TOKEN || (used_tokens[current_token / 8] & (1 << (current_token % 8)))) {
         ++current_token;
         if (current_token == first) {
             // If we've looped back around to the first, everything is already allocated (yikes!). Need to exit with a failure.
@@ -39,6 +41,92 @@ static inline deferred_token allocate_token(deferred_executor_t *table, size_t t
     return current_token;
 }
 
+static inline bool triggers_before(const deferred_executor_t *a, const deferred_executor_t *b) {
+    return ((int32_t)TIMER_DIFF_32(a->trigger_time, b->trigger_time)) < 0;
+}
+
+static inline void swap_entries(deferred_executor_t *table, size_t a, size_t b) {
+    deferred_executor_t tmp = table[a];
+    table[a]                = table[b];
+    table[b]                = tmp;
+}
+
+static size_t active_count(deferred_executor_t *table, size_t table_count) {
+    // In-use entries are contiguous from the start of the table, so binary search for the first free one
+    size_t lo = 0, hi = table_count;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (table[mid].token != INVALID_DEFERRED_TOKEN) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+static inline size_t find_token(deferred_executor_t *table, size_t count, deferred_token token) {
+    if (count > 0 && table[0].token == token) {
+        return 0;
+    }
+    for (size_t i = 1; i < count; ++i) {
+        if (table[i].token == token) {
+            return i;
+        }
+    }
+    return count;
+}
+
+static void sift_up(deferred_executor_t *table, size_t index) {
+    while (index > 0) {
+        size_t parent = (index - 1) / 2;
+        if (!triggers_before(&table[index], &table[parent])) {
+            break;
+        }
+        swap_entries(table, index, parent);
+        index = parent;
+    }
+}
+
+static void sift_down(deferred_executor_t *table, size_t count, size_t index) {
+    while (true) {
+        size_t left     = 2 * index + 1;
+        size_t right    = left + 1;
+        size_t earliest = index;
+        if (left < count && triggers_before(&table[left], &table[earliest])) {
+            earliest = left;
+        }
+        if (right < count && triggers_before(&table[right], &table[earliest])) {
+            earliest = right;
+        }
+        if (earliest == index) {
+            break;
+        }
+        swap_entries(table, index, earliest);
+        index = earliest;
+    }
+}
+
+static inline void reschedule(deferred_executor_t *table, size_t count, size_t index) {
+    sift_up(table, index);
+    sift_down(table, count, index);
+}
+
+static void remove_entry(deferred_executor_t *table, size_t count, size_t index) {
+    // Move the last entry into the hole, then restore the heap order around it
+    size_t last = count - 1;
+    if (index != last) {
+        table[index] = table[last];
+    }
+    table[last].token        = INVALID_DEFERRED_TOKEN;
+    table[last].trigger_time = 0;
+    table[last].callback     = NULL;
+    table[last].cb_arg       = NULL;
+    if (index != last) {
+        reschedule(table, last, index);
+    }
+}
+
 //------------------------------------
 // Advanced API: used when a custom-allocated table is used, primarily for core code.
 //
@@ -49,27 +137,27 @@ deferred_token defer_exec_advanced(deferred_executor_t *table, size_t table_coun
         return INVALID_DEFERRED_TOKEN;
     }
 
-    // Find an unused slot and claim it
-    for (int i = 0; i < table_count; ++i) {
-        deferred_executor_t *entry = &table[i];
-        if (entry->token == INVALID_DEFERRED_TOKEN) {
-            // Work out the new token value, dropping out if none were available
-            deferred_token token = allocate_token(table, table_count);
-            if (token == INVALID_DEFERRED_TOKEN) {
-                return false;
-            }
+    // Claim the slot after the last in-use entry
+    size_t count = active_count(table, table_count);
+    if (count == table_count) {
+        // None available
+        return INVALID_DEFERRED_TOKEN;
+    }
 
-            // Set up the executor table entry
-            entry->token        = current_token;
-            entry->trigger_time = timer_read32() + delay_ms;
-            entry->callback     = callback;
-            entry->cb_arg       = cb_arg;
-            return current_token;
-        }
+    // Work out the new token value, dropping out if none were available
+    deferred_token token = allocate_token(table, count);
+    if (token == INVALID_DEFERRED_TOKEN) {
+        return INVALID_DEFERRED_TOKEN;
     }
 
-    // None available
-    return INVALID_DEFERRED_TOKEN;
+    // Set up the executor table entry
+    deferred_executor_t *entry = &table[count];
+    entry->token               = token;
+    entry->trigger_time        = timer_read32() + delay_ms;
+    entry->callback            = callback;
+    entry->cb_arg              = cb_arg;
+    sift_up(table, count);
+    return token;
 }
 
 bool extend_deferred_exec_advanced(deferred_executor_t *table, size_t table_count, deferred_token token, uint32_t delay_ms) {
@@ -79,17 +167,17 @@ bool extend_deferred_exec_advanced(deferred_executor_t *table, size_t table_coun
     }
 
     // Find the entry corresponding to the token
-    for (int i = 0; i < table_count; ++i) {
-        deferred_executor_t *entry = &table[i];
-        if (entry->token == token) {
-            // Found it, extend the delay
-            entry->trigger_time = timer_read32() + delay_ms;
-            return true;
-        }
+    size_t count = active_count(table, table_count);
+    size_t index = find_token(table, count, token);
+    if (index == count) {
+        // Not found
+        return false;
     }
 
-    // Not found
-    return false;
+    // Found it, extend the delay
+    table[index].trigger_time = timer_read32() + delay_ms;
+    reschedule(table, count, index);
+    return true;
 }
 
 bool cancel_deferred_exec_advanced(deferred_executor_t *table, size_t table_count, deferred_token token) {
@@ -99,20 +187,16 @@ bool cancel_deferred_exec_advanced(deferred_executor_t *table, size_t table_coun
     }
 
     // Find the entry corresponding to the token
-    for (int i = 0; i < table_count; ++i) {
-        deferred_executor_t *entry = &table[i];
-        if (entry->token == token) {
-            // Found it, cancel and clear the table entry
-            entry->token        = INVALID_DEFERRED_TOKEN;
-            entry->trigger_time = 0;
-            entry->callback     = NULL;
-            entry->cb_arg       = NULL;
-            return true;
-        }
+    size_t count = active_count(table, table_count);
+    size_t index = find_token(table, count, token);
+    if (index == count) {
+        // Not found
+        return false;
     }
 
-    // Not found
-    return false;
+    // Found it, cancel and clear the table entry
+    remove_entry(table, count, index);
+    return true;
 }
 
 void deferred_exec_advanced_task(deferred_executor_t *table, size_t table_count, uint32_t *last_execution_time) {
@@ -122,40 +206,52 @@ void deferred_exec_advanced_task(deferred_executor_t *table, size_t table_count,
     if (((int32_t)TIMER_DIFF_32(now, (*last_execution_time))) > 0) {
         *last_execution_time = now;
 
-        // Run through each of the executors
-        for (int i = 0; i < table_count; ++i) {
-            deferred_executor_t *entry      = &table[i];
-            deferred_token       curr_token = entry->token;
-
-            // Check if we're supposed to execute this entry
-            if (curr_token != INVALID_DEFERRED_TOKEN && ((int32_t)TIMER_DIFF_32(entry->trigger_time, now)) <= 0) {
-                // Invoke the callback and work work out if we should be requeued
-                uint32_t delay_ms = entry->callback(entry->trigger_time, entry->cb_arg);
-
-                // If the token has changed, then the callback has canceled and re-queued. Skip further processing.
-                if (entry->token != curr_token) {
-                    continue;
-                }
-
-                // Update the trigger time if we have to repeat, otherwise clear it out
-                if (delay_ms > 0) {
-                    // Intentionally add just the delay to the existing trigger time -- this ensures the next
-                    // invocation is with respect to the previous trigger, rather than when it got to execution. Under
-                    // normal circumstances this won't cause issue, but if another executor is invoked that takes a
-                    // considerable length of time, then this ensures best-effort timing between invocations.
-                    entry->trigger_time += delay_ms;
-                } else {
-                    // If it was zero, then the callback is cancelling repeated execution. Free up the slot.
-                    entry->token        = INVALID_DEFERRED_TOKEN;
-                    entry->trigger_time = 0;
-                    entry->callback     = NULL;
-                    entry->cb_arg       = NULL;
-                }
+        // Run through the due executors in trigger order. Executors that are still due after being repeated are run
+        // again, but the number of invocations per tick is capped at the number of executors, as before.
+        size_t count     = active_count(table, table_count);
+        size_t remaining = count;
+        while (remaining-- > 0 && count > 0 && ((int32_t)TIMER_DIFF_32(table[0].trigger_time, now)) <= 0) {
+            deferred_token curr_token   = table[0].token;
+            uint32_t       trigger_time = table[0].trigger_time;
+
+            // Invoke the callback and work work out if we should be requeued
+            uint32_t delay_ms = table[0].callback(trigger_time, table[0].cb_arg);
+
+            // The callback may have queued, extended or cancelled executors, so find the entry again. If it's gone,
+            // then the callback has canceled (and possibly re-queued). Skip further processing.
+            count        = active_count(table, table_count);
+            size_t index = find_token(table, count, curr_token);
+            if (index == count) {
+                continue;
+            }
+
+            // Update the trigger time if we have to repeat, otherwise clear it out
+            if (delay_ms > 0) {
+                // Intentionally add just the delay to the existing trigger time -- this ensures the next
+                // invocation is with respect to the previous trigger, rather than when it got to execution. Under
+                // normal circumstances this won't cause issue, but if another executor is invoked that takes a
+                // considerable length of time, then this ensures best-effort timing between invocations.
+                table[index].trigger_time += delay_ms;
+                reschedule(table, count, index);
+            } else {
+                // If it was zero, then the callback is cancelling repeated execution. Free up the slot.
+                remove_entry(table, count, index);
+                --count;
             }
         }
     }
 }
 
+bool deferred_exec_advanced_next_deadline(deferred_executor_t *table, size_t table_count, uint32_t *trigger_time) {
+    if (!table || table_count == 0 || table[0].token == INVALID_DEFERRED_TOKEN) {
+        return false;
+    }
+    if (trigger_time) {
+        *trigger_time = table[0].trigger_time;
+    }
+    return true;
+}
+
 //------------------------------------
 // Basic API: used by user-mode code, guaranteed to not collide with core deferred execution
 //
@@ -172,6 +268,9 @@ bool extend_deferred_exec(deferred_token token, uint32_t delay_ms) {
 bool cancel_deferred_exec(deferred_token token) {
     return cancel_deferred_exec_advanced(basic_executors, MAX_DEFERRED_EXECUTORS, token);
 }
+bool deferred_exec_next_deadline(uint32_t *trigger_time) {
+    return deferred_exec_advanced_next_deadline(basic_executors, MAX_DEFERRED_EXECUTORS, trigger_time);
+}
 void deferred_exec_task(void) {
     deferred_exec_advanced_task(basic_executors, MAX_DEFERRED_EXECUTORS, &last_deferred_exec_check);
 }
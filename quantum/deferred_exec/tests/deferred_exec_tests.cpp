@@ -0,0 +1,186 @@
+// Copyright 2025 QMK Contributors
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+#include <vector>
+
+extern "C" {
+#include "deferred_exec.h"
+#include "timer.h"
+
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+}
+
+struct callback_record {
+    uint32_t trigger_time;
+    uint32_t id;
+};
+
+static std::vector<callback_record> invocations;
+
+static uint32_t record_callback(uint32_t trigger_time, void *cb_arg) {
+    invocations.push_back({trigger_time, (uint32_t)(uintptr_t)cb_arg});
+    return 0;
+}
+
+static uint32_t repeat_callback(uint32_t trigger_time, void *cb_arg) {
+    invocations.push_back({trigger_time, (uint32_t)(uintptr_t)cb_arg});
+    return 10;
+}
+
+class DeferredExec : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        // The task throttle remembers the last execution time, so time only ever moves forward between tests
+        jump_to(timer_read32() + 1000);
+        start = timer_read32();
+        invocations.clear();
+    }
+
+    void TearDown() override {
+        for (deferred_token token : tokens) {
+            cancel_deferred_exec(token);
+        }
+        EXPECT_FALSE(deferred_exec_next_deadline(NULL));
+    }
+
+    deferred_token defer(uint32_t delay_ms, deferred_exec_callback callback, uint32_t id) {
+        deferred_token token = defer_exec(delay_ms, callback, (void *)(uintptr_t)id);
+        tokens.push_back(token);
+        return token;
+    }
+
+    void run_for(uint32_t ms) {
+        for (uint32_t i = 0; i < ms; ++i) {
+            advance_time(1);
+            deferred_exec_task();
+        }
+    }
+
+    void jump_to(uint32_t t) {
+        while (TIMER_DIFF_32(t, timer_read32()) > (UINT32_C(1) << 30)) {
+            advance_time(UINT32_C(1) << 30);
+            deferred_exec_task();
+        }
+        set_time(t);
+        deferred_exec_task();
+    }
+
+    uint32_t                    start;
+    std::vector<deferred_token> tokens;
+};
+
+TEST_F(DeferredExec, RejectsInvalidRequests) {
+    EXPECT_EQ(defer_exec(0, record_callback, NULL), INVALID_DEFERRED_TOKEN);
+    EXPECT_EQ(defer_exec(10, NULL, NULL), INVALID_DEFERRED_TOKEN);
+    EXPECT_FALSE(cancel_deferred_exec(INVALID_DEFERRED_TOKEN));
+    EXPECT_FALSE(extend_deferred_exec(INVALID_DEFERRED_TOKEN, 10));
+    EXPECT_FALSE(deferred_exec_next_deadline(NULL));
+}
+
+TEST_F(DeferredExec, RunsCallbacksInTriggerOrder) {
+    defer(30, record_callback, 3);
+    defer(10, record_callback, 1);
+    defer(20, record_callback, 2);
+
+    uint32_t next = 0;
+    EXPECT_TRUE(deferred_exec_next_deadline(&next));
+    EXPECT_EQ(next, start + 10);
+
+    run_for(30);
+    ASSERT_EQ(invocations.size(), 3u);
+    EXPECT_EQ(invocations[0].id, 1u);
+    EXPECT_EQ(invocations[0].trigger_time, start + 10);
+    EXPECT_EQ(invocations[1].id, 2u);
+    EXPECT_EQ(invocations[2].id, 3u);
+    EXPECT_FALSE(deferred_exec_next_deadline(NULL));
+}
+
+TEST_F(DeferredExec, RepeatsRelativeToPreviousTrigger) {
+    deferred_token token = defer(5, repeat_callback, 7);
+    run_for(25);
+    ASSERT_EQ(invocations.size(), 3u);
+    EXPECT_EQ(invocations[0].trigger_time, start + 5);
+    EXPECT_EQ(invocations[1].trigger_time, start + 15);
+    EXPECT_EQ(invocations[2].trigger_time, start + 25);
+
+    uint32_t next = 0;
+    EXPECT_TRUE(deferred_exec_next_deadline(&next));
+    EXPECT_EQ(next, start + 35);
+    EXPECT_TRUE(cancel_deferred_exec(token));
+}
+
+TEST_F(DeferredExec, ExtendReordersPendingCallbacks) {
+    deferred_token first = defer(10, record_callback, 1);
+    defer(20, record_callback, 2);
+
+    EXPECT_TRUE(extend_deferred_exec(first, 50));
+    uint32_t next = 0;
+    EXPECT_TRUE(deferred_exec_next_deadline(&next));
+    EXPECT_EQ(next, start + 20);
+
+    run_for(50);
+    ASSERT_EQ(invocations.size(), 2u);
+    EXPECT_EQ(invocations[0].id, 2u);
+    EXPECT_EQ(invocations[1].id, 1u);
+}
+
+TEST_F(DeferredExec, CancelledCallbacksDoNotRun) {
+    defer(10, record_callback, 1);
+    deferred_token second = defer(20, record_callback, 2);
+    defer(30, record_callback, 3);
+
+    EXPECT_TRUE(cancel_deferred_exec(second));
+    EXPECT_FALSE(cancel_deferred_exec(second));
+
+    run_for(30);
+    ASSERT_EQ(invocations.size(), 2u);
+    EXPECT_EQ(invocations[0].id, 1u);
+    EXPECT_EQ(invocations[1].id, 3u);
+}
+
+TEST_F(DeferredExec, HandlesTimerWraparound) {
+    jump_to(UINT32_MAX - 5);
+    defer(20, record_callback, 2);
+    defer(3, record_callback, 1);
+
+    run_for(20);
+    ASSERT_EQ(invocations.size(), 2u);
+    EXPECT_EQ(invocations[0].id, 1u);
+    EXPECT_EQ(invocations[1].id, 2u);
+}
+
+TEST_F(DeferredExec, SchedulesUpToTheConfiguredLimit) {
+    // Queue in reverse order so every insertion has to move to the front
+    for (uint32_t i = 0; i < MAX_DEFERRED_EXECUTORS; ++i) {
+        EXPECT_NE(defer(1000 - i, record_callback, 1000 - i), INVALID_DEFERRED_TOKEN);
+    }
+    EXPECT_EQ(defer_exec(5, record_callback, NULL), INVALID_DEFERRED_TOKEN);
+
+    // Cancel every third one
+    for (size_t i = 0; i < tokens.size(); i += 3) {
+        EXPECT_TRUE(cancel_deferred_exec(tokens[i]));
+    }
+
+    run_for(1000);
+    ASSERT_EQ(invocations.size(), MAX_DEFERRED_EXECUTORS - (MAX_DEFERRED_EXECUTORS + 2) / 3);
+    for (size_t i = 1; i < invocations.size(); ++i) {
+        EXPECT_LT(invocations[i - 1].trigger_time, invocations[i].trigger_time);
+    }
+}
+
+TEST_F(DeferredExec, TokensAreScopedToTheirTable) {
+    // A full table does not use up the tokens of another one
+    static deferred_executor_t other[MAX_DEFERRED_EXECUTORS] = {};
+    for (uint32_t i = 0; i < MAX_DEFERRED_EXECUTORS; ++i) {
+        EXPECT_NE(defer(1000, record_callback, i), INVALID_DEFERRED_TOKEN);
+        EXPECT_NE(defer_exec_advanced(other, MAX_DEFERRED_EXECUTORS, 1000, record_callback, NULL), INVALID_DEFERRED_TOKEN);
+    }
+
+    for (size_t i = 0; i < MAX_DEFERRED_EXECUTORS; ++i) {
+        EXPECT_TRUE(cancel_deferred_exec_advanced(other, MAX_DEFERRED_EXECUTORS, other[0].token));
+    }
+    EXPECT_FALSE(deferred_exec_advanced_next_deadline(other, MAX_DEFERRED_EXECUTORS, NULL));
+}
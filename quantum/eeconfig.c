@@ -39,6 +39,10 @@
 #    include "connection.h"
 #endif // CONNECTION_ENABLE
 
+#ifdef ANALOG_MATRIX_ENABLE
+#    include "analog_matrix.h"
+#endif // ANALOG_MATRIX_ENABLE
+
 #ifdef VIA_ENABLE
 bool via_eeprom_is_valid(void);
 void via_eeprom_set_valid(bool valid);
@@ -140,6 +144,10 @@ void eeconfig_init_quantum(void) {
     eeconfig_update_connection_default();
 #endif // CONNECTION_ENABLE
 
+#ifdef ANALOG_MATRIX_ENABLE
+    analog_matrix_reset();
+#endif // ANALOG_MATRIX_ENABLE
+
 #if (EECONFIG_KB_DATA_SIZE) > 0
     eeconfig_init_kb_datablock();
 #endif // (EECONFIG_KB_DATA_SIZE) > 0
@@ -4,8 +4,13 @@
 #include <string.h>
 #include "action.h"
 #include "encoder.h"
+#include "timer.h"
 #include "wait.h"
 
+#if defined(ENCODER_MAP_ENABLE) && defined(ENCODER_MAP_COALESCE_SCROLL) && defined(POINTING_DEVICE_ENABLE)
+#    include "pointing_device.h"
+#endif
+
 #ifndef ENCODER_MAP_KEY_DELAY
 #    define ENCODER_MAP_KEY_DELAY TAP_CODE_DELAY
 #endif
@@ -17,8 +22,31 @@ __attribute__((weak)) bool should_process_encoder(void) {
 static encoder_events_t encoder_events;
 static bool             signal_queue_drain = false;
 
+#ifdef ENCODER_ACCELERATION_ENABLE
+static const encoder_acceleration_point_t encoder_acceleration_curve[] = ENCODER_ACCELERATION_CURVE;
+
+static uint16_t encoder_last_detent[NUM_ENCODERS];
+static uint16_t encoder_detent_interval[NUM_ENCODERS]; // 0 until the encoder first moves
+static bool     encoder_last_clockwise[NUM_ENCODERS];
+#endif // ENCODER_ACCELERATION_ENABLE
+
+#if defined(ENCODER_MAP_ENABLE) && defined(ENCODER_MAP_COALESCE_SCROLL) && defined(POINTING_DEVICE_ENABLE)
+// Wheel movement that didn't fit into the last mouse report yet
+static int32_t encoder_scroll_v;
+static int32_t encoder_scroll_h;
+// Set when the current detent was added to the wheel movement instead of being tapped
+static bool encoder_scroll_detent;
+#endif // defined(ENCODER_MAP_ENABLE) && defined(ENCODER_MAP_COALESCE_SCROLL) && defined(POINTING_DEVICE_ENABLE)
+
 void encoder_init(void) {
     memset(&encoder_events, 0, sizeof(encoder_events));
+#ifdef ENCODER_ACCELERATION_ENABLE
+    memset(encoder_detent_interval, 0, sizeof(encoder_detent_interval));
+#endif // ENCODER_ACCELERATION_ENABLE
+#if defined(ENCODER_MAP_ENABLE) && defined(ENCODER_MAP_COALESCE_SCROLL) && defined(POINTING_DEVICE_ENABLE)
+    encoder_scroll_v = 0;
+    encoder_scroll_h = 0;
+#endif // defined(ENCODER_MAP_ENABLE) && defined(ENCODER_MAP_COALESCE_SCROLL) && defined(POINTING_DEVICE_ENABLE)
     encoder_driver_init();
 }
 
@@ -27,32 +55,143 @@ static void encoder_queue_drain(void) {
     encoder_events.dequeued = encoder_events.enqueued;
 }
 
+#ifdef ENCODER_ACCELERATION_ENABLE
+__attribute__((weak)) uint8_t get_encoder_acceleration(uint8_t index, uint16_t interval) {
+    for (uint8_t i = 0; i < ARRAY_SIZE(encoder_acceleration_curve); i++) {
+        if (interval <= encoder_acceleration_curve[i].interval) {
+            return encoder_acceleration_curve[i].multiplier;
+        }
+    }
+    return 1;
+}
+
+uint16_t encoder_get_velocity(uint8_t index) {
+    if (index >= NUM_ENCODERS || encoder_detent_interval[index] == 0 || timer_elapsed(encoder_last_detent[index]) >= ENCODER_ACCELERATION_TIMEOUT) {
+        return 0;
+    }
+    return 1000 / encoder_detent_interval[index];
+}
+
+static uint16_t encoder_accelerate(uint8_t index, bool clockwise, uint8_t count) {
+    uint16_t now     = timer_read();
+    uint16_t elapsed = TIMER_DIFF_16(now, encoder_last_detent[index]);
+    bool     moving  = encoder_detent_interval[index] != 0 && elapsed < ENCODER_ACCELERATION_TIMEOUT && encoder_last_clockwise[index] == clockwise;
+
+    encoder_last_detent[index]    = now;
+    encoder_last_clockwise[index] = clockwise;
+
+    // Starting to turn or changing direction is never accelerated
+    if (!moving) {
+        encoder_detent_interval[index] = ENCODER_ACCELERATION_TIMEOUT;
+        return count;
+    }
+
+    // Detents that were coalesced share the time since the previous batch. Batches split up by the queue
+    // arrive together, so they keep the current pace.
+    if (elapsed > 0) {
+        encoder_detent_interval[index] = MAX(elapsed / count, 1);
+    }
+    return (uint16_t)count * get_encoder_acceleration(index, encoder_detent_interval[index]);
+}
+#endif // ENCODER_ACCELERATION_ENABLE
+
+#if defined(ENCODER_MAP_ENABLE) && defined(ENCODER_MAP_COALESCE_SCROLL) && defined(POINTING_DEVICE_ENABLE)
+bool encoder_map_scroll(uint16_t keycode, bool pressed) {
+    // Only the press of a detent moves the wheel, the release is swallowed along with it
+    int32_t delta = pressed ? 1 : 0;
+#    ifdef POINTING_DEVICE_HIRES_SCROLL_ENABLE
+    delta *= pointing_device_get_hires_scroll_resolution();
+#    endif
+
+    switch (keycode) {
+        case QK_MOUSE_WHEEL_UP:
+            encoder_scroll_v += delta;
+            break;
+        case QK_MOUSE_WHEEL_DOWN:
+            encoder_scroll_v -= delta;
+            break;
+        case QK_MOUSE_WHEEL_LEFT:
+            encoder_scroll_h -= delta;
+            break;
+        case QK_MOUSE_WHEEL_RIGHT:
+            encoder_scroll_h += delta;
+            break;
+        default:
+            return false;
+    }
+    encoder_scroll_detent = true;
+    return true;
+}
+
+static mouse_hv_report_t encoder_scroll_take(int32_t *pending) {
+    mouse_hv_report_t value = *pending > MOUSE_REPORT_HV_MAX ? MOUSE_REPORT_HV_MAX : (*pending < MOUSE_REPORT_HV_MIN ? MOUSE_REPORT_HV_MIN : *pending);
+    *pending -= value;
+    return value;
+}
+
+report_mouse_t encoder_map_scroll_report(report_mouse_t mouse_report) {
+    // Anything that doesn't fit next to the pointing device's own movement is carried into the next report
+    encoder_scroll_v += mouse_report.v;
+    encoder_scroll_h += mouse_report.h;
+
+    mouse_report.v = encoder_scroll_take(&encoder_scroll_v);
+    mouse_report.h = encoder_scroll_take(&encoder_scroll_h);
+    return mouse_report;
+}
+#endif // defined(ENCODER_MAP_ENABLE) && defined(ENCODER_MAP_COALESCE_SCROLL) && defined(POINTING_DEVICE_ENABLE)
+
+#if defined(ENCODER_MAP_ENABLE) && ENCODER_MAP_KEY_DELAY > 0
+static void encoder_map_key_delay(void) {
+#    if defined(ENCODER_MAP_COALESCE_SCROLL) && defined(POINTING_DEVICE_ENABLE)
+    // A coalesced wheel detent doesn't send a report of its own to space out
+    if (encoder_scroll_detent) {
+        return;
+    }
+#    endif // defined(ENCODER_MAP_COALESCE_SCROLL) && defined(POINTING_DEVICE_ENABLE)
+    wait_ms(ENCODER_MAP_KEY_DELAY);
+}
+#endif // defined(ENCODER_MAP_ENABLE) && ENCODER_MAP_KEY_DELAY > 0
+
 static bool encoder_handle_queue(void) {
     bool    changed = false;
     uint8_t index;
     bool    clockwise;
-    while (encoder_dequeue_event(&index, &clockwise)) {
+    uint8_t count;
+    while (encoder_dequeue_delta_advanced(&encoder_events, &index, &clockwise, &count)) {
+#ifdef ENCODER_ACCELERATION_ENABLE
+        uint16_t steps = encoder_accelerate(index, clockwise, count);
+#else
+        uint16_t steps = count;
+#endif // ENCODER_ACCELERATION_ENABLE
+
 #ifdef ENCODER_MAP_ENABLE
 
-        // The delays below cater for Windows and its wonderful requirements.
-        action_exec(clockwise ? MAKE_ENCODER_CW_EVENT(index, true) : MAKE_ENCODER_CCW_EVENT(index, true));
+        for (uint16_t i = 0; i < steps; i++) {
+#    if defined(ENCODER_MAP_COALESCE_SCROLL) && defined(POINTING_DEVICE_ENABLE)
+            encoder_scroll_detent = false;
+#    endif // defined(ENCODER_MAP_COALESCE_SCROLL) && defined(POINTING_DEVICE_ENABLE)
+
+            // The delays below cater for Windows and its wonderful requirements.
+            action_exec(clockwise ? MAKE_ENCODER_CW_EVENT(index, true) : MAKE_ENCODER_CCW_EVENT(index, true));
 #    if ENCODER_MAP_KEY_DELAY > 0
-        wait_ms(ENCODER_MAP_KEY_DELAY);
+            encoder_map_key_delay();
 #    endif // ENCODER_MAP_KEY_DELAY > 0
 
-        action_exec(clockwise ? MAKE_ENCODER_CW_EVENT(index, false) : MAKE_ENCODER_CCW_EVENT(index, false));
+            action_exec(clockwise ? MAKE_ENCODER_CW_EVENT(index, false) : MAKE_ENCODER_CCW_EVENT(index, false));
 #    if ENCODER_MAP_KEY_DELAY > 0
-        wait_ms(ENCODER_MAP_KEY_DELAY);
+            encoder_map_key_delay();
 #    endif // ENCODER_MAP_KEY_DELAY > 0
+        }
 
 #else // ENCODER_MAP_ENABLE
 
-        encoder_update_kb(index, clockwise);
+        encoder_update_delta_kb(index, clockwise ? (int16_t)steps : -(int16_t)steps);
 
 #endif // ENCODER_MAP_ENABLE
 
         changed = true;
     }
+
     return changed;
 }
 
@@ -98,24 +237,57 @@ bool encoder_queue_empty(void) {
     return encoder_queue_empty_advanced(&encoder_events);
 }
 
-bool encoder_queue_event_advanced(encoder_events_t *events, uint8_t index, bool clockwise) {
+bool encoder_queue_delta_advanced(encoder_events_t *events, uint8_t index, bool clockwise, uint8_t count) {
+#ifdef ENCODER_COALESCE_DETENTS
+    // Fold into the newest event if it's for the same encoder turning the same way, so fast turns don't overflow the queue
+    if (!encoder_queue_empty_advanced(events)) {
+        encoder_event_t *last = &events->queue[(events->head + MAX_QUEUED_ENCODER_EVENTS - 1) % MAX_QUEUED_ENCODER_EVENTS];
+        if (last->index == index && last->clockwise == (clockwise ? 1 : 0)) {
+            uint8_t added = MIN(count, UINT8_MAX - last->count);
+            last->count += added;
+            events->enqueued += added;
+            count -= added;
+        }
+    }
+
+    if (count == 0) {
+        return true;
+    }
+
     // Drop out if we're full
     if (encoder_queue_full_advanced(events)) {
         return false;
     }
 
     // Append the event
-    encoder_event_t new_event   = {.index = index, .clockwise = clockwise ? 1 : 0};
+    encoder_event_t new_event   = {.index = index, .clockwise = clockwise ? 1 : 0, .count = count};
     events->queue[events->head] = new_event;
 
     // Increment the head index
     events->head = (events->head + 1) % MAX_QUEUED_ENCODER_EVENTS;
-    events->enqueued++;
+    events->enqueued += count;
+#else
+    // Every detent takes up an event of its own
+    for (; count > 0; count--) {
+        // Drop out if we're full
+        if (encoder_queue_full_advanced(events)) {
+            return false;
+        }
+
+        // Append the event
+        encoder_event_t new_event   = {.index = index, .clockwise = clockwise ? 1 : 0};
+        events->queue[events->head] = new_event;
+
+        // Increment the head index
+        events->head = (events->head + 1) % MAX_QUEUED_ENCODER_EVENTS;
+        events->enqueued++;
+    }
+#endif // ENCODER_COALESCE_DETENTS
 
     return true;
 }
 
-bool encoder_dequeue_event_advanced(encoder_events_t *events, uint8_t *index, bool *clockwise) {
+bool encoder_dequeue_delta_advanced(encoder_events_t *events, uint8_t *index, bool *clockwise, uint8_t *count) {
     if (encoder_queue_empty_advanced(events)) {
         return false;
     }
@@ -124,9 +296,40 @@ bool encoder_dequeue_event_advanced(encoder_events_t *events, uint8_t *index, bo
     encoder_event_t event = events->queue[events->tail];
     *index                = event.index;
     *clockwise            = event.clockwise;
+#ifdef ENCODER_COALESCE_DETENTS
+    *count = event.count;
+#else
+    *count = 1;
+#endif // ENCODER_COALESCE_DETENTS
 
     // Increment the tail index
     events->tail = (events->tail + 1) % MAX_QUEUED_ENCODER_EVENTS;
+    events->dequeued += *count;
+
+    return true;
+}
+
+bool encoder_queue_event_advanced(encoder_events_t *events, uint8_t index, bool clockwise) {
+    return encoder_queue_delta_advanced(events, index, clockwise, 1);
+}
+
+bool encoder_dequeue_event_advanced(encoder_events_t *events, uint8_t *index, bool *clockwise) {
+    if (encoder_queue_empty_advanced(events)) {
+        return false;
+    }
+
+    // Retrieve a single detent of the oldest event
+    encoder_event_t *event = &events->queue[events->tail];
+    *index                 = event->index;
+    *clockwise             = event->clockwise;
+
+    // Increment the tail index once the event is used up
+#ifdef ENCODER_COALESCE_DETENTS
+    if (--event->count == 0)
+#endif // ENCODER_COALESCE_DETENTS
+    {
+        events->tail = (events->tail + 1) % MAX_QUEUED_ENCODER_EVENTS;
+    }
     events->dequeued++;
 
     return true;
@@ -140,6 +343,10 @@ bool encoder_dequeue_event(uint8_t *index, bool *clockwise) {
     return encoder_dequeue_event_advanced(&encoder_events, index, clockwise);
 }
 
+bool encoder_queue_delta(uint8_t index, bool clockwise, uint8_t count) {
+    return encoder_queue_delta_advanced(&encoder_events, index, clockwise, count);
+}
+
 void encoder_retrieve_events(encoder_events_t *events) {
     memcpy(events, &encoder_events, sizeof(encoder_events));
 }
@@ -152,6 +359,22 @@ __attribute__((weak)) bool encoder_update_user(uint8_t index, bool clockwise) {
     return true;
 }
 
+__attribute__((weak)) bool encoder_update_delta_user(uint8_t index, int16_t delta) {
+    return true;
+}
+
+__attribute__((weak)) bool encoder_update_delta_kb(uint8_t index, int16_t delta) {
+    if (!encoder_update_delta_user(index, delta)) {
+        return false;
+    }
+    bool     clockwise = delta > 0;
+    uint16_t steps     = clockwise ? delta : -delta;
+    for (uint16_t i = 0; i < steps; i++) {
+        encoder_update_kb(index, clockwise);
+    }
+    return true;
+}
+
 __attribute__((weak)) bool encoder_update_kb(uint8_t index, bool clockwise) {
     bool res = encoder_update_user(index, clockwise);
 #if !defined(ENCODER_TESTS)
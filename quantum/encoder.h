@@ -49,6 +49,10 @@ bool encoder_dequeue_event(uint8_t *index, bool *clockwise);
 bool encoder_update_kb(uint8_t index, bool clockwise);
 bool encoder_update_user(uint8_t index, bool clockwise);
 
+// Called once per batch of detents turned in the same direction, delta is positive when turning clockwise
+bool encoder_update_delta_kb(uint8_t index, int16_t delta);
+bool encoder_update_delta_user(uint8_t index, int16_t delta);
+
 #    ifdef SPLIT_KEYBOARD
 
 #        if defined(ENCODER_A_PINS_RIGHT)
@@ -89,6 +93,11 @@ bool encoder_update_user(uint8_t index, bool clockwise);
 typedef struct encoder_event_t {
     uint8_t index : 7;
     uint8_t clockwise : 1;
+#    ifdef ENCODER_COALESCE_DETENTS
+    // Consecutive detents of the same encoder in the same direction are coalesced into a single event.
+    // This changes the layout synced between split halves, so both need to be built with it.
+    uint8_t count;
+#    endif // ENCODER_COALESCE_DETENTS
 } encoder_event_t;
 
 typedef struct encoder_events_t {
@@ -105,16 +114,48 @@ void encoder_retrieve_events(encoder_events_t *events);
 // Encoder event queue management
 bool encoder_queue_event_advanced(encoder_events_t *events, uint8_t index, bool clockwise);
 bool encoder_dequeue_event_advanced(encoder_events_t *events, uint8_t *index, bool *clockwise);
+bool encoder_queue_delta_advanced(encoder_events_t *events, uint8_t index, bool clockwise, uint8_t count);
+bool encoder_dequeue_delta_advanced(encoder_events_t *events, uint8_t *index, bool *clockwise, uint8_t *count);
+bool encoder_queue_delta(uint8_t index, bool clockwise, uint8_t count);
 
 // Reset the queue to be empty
 void encoder_signal_queue_drain(void);
 
+#    ifdef ENCODER_ACCELERATION_ENABLE
+#        ifndef ENCODER_ACCELERATION_TIMEOUT
+#            define ENCODER_ACCELERATION_TIMEOUT 200
+#        endif // ENCODER_ACCELERATION_TIMEOUT
+#        ifndef ENCODER_ACCELERATION_CURVE
+// {milliseconds per detent, multiplier} pairs, fastest first
+#            define ENCODER_ACCELERATION_CURVE {{8, 4}, {20, 3}, {40, 2}}
+#        endif // ENCODER_ACCELERATION_CURVE
+
+typedef struct encoder_acceleration_point_t {
+    uint16_t interval;
+    uint8_t  multiplier;
+} encoder_acceleration_point_t;
+
+// Number of steps to generate per detent, given the time between the last detents
+uint8_t get_encoder_acceleration(uint8_t index, uint16_t interval);
+
+// Detents per second the encoder is currently turning at, or 0 if it is idle
+uint16_t encoder_get_velocity(uint8_t index);
+#    endif // ENCODER_ACCELERATION_ENABLE
+
 #    ifdef ENCODER_MAP_ENABLE
 #        define NUM_DIRECTIONS 2
 #        define ENCODER_CCW_CW(ccw, cw) {(cw), (ccw)}
 extern const uint16_t encoder_map[][NUM_ENCODERS][NUM_DIRECTIONS];
 #    endif // ENCODER_MAP_ENABLE
 
+#    if defined(ENCODER_MAP_ENABLE) && defined(ENCODER_MAP_COALESCE_SCROLL) && defined(POINTING_DEVICE_ENABLE)
+#        include "report.h"
+// Adds a wheel keycode's detent to the next pointing device report, returns false for other keycodes
+bool encoder_map_scroll(uint16_t keycode, bool pressed);
+// Adds the wheel movement turned on the encoder map since the last pointing device report
+report_mouse_t encoder_map_scroll_report(report_mouse_t mouse_report);
+#    endif // defined(ENCODER_MAP_ENABLE) && defined(ENCODER_MAP_COALESCE_SCROLL) && defined(POINTING_DEVICE_ENABLE)
+
 // "Custom encoder lite" support
 void encoder_driver_init(void);
 void encoder_driver_task(void);
@@ -0,0 +1,26 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+#include "config_encoder_common.h"
+
+#define MATRIX_ROWS 1
+#define MATRIX_COLS 1
+
+/* Here, "pins" from 0 to 31 are allowed. */
+#define ENCODER_A_PINS {0, 2}
+#define ENCODER_B_PINS {1, 3}
+
+#define ENCODER_COALESCE_DETENTS
+#define ENCODER_ACCELERATION_ENABLE
+#define ENCODER_ACCELERATION_TIMEOUT 200
+#define ENCODER_ACCELERATION_CURVE {{8, 4}, {20, 3}, {40, 2}}
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "mock.h"
+
+#ifdef __cplusplus
+};
+#endif
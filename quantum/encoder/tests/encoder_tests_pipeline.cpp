@@ -0,0 +1,166 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include <vector>
+
+extern "C" {
+#include "encoder.h"
+#include "encoder/tests/mock.h"
+
+void encoder_quadrature_handle_read(uint8_t index, uint8_t pin_a_state, uint8_t pin_b_state);
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+}
+
+struct delta_update {
+    uint8_t index;
+    int16_t delta;
+
+    bool operator==(const delta_update &other) const {
+        return index == other.index && delta == other.delta;
+    }
+};
+
+std::ostream &operator<<(std::ostream &os, const delta_update &update) {
+    return os << "{" << +update.index << ", " << update.delta << "}";
+}
+
+std::vector<delta_update> delta_updates;
+int                       steps = 0;
+
+bool encoder_update_delta_user(uint8_t index, int16_t delta) {
+    delta_updates.push_back({index, delta});
+    return true;
+}
+
+bool encoder_update_kb(uint8_t index, bool clockwise) {
+    steps += clockwise ? 1 : -1;
+    return true;
+}
+
+// Feeds the quadrature states of whole detents straight to the driver, as a pin change interrupt would.
+void turn(uint8_t index, bool clockwise, int detents) {
+    static const uint8_t cw[4][2]  = {{0, 1}, {0, 0}, {1, 0}, {1, 1}};
+    static const uint8_t ccw[4][2] = {{1, 0}, {0, 0}, {0, 1}, {1, 1}};
+    for (int i = 0; i < detents; i++) {
+        for (auto &state : clockwise ? cw : ccw) {
+            encoder_quadrature_handle_read(index, state[0], state[1]);
+        }
+    }
+}
+
+class EncoderPipelineTest : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        set_time(0);
+        delta_updates.clear();
+        steps = 0;
+        encoder_init();
+    }
+};
+
+TEST_F(EncoderPipelineTest, FastSpinIsNotLost) {
+    turn(0, true, 20);
+    encoder_task();
+
+    EXPECT_THAT(delta_updates, testing::ElementsAre(delta_update{0, 20}));
+    EXPECT_EQ(steps, 20);
+}
+
+TEST_F(EncoderPipelineTest, SpinBeyondOneEventIsNotLost) {
+    turn(0, false, 300);
+    encoder_task();
+
+    EXPECT_THAT(delta_updates, testing::ElementsAre(delta_update{0, -255}, delta_update{0, -45}));
+    EXPECT_EQ(steps, -300);
+}
+
+TEST_F(EncoderPipelineTest, InterleavedEncodersKeepOrder) {
+    turn(0, true, 2);
+    turn(1, false, 3);
+    turn(0, true, 1);
+    encoder_task();
+
+    EXPECT_THAT(delta_updates, testing::ElementsAre(delta_update{0, 2}, delta_update{1, -3}, delta_update{0, 1}));
+}
+
+TEST_F(EncoderPipelineTest, SingleStepDequeueStillWorks) {
+    uint8_t index;
+    bool    clockwise;
+
+    turn(1, true, 3);
+    for (int i = 0; i < 3; i++) {
+        ASSERT_TRUE(encoder_dequeue_event(&index, &clockwise));
+        EXPECT_EQ(index, 1);
+        EXPECT_TRUE(clockwise);
+    }
+    EXPECT_FALSE(encoder_dequeue_event(&index, &clockwise));
+}
+
+TEST_F(EncoderPipelineTest, AccelerationFollowsCurve) {
+    turn(0, true, 1);
+    encoder_task();
+    for (uint16_t interval : {100, 30, 15, 5}) {
+        advance_time(interval);
+        turn(0, true, 1);
+        encoder_task();
+    }
+
+    EXPECT_THAT(delta_updates, testing::ElementsAre(delta_update{0, 1}, delta_update{0, 1}, delta_update{0, 2}, delta_update{0, 3}, delta_update{0, 4}));
+    EXPECT_EQ(steps, 11);
+}
+
+TEST_F(EncoderPipelineTest, CoalescedDetentsShareInterval) {
+    turn(0, true, 1);
+    encoder_task();
+    advance_time(20);
+    turn(0, true, 4);
+    encoder_task();
+
+    // 5ms per detent
+    EXPECT_THAT(delta_updates, testing::ElementsAre(delta_update{0, 1}, delta_update{0, 16}));
+}
+
+TEST_F(EncoderPipelineTest, ReversingResetsAcceleration) {
+    turn(0, true, 1);
+    encoder_task();
+    advance_time(5);
+    turn(0, true, 1);
+    encoder_task();
+    advance_time(5);
+    turn(0, false, 1);
+    encoder_task();
+
+    EXPECT_THAT(delta_updates, testing::ElementsAre(delta_update{0, 1}, delta_update{0, 4}, delta_update{0, -1}));
+}
+
+TEST_F(EncoderPipelineTest, IdleResetsAcceleration) {
+    turn(0, true, 1);
+    encoder_task();
+    advance_time(ENCODER_ACCELERATION_TIMEOUT);
+    turn(0, true, 1);
+    encoder_task();
+    advance_time(5);
+    turn(0, true, 1);
+    encoder_task();
+
+    EXPECT_THAT(delta_updates, testing::ElementsAre(delta_update{0, 1}, delta_update{0, 1}, delta_update{0, 4}));
+}
+
+TEST_F(EncoderPipelineTest, ReportsVelocity) {
+    EXPECT_EQ(encoder_get_velocity(0), 0);
+
+    turn(0, true, 1);
+    encoder_task();
+    advance_time(10);
+    turn(0, true, 1);
+    encoder_task();
+
+    EXPECT_EQ(encoder_get_velocity(0), 100);
+    EXPECT_EQ(encoder_get_velocity(1), 0);
+
+    advance_time(ENCODER_ACCELERATION_TIMEOUT);
+    EXPECT_EQ(encoder_get_velocity(0), 0);
+}
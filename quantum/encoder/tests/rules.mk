@@ -8,6 +8,17 @@ encoder_SRC := \
 	$(QUANTUM_PATH)/encoder/tests/encoder_tests.cpp \
 	$(QUANTUM_PATH)/encoder.c
 
+encoder_pipeline_DEFS := -DENCODER_TESTS -DENCODER_ENABLE -DENCODER_MOCK_SINGLE
+encoder_pipeline_CONFIG := $(QUANTUM_PATH)/encoder/tests/config_mock_pipeline.h
+
+encoder_pipeline_SRC := \
+	platforms/timer.c \
+	platforms/test/timer.c \
+	drivers/encoder/encoder_quadrature.c \
+	$(QUANTUM_PATH)/encoder/tests/mock.c \
+	$(QUANTUM_PATH)/encoder/tests/encoder_tests_pipeline.cpp \
+	$(QUANTUM_PATH)/encoder.c
+
 encoder_split_left_eq_right_DEFS := -DENCODER_TESTS -DENCODER_ENABLE -DENCODER_MOCK_SPLIT
 encoder_split_left_eq_right_INC := $(QUANTUM_PATH)/split_common
 encoder_split_left_eq_right_CONFIG := $(QUANTUM_PATH)/encoder/tests/config_mock_split_left_eq_right.h
@@ -21,6 +21,8 @@
 #include "usb_device_state.h"
 #include "gpio.h"
 #include "keyboard.h"
+#include "util.h"
+#include <string.h>
 
 #ifdef HAPTIC_DRV2605L
 #    include "drv2605l.h"
@@ -30,11 +32,17 @@
 #endif
 
 #if defined(SPLIT_KEYBOARD) && defined(SPLIT_HAPTIC_ENABLE)
-extern uint8_t split_haptic_play;
+extern uint8_t split_haptic_play_count;
 #endif
 
 haptic_config_t haptic_config;
 
+#ifdef HAPTIC_DRV2605L
+// Effects waiting to be loaded into the DRV2605L's sequencer by haptic_task().
+static uint8_t haptic_queue[HAPTIC_QUEUE_SIZE];
+static uint8_t haptic_queue_length = 0;
+#endif
+
 static void update_haptic_enable_gpios(void) {
     if (haptic_config.enable && ((!HAPTIC_OFF_IN_LOW_POWER) || (usb_device_state_get_configure_state() == USB_DEVICE_STATE_CONFIGURED))) {
 #if defined(HAPTIC_ENABLE_PIN)
@@ -104,6 +112,17 @@ void haptic_init(void) {
 }
 
 void haptic_task(void) {
+#ifdef HAPTIC_DRV2605L
+    // Everything played since the last run goes out as one sequence, unless the previous
+    // one is still being sent, in which case the effects wait for the next run. Without
+    // I2C_QUEUE_ENABLE the sequence is written here, blocking until it is done.
+    if (haptic_queue_length > 0 && !drv2605l_sequence_is_busy()) {
+        uint8_t length = MIN(haptic_queue_length, DRV2605L_SEQUENCE_LENGTH);
+        drv2605l_sequence(haptic_queue, length);
+        haptic_queue_length -= length;
+        memmove(haptic_queue, haptic_queue + length, haptic_queue_length);
+    }
+#endif
 #ifdef HAPTIC_SOLENOID
 // Only run task on seconary boards if the user desires
 #    if defined(SPLIT_KEYBOARD) && !defined(SPLIT_HAPTIC_ENABLE)
@@ -330,20 +349,28 @@ void haptic_cont_decrease(void) {
     haptic_set_amplitude(amp);
 }
 
-void haptic_play(void) {
+void haptic_play_sequence(const uint8_t *effects, uint8_t length) {
 #ifdef HAPTIC_DRV2605L
-    uint8_t play_eff = 0;
-    play_eff         = haptic_config.mode;
-    drv2605l_pulse(play_eff);
-#    if defined(SPLIT_KEYBOARD) && defined(SPLIT_HAPTIC_ENABLE)
-    split_haptic_play = haptic_config.mode;
-#    endif
+    while (length > 0 && haptic_queue_length < HAPTIC_QUEUE_SIZE) {
+        haptic_queue[haptic_queue_length++] = *effects++;
+        length--;
+    }
 #endif
 #ifdef HAPTIC_SOLENOID
     solenoid_fire_handler();
-#    if defined(SPLIT_KEYBOARD) && defined(SPLIT_HAPTIC_ENABLE)
-    split_haptic_play = 1;
-#    endif
+#endif
+}
+
+void haptic_play(void) {
+#ifdef HAPTIC_DRV2605L
+    // Also fires the solenoid, if there is one.
+    uint8_t play_eff = haptic_config.mode;
+    haptic_play_sequence(&play_eff, 1);
+#elif defined(HAPTIC_SOLENOID)
+    solenoid_fire_handler();
+#endif
+#if defined(SPLIT_KEYBOARD) && defined(SPLIT_HAPTIC_ENABLE)
+    split_haptic_play_count++;
 #endif
 }
 
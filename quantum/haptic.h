@@ -28,6 +28,10 @@
 #ifndef HAPTIC_DEFAULT_MODE
 #    define HAPTIC_DEFAULT_MODE DRV2605L_DEFAULT_MODE
 #endif
+/* Effects that can wait for haptic_task() to hand them to the driver, excess ones are dropped */
+#ifndef HAPTIC_QUEUE_SIZE
+#    define HAPTIC_QUEUE_SIZE 16
+#endif
 
 /* EEPROM config settings */
 typedef union haptic_config_t {
@@ -79,6 +83,7 @@ void    haptic_cont_increase(void);
 void    haptic_cont_decrease(void);
 
 void haptic_play(void);
+void haptic_play_sequence(const uint8_t *effects, uint8_t length);
 void haptic_shutdown(void);
 void haptic_notify_usb_device_state_change(void);
 
@@ -53,7 +53,9 @@ __attribute__((weak)) void joystick_axis_init(uint8_t axis) {
 __attribute__((weak)) uint16_t joystick_axis_sample(uint8_t axis) {
     if (axis >= JOYSTICK_AXIS_COUNT) return 0;
 
-#if defined(JOYSTICK_ANALOG)
+#if defined(JOYSTICK_ANALOG) && defined(ANALOG_SCAN_PINS)
+    return analogReadPinFiltered(joystick_axes[axis].input_pin);
+#elif defined(JOYSTICK_ANALOG)
     return analogReadPin(joystick_axes[axis].input_pin);
 #else
     // default to resting position
@@ -34,6 +34,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "eeconfig.h"
 #include "action_layer.h"
 #include "suspend.h"
+#include "boot_trace.h"
 #ifdef BOOTMAGIC_ENABLE
 #    include "bootmagic.h"
 #endif
@@ -82,6 +83,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef KEY_OVERRIDE_ENABLE
 #    include "process_key_override.h"
 #endif
+#ifdef DYNAMIC_MACRO_ENABLE
+#    include "process_dynamic_macro.h"
+#endif
 #ifdef SECURE_ENABLE
 #    include "secure.h"
 #endif
@@ -151,6 +155,12 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef CONNECTION_ENABLE
 #    include "connection.h"
 #endif
+#ifdef I2C_QUEUE_ENABLE
+#    include "i2c_queue.h"
+#endif
+#ifdef SPI_QUEUE_ENABLE
+#    include "spi_queue.h"
+#endif
 
 static uint32_t last_input_modification_time = 0;
 uint32_t        last_input_activity_time(void) {
@@ -459,33 +469,44 @@ void quantum_init(void) {
 void keyboard_init(void) {
     timer_init();
     sync_timer_init();
+    BOOT_TRACE(KEYBOARD_INIT);
 #ifdef VIA_ENABLE
     via_init();
+    BOOT_TRACE(VIA);
 #endif
 #ifdef SPLIT_KEYBOARD
     split_pre_init();
+    BOOT_TRACE(SPLIT_PRE);
 #endif
 #ifdef ENCODER_ENABLE
     encoder_init();
+    BOOT_TRACE(ENCODER);
 #endif
     matrix_init();
+    BOOT_TRACE(MATRIX);
     quantum_init();
+    BOOT_TRACE(QUANTUM);
 #ifdef CONNECTION_ENABLE
     connection_init();
+    BOOT_TRACE(CONNECTION);
 #endif
     host_init();
+    BOOT_TRACE(HOST);
     led_init_ports();
 #ifdef BACKLIGHT_ENABLE
     backlight_init_ports();
 #endif
 #ifdef AUDIO_ENABLE
     audio_init();
+    BOOT_TRACE(AUDIO);
 #endif
 #ifdef LED_MATRIX_ENABLE
     led_matrix_init();
+    BOOT_TRACE(LED_MATRIX);
 #endif
 #ifdef RGB_MATRIX_ENABLE
     rgb_matrix_init();
+    BOOT_TRACE(RGB_MATRIX);
 #endif
 #if defined(UNICODE_COMMON_ENABLE)
     unicode_input_mode_init();
@@ -495,18 +516,22 @@ void keyboard_init(void) {
 #endif
 #ifdef OLED_ENABLE
     oled_init(OLED_ROTATION_0);
+    BOOT_TRACE(DISPLAY);
 #endif
 #ifdef ST7565_ENABLE
     st7565_init(DISPLAY_ROTATION_0);
+    BOOT_TRACE(DISPLAY);
 #endif
 #ifdef PS2_MOUSE_ENABLE
     ps2_mouse_init();
 #endif
 #ifdef BACKLIGHT_ENABLE
     backlight_init();
+    BOOT_TRACE(BACKLIGHT);
 #endif
 #ifdef RGBLIGHT_ENABLE
     rgblight_init();
+    BOOT_TRACE(RGBLIGHT);
 #endif
 #ifdef STENO_ENABLE_ALL
     steno_init();
@@ -530,10 +555,12 @@ void keyboard_init(void) {
 #endif
 #ifdef SPLIT_KEYBOARD
     split_post_init();
+    BOOT_TRACE(SPLIT_POST);
 #endif
 #ifdef POINTING_DEVICE_ENABLE
     // init after split init
     pointing_device_init();
+    BOOT_TRACE(POINTING);
 #endif
 #ifdef BATTERY_ENABLE
     battery_init();
@@ -543,6 +570,7 @@ void keyboard_init(void) {
 #endif
 #ifdef HAPTIC_ENABLE
     haptic_init();
+    BOOT_TRACE(HAPTIC);
 #endif
 
 #if defined(DEBUG_MATRIX_SCAN_RATE) && defined(CONSOLE_ENABLE)
@@ -550,6 +578,7 @@ void keyboard_init(void) {
 #endif
 
     keyboard_post_init_quantum(); /* Always keep this last */
+    BOOT_TRACE(POST_INIT);
 }
 
 /** \brief key_event_task
@@ -664,6 +693,10 @@ void quantum_task(void) {
     key_override_task();
 #endif
 
+#ifdef DYNAMIC_MACRO_ENABLE
+    dynamic_macro_task();
+#endif
+
 #ifdef SEQUENCER_ENABLE
     sequencer_task();
 #endif
@@ -797,6 +830,14 @@ void keyboard_task(void) {
     haptic_task();
 #endif
 
+#ifdef I2C_QUEUE_ENABLE
+    i2c_queue_task();
+#endif
+
+#ifdef SPI_QUEUE_ENABLE
+    spi_queue_task();
+#endif
+
     led_task();
 
 #ifdef OS_DETECTION_ENABLE
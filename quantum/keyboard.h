@@ -40,6 +40,9 @@ typedef struct {
     uint16_t        time;
     keyevent_type_t type;
     bool            pressed;
+#ifdef KEYEVENT_TIME_US
+    uint32_t time_us;
+#endif
 } keyevent_t;
 
 /* equivalent test of keypos_t */
@@ -74,7 +77,22 @@ static inline bool IS_DIPSWITCHEVENT(const keyevent_t event) {
 #define MAKE_KEYPOS(row_num, col_num) ((keypos_t){.row = (row_num), .col = (col_num)})
 
 /* Common keyevent_t object factory */
-#define MAKE_EVENT(row_num, col_num, press, event_type) ((keyevent_t){.key = MAKE_KEYPOS((row_num), (col_num)), .pressed = (press), .time = timer_read(), .type = (event_type)})
+#ifdef KEYEVENT_TIME_US
+#    define MAKE_EVENT(row_num, col_num, press, event_type) ((keyevent_t){.key = MAKE_KEYPOS((row_num), (col_num)), .pressed = (press), .time = timer_read(), .type = (event_type), .time_us = timer_read_us32()})
+#else
+#    define MAKE_EVENT(row_num, col_num, press, event_type) ((keyevent_t){.key = MAKE_KEYPOS((row_num), (col_num)), .pressed = (press), .time = timer_read(), .type = (event_type)})
+#endif
+
+#ifdef KEYEVENT_TIME_US
+/**
+ * @brief The timer_read_us32() time matching `time`, a timer_read() time less than 32 seconds away.
+ *
+ * For key events that are not built by MAKE_EVENT() and only carry a millisecond time.
+ */
+static inline uint32_t keyevent_time_us(uint16_t time) {
+    return timer_read_us32() + (int32_t)(int16_t)(time - timer_read()) * 1000;
+}
+#endif
 
 /**
  * @brief Constructs a key event for a pressed or released key.
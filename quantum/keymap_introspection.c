@@ -175,6 +175,14 @@ __attribute__((weak)) const key_override_t* key_override_get(uint16_t key_overri
     return key_override_get_raw(key_override_idx);
 }
 
+#    ifndef KEY_OVERRIDE_NO_INDEX
+static uint16_t key_override_index_buffer[ARRAY_SIZE(key_overrides)];
+
+uint16_t* key_override_index_storage_raw(void) {
+    return key_override_index_buffer;
+}
+#    endif // KEY_OVERRIDE_NO_INDEX
+
 #endif // defined(KEY_OVERRIDE_ENABLE)
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
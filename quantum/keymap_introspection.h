@@ -108,4 +108,9 @@ const key_override_t* key_override_get_raw(uint16_t key_override_idx);
 // Get the key override definitions, potentially stored dynamically
 const key_override_t* key_override_get(uint16_t key_override_idx);
 
+#    ifndef KEY_OVERRIDE_NO_INDEX
+// Scratch storage for the trigger index built by process_key_override, holds key_override_count_raw() entries
+uint16_t* key_override_index_storage_raw(void);
+#    endif // KEY_OVERRIDE_NO_INDEX
+
 #endif // defined(KEY_OVERRIDE_ENABLE)
@@ -7,15 +7,78 @@
 
 #include <string.h>
 
+#if __has_include("leader_data.h")
+#    include "progmem.h"
+#    include "quantum.h"
+#    include "leader_data.h"
+#endif
+
 #ifndef LEADER_TIMEOUT
 #    define LEADER_TIMEOUT 300
 #endif
 
+#ifndef LEADER_SEQUENCE_MAX_LENGTH
+#    if defined(LEADER_DATA_MAX_LENGTH) && LEADER_DATA_MAX_LENGTH > 5
+#        define LEADER_SEQUENCE_MAX_LENGTH LEADER_DATA_MAX_LENGTH
+#    else
+#        define LEADER_SEQUENCE_MAX_LENGTH 5
+#    endif
+#endif
+
+#if LEADER_SEQUENCE_MAX_LENGTH < 5
+#    error "LEADER_SEQUENCE_MAX_LENGTH must be at least 5"
+#endif
+
 // Leader key stuff
-bool     leading              = false;
-uint16_t leader_time          = 0;
-uint16_t leader_sequence[5]   = {0, 0, 0, 0, 0};
-uint8_t  leader_sequence_size = 0;
+bool     leading                                     = false;
+uint16_t leader_time                                 = 0;
+uint16_t leader_sequence[LEADER_SEQUENCE_MAX_LENGTH] = {0};
+uint8_t  leader_sequence_size                        = 0;
+
+#ifdef LEADER_DATA_SIZE
+// Each trie node in `leader_data` is a header word (number of children, bit 15
+// set if a sequence ends here), the action if any, then (keycode, child offset)
+// pairs. `leader_data_state` is the offset of the node matching the sequence so far.
+#    define LEADER_DATA_HAS_ACTION 0x8000
+#    define LEADER_DATA_NO_MATCH 0xFFFF
+
+static uint16_t leader_data_state = 0;
+
+__attribute__((weak)) void leader_data_action_user(uint16_t action) {
+    tap_code16(action);
+}
+
+/**
+ * Follows `keycode` from the current trie node.
+ *
+ * \return `true` if the new node completes a sequence that no other sequence extends.
+ */
+static bool leader_data_advance(uint16_t keycode) {
+    if (leader_data_state == LEADER_DATA_NO_MATCH) {
+        return false;
+    }
+
+    uint16_t header   = pgm_read_word(&leader_data[leader_data_state]);
+    uint16_t children = header & ~LEADER_DATA_HAS_ACTION;
+    uint16_t link     = leader_data_state + 1 + ((header & LEADER_DATA_HAS_ACTION) ? 1 : 0);
+
+    leader_data_state = LEADER_DATA_NO_MATCH;
+    for (uint16_t i = 0; i < children; i++, link += 2) {
+        if (pgm_read_word(&leader_data[link]) == keycode) {
+            leader_data_state = pgm_read_word(&leader_data[link + 1]);
+            return pgm_read_word(&leader_data[leader_data_state]) == LEADER_DATA_HAS_ACTION;
+        }
+    }
+    return false;
+}
+
+static void leader_data_dispatch(void) {
+    if (leader_data_state != LEADER_DATA_NO_MATCH && (pgm_read_word(&leader_data[leader_data_state]) & LEADER_DATA_HAS_ACTION)) {
+        leader_data_action_user(pgm_read_word(&leader_data[leader_data_state + 1]));
+    }
+    leader_data_state = LEADER_DATA_NO_MATCH;
+}
+#endif
 
 __attribute__((weak)) void leader_start_user(void) {}
 
@@ -34,10 +97,16 @@ void leader_start(void) {
     leader_time          = timer_read();
     leader_sequence_size = 0;
     memset(leader_sequence, 0, sizeof(leader_sequence));
+#ifdef LEADER_DATA_SIZE
+    leader_data_state = 0;
+#endif
 }
 
 void leader_end(void) {
     leading = false;
+#ifdef LEADER_DATA_SIZE
+    leader_data_dispatch();
+#endif
     leader_end_user();
 }
 
@@ -65,7 +134,15 @@ bool leader_sequence_add(uint16_t keycode) {
     leader_sequence[leader_sequence_size] = keycode;
     leader_sequence_size++;
 
-    if (leader_add_user(keycode)) {
+#ifdef LEADER_DATA_SIZE
+    // Follow the trie before the user hook, so that ending the sequence early dispatches it including this key.
+    // Fire right away once no longer sequence can follow, instead of waiting for the timeout.
+    bool complete = leader_data_advance(keycode);
+#else
+    bool complete = false;
+#endif
+
+    if (leader_add_user(keycode) || complete) {
         leader_end();
     }
     return true;
@@ -84,7 +161,7 @@ void leader_reset_timer(void) {
 }
 
 bool leader_sequence_is(uint16_t kc1, uint16_t kc2, uint16_t kc3, uint16_t kc4, uint16_t kc5) {
-    return leader_sequence[0] == kc1 && leader_sequence[1] == kc2 && leader_sequence[2] == kc3 && leader_sequence[3] == kc4 && leader_sequence[4] == kc5;
+    return leader_sequence_size <= 5 && leader_sequence[0] == kc1 && leader_sequence[1] == kc2 && leader_sequence[2] == kc3 && leader_sequence[3] == kc4 && leader_sequence[4] == kc5;
 }
 
 bool leader_sequence_one_key(uint16_t kc) {
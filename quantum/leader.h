@@ -30,6 +30,15 @@ void leader_end_user(void);
  */
 bool leader_add_user(uint16_t keycode);
 
+/**
+ * \brief User callback, invoked when a sequence from the generated `leader_data.h` dictionary is matched.
+ *
+ * The default implementation taps `action` with `tap_code16()`.
+ *
+ * \param action The keycode given for the matched sequence.
+ */
+void leader_data_action_user(uint16_t action);
+
 /**
  * Begin the leader sequence, resetting the buffer and timer.
  */
@@ -21,6 +21,8 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "matrix.h"
 #include "debounce.h"
 #include "atomic_util.h"
+#include "wait.h"
+#include "compiler_support.h"
 
 #ifdef SPLIT_KEYBOARD
 #    include "split_common/split_util.h"
@@ -58,6 +60,49 @@ static SPLIT_MUTABLE_COL pin_t col_pins[MATRIX_COLS] = MATRIX_COL_PINS;
 #    endif // MATRIX_COL_PINS
 #endif
 
+#ifdef MATRIX_BATCH_PORT_READS
+#    ifndef gpio_read_port
+#        error MATRIX_BATCH_PORT_READS is not supported on this platform
+#    endif
+#    if defined(DIRECT_PINS) || !defined(MATRIX_COL_PINS) || (DIODE_DIRECTION != COL2ROW)
+#        error MATRIX_BATCH_PORT_READS requires a COL2ROW matrix
+#    endif
+
+// Columns wired to consecutive bits of the same port in the same order, read with a single shift and mask
+typedef struct {
+    uint8_t  port;   // index into col_ports
+    uint8_t  bit;    // port bit of the first column
+    uint8_t  col;    // first column
+    uint8_t  length; // number of columns
+    uint32_t mask;   // length bits, right aligned
+} col_port_run_t;
+
+static gpio_port_t    col_ports[MATRIX_COLS];
+static uint8_t        col_port_count;
+static col_port_run_t col_port_runs[MATRIX_COLS];
+static uint8_t        col_port_run_count;
+#endif // MATRIX_BATCH_PORT_READS
+
+#ifdef MATRIX_IO_DELAY_ADAPTIVE
+#    if defined(DIRECT_PINS) || !defined(MATRIX_ROW_PINS) || !defined(MATRIX_COL_PINS)
+#        error MATRIX_IO_DELAY_ADAPTIVE requires a COL2ROW or ROW2COL matrix
+#    endif
+#    ifndef MATRIX_IO_DELAY_MARGIN
+#        define MATRIX_IO_DELAY_MARGIN 2
+#    endif
+#    if (DIODE_DIRECTION == ROW2COL)
+#        define MATRIX_SCAN_LINES MATRIX_COLS
+#    else
+#        define MATRIX_SCAN_LINES MATRIX_ROWS_PER_HAND
+#    endif
+
+// Settle times are counted in uint8_t microseconds, up to MATRIX_IO_DELAY
+STATIC_ASSERT(MATRIX_IO_DELAY < 255, "MATRIX_IO_DELAY_ADAPTIVE needs MATRIX_IO_DELAY to be below 255 microseconds");
+
+// Longest time the input pins took to return to idle after each scan line was unselected
+static uint8_t line_settle_time[MATRIX_SCAN_LINES];
+#endif // MATRIX_IO_DELAY_ADAPTIVE
+
 /* matrix state(1:on, 0:off) */
 extern matrix_row_t raw_matrix[MATRIX_ROWS]; // raw values
 extern matrix_row_t matrix[MATRIX_ROWS];     // debounced values
@@ -100,6 +145,68 @@ static inline uint8_t readMatrixPin(pin_t pin) {
     }
 }
 
+#ifdef MATRIX_IO_DELAY_ADAPTIVE
+// Polls the input pins until none of them reads as pressed, returns roughly how many microseconds that took
+static uint8_t wait_for_inputs_idle(const pin_t *pins, uint8_t count) {
+    uint8_t elapsed = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        while (pins[i] != NO_PIN && gpio_read_pin(pins[i]) == MATRIX_INPUT_PRESSED_STATE && elapsed < MATRIX_IO_DELAY) {
+            wait_us(1);
+            elapsed++;
+        }
+    }
+    return elapsed;
+}
+
+static uint8_t line_unselect_delay(uint8_t line) {
+    uint16_t delay = line_settle_time[line] + line_settle_time[line] / 2 + MATRIX_IO_DELAY_MARGIN;
+    return delay < MATRIX_IO_DELAY ? delay : MATRIX_IO_DELAY;
+}
+
+// Replaces matrix_output_unselect_delay(): waits the calibrated time for the line, and when a key pulled the inputs
+// measures how long they really take to recover, raising the line's settle time if it was underestimated
+static void adaptive_unselect_delay(uint8_t line, bool key_pressed, const pin_t *inputs, uint8_t count) {
+    uint8_t delay = line_unselect_delay(line);
+    if (key_pressed) {
+        uint8_t settle = wait_for_inputs_idle(inputs, count);
+        if (settle > line_settle_time[line]) {
+            line_settle_time[line] = settle;
+        }
+        delay = settle < delay ? delay - settle : 0;
+    }
+    for (uint8_t i = 0; i < delay; i++) {
+        wait_us(1);
+    }
+}
+
+// Pulls every input pin to its pressed level and releases it, as a pressed key would, then times the recovery
+static uint8_t measure_inputs_settle(const pin_t *inputs, uint8_t count) {
+    for (uint8_t i = 0; i < count; i++) {
+        if (inputs[i] != NO_PIN) {
+            ATOMIC_BLOCK_FORCEON {
+                gpio_set_pin_output(inputs[i]);
+#    if MATRIX_INPUT_PRESSED_STATE == 0
+                gpio_write_pin_low(inputs[i]);
+#    else
+                gpio_write_pin_high(inputs[i]);
+#    endif
+            }
+        }
+    }
+    wait_us(1);
+    for (uint8_t i = 0; i < count; i++) {
+        if (inputs[i] != NO_PIN) {
+            gpio_atomic_set_pin_input_high(inputs[i]);
+        }
+    }
+    return wait_for_inputs_idle(inputs, count);
+}
+
+uint8_t matrix_get_line_settle_time(uint8_t line) {
+    return line < MATRIX_SCAN_LINES ? line_settle_time[line] : 0;
+}
+#endif // MATRIX_IO_DELAY_ADAPTIVE
+
 // matrix code
 
 #ifdef DIRECT_PINS
@@ -168,6 +275,70 @@ __attribute__((weak)) void matrix_init_pins(void) {
     }
 }
 
+#            ifdef MATRIX_IO_DELAY_ADAPTIVE
+static void calibrate_line_settle_time(void) {
+    for (uint8_t row = 0; row < MATRIX_ROWS_PER_HAND; row++) {
+        if (select_row(row)) {
+            matrix_output_select_delay();
+            unselect_row(row);
+            line_settle_time[row] = measure_inputs_settle(col_pins, MATRIX_COLS);
+        }
+    }
+}
+#            endif // MATRIX_IO_DELAY_ADAPTIVE
+
+#            ifdef MATRIX_BATCH_PORT_READS
+// Groups the col pins by port, merging columns on consecutive port bits into runs
+static void init_col_port_runs(void) {
+    col_port_count     = 0;
+    col_port_run_count = 0;
+
+    for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+        pin_t pin = col_pins[col];
+        if (pin == NO_PIN) {
+            continue;
+        }
+
+        gpio_port_t port  = gpio_pin_port(pin);
+        uint8_t     bit   = gpio_pin_bit(pin);
+        uint8_t     index = 0;
+        while (index < col_port_count && col_ports[index] != port) {
+            index++;
+        }
+        if (index == col_port_count) {
+            col_ports[col_port_count++] = port;
+        }
+
+        col_port_run_t *run = col_port_run_count > 0 ? &col_port_runs[col_port_run_count - 1] : NULL;
+        if (run && run->port == index && run->bit + run->length == bit && run->col + run->length == col) {
+            run->length++;
+            run->mask = (run->mask << 1) | 1;
+        } else {
+            col_port_runs[col_port_run_count++] = (col_port_run_t){.port = index, .bit = bit, .col = col, .length = 1, .mask = 1};
+        }
+    }
+}
+
+static matrix_row_t read_cols_by_port(void) {
+    uint32_t port_values[MATRIX_COLS];
+
+    // Sample every port first so all columns are read as close together as possible
+    for (uint8_t i = 0; i < col_port_count; i++) {
+        port_values[i] = gpio_read_port(col_ports[i]);
+#                if MATRIX_INPUT_PRESSED_STATE == 0
+        port_values[i] = ~port_values[i];
+#                endif
+    }
+
+    matrix_row_t current_row_value = 0;
+    for (uint8_t i = 0; i < col_port_run_count; i++) {
+        const col_port_run_t *run = &col_port_runs[i];
+        current_row_value |= (matrix_row_t)((port_values[run->port] >> run->bit) & run->mask) << run->col;
+    }
+    return current_row_value;
+}
+#            endif // MATRIX_BATCH_PORT_READS
+
 __attribute__((weak)) void matrix_read_cols_on_row(matrix_row_t current_matrix[], uint8_t current_row) {
     // Start with a clear matrix row
     matrix_row_t current_row_value = 0;
@@ -177,6 +348,9 @@ __attribute__((weak)) void matrix_read_cols_on_row(matrix_row_t current_matrix[]
     }
     matrix_output_select_delay();
 
+#            ifdef MATRIX_BATCH_PORT_READS
+    current_row_value = read_cols_by_port();
+#            else
     // For each col...
     matrix_row_t row_shifter = MATRIX_ROW_SHIFTER;
     for (uint8_t col_index = 0; col_index < MATRIX_COLS; col_index++, row_shifter <<= 1) {
@@ -185,10 +359,15 @@ __attribute__((weak)) void matrix_read_cols_on_row(matrix_row_t current_matrix[]
         // Populate the matrix row with the state of the col pin
         current_row_value |= pin_state ? 0 : row_shifter;
     }
+#            endif // MATRIX_BATCH_PORT_READS
 
     // Unselect row
     unselect_row(current_row);
+#            ifdef MATRIX_IO_DELAY_ADAPTIVE
+    adaptive_unselect_delay(current_row, current_row_value != 0, col_pins, MATRIX_COLS);
+#            else
     matrix_output_unselect_delay(current_row, current_row_value != 0); // wait for all Col signals to go HIGH
+#            endif
 
     // Update the matrix
     current_matrix[current_row] = current_row_value;
@@ -231,6 +410,18 @@ __attribute__((weak)) void matrix_init_pins(void) {
     }
 }
 
+#            ifdef MATRIX_IO_DELAY_ADAPTIVE
+static void calibrate_line_settle_time(void) {
+    for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+        if (select_col(col)) {
+            matrix_output_select_delay();
+            unselect_col(col);
+            line_settle_time[col] = measure_inputs_settle(row_pins, MATRIX_ROWS_PER_HAND);
+        }
+    }
+}
+#            endif // MATRIX_IO_DELAY_ADAPTIVE
+
 __attribute__((weak)) void matrix_read_rows_on_col(matrix_row_t current_matrix[], uint8_t current_col, matrix_row_t row_shifter) {
     bool key_pressed = false;
 
@@ -255,7 +446,11 @@ __attribute__((weak)) void matrix_read_rows_on_col(matrix_row_t current_matrix[]
 
     // Unselect col
     unselect_col(current_col);
+#            ifdef MATRIX_IO_DELAY_ADAPTIVE
+    adaptive_unselect_delay(current_col, key_pressed, row_pins, MATRIX_ROWS_PER_HAND);
+#            else
     matrix_output_unselect_delay(current_col, key_pressed); // wait for all Row signals to go HIGH
+#            endif
 }
 
 #        else
@@ -296,9 +491,17 @@ void matrix_init(void) {
     thatHand = MATRIX_ROWS_PER_HAND - thisHand;
 #endif
 
+#ifdef MATRIX_BATCH_PORT_READS
+    init_col_port_runs();
+#endif
+
     // initialize key pins
     matrix_init_pins();
 
+#ifdef MATRIX_IO_DELAY_ADAPTIVE
+    calibrate_line_settle_time();
+#endif
+
     // initialize matrix state: all keys off
     memset(matrix, 0, sizeof(matrix));
     memset(raw_matrix, 0, sizeof(raw_matrix));
@@ -21,6 +21,10 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include <stdbool.h>
 #include "gpio.h"
 
+#ifndef MATRIX_IO_DELAY
+#    define MATRIX_IO_DELAY 30
+#endif
+
 /* diode directions */
 #define COL2ROW 0
 #define ROW2COL 1
@@ -70,6 +74,10 @@ void matrix_output_select_delay(void);
 void matrix_output_unselect_delay(uint8_t line, bool key_pressed);
 /* only for backwards compatibility. delay between changing matrix pin state and reading values */
 void matrix_io_delay(void);
+#ifdef MATRIX_IO_DELAY_ADAPTIVE
+/* measured settle time of a scan line in microseconds, see MATRIX_IO_DELAY_ADAPTIVE */
+uint8_t matrix_get_line_settle_time(uint8_t line);
+#endif
 
 /* power control */
 void matrix_power_up(void);
@@ -0,0 +1,23 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#define MATRIX_ROWS 2
+#define MATRIX_COLS 8
+
+#define DIODE_DIRECTION COL2ROW
+
+/* Columns 0-2 share port 0, columns 3-4 sit on port 1 in reverse order, 6-7 straddle ports 0 and 1 */
+#define MATRIX_COL_PINS {0x00, 0x01, 0x02, 0x15, 0x14, NO_PIN, 0x07, 0x18}
+#define MATRIX_ROW_PINS {0x20, 0x21}
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "mock.h"
+
+#ifdef __cplusplus
+};
+#endif
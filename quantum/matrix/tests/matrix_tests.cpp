@@ -0,0 +1,80 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "matrix.h"
+#include "matrix/tests/mock.h"
+
+extern matrix_row_t matrix[MATRIX_ROWS];
+}
+
+static const pin_t row_pins[MATRIX_ROWS] = MATRIX_ROW_PINS;
+static const pin_t col_pins[MATRIX_COLS] = MATRIX_COL_PINS;
+
+class MatrixScan : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        mock_reset();
+        matrix_init();
+    }
+
+    void press(uint8_t row, uint8_t col, bool pressed = true) {
+        mock_press(row_pins[row], col_pins[col], pressed);
+    }
+};
+
+TEST_F(MatrixScan, IdleMatrixIsEmpty) {
+    EXPECT_FALSE(matrix_scan());
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        EXPECT_EQ(matrix[row], 0);
+    }
+}
+
+TEST_F(MatrixScan, EveryKeyMapsToItsOwnBit) {
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            if (col_pins[col] == NO_PIN) {
+                continue;
+            }
+            press(row, col);
+            EXPECT_TRUE(matrix_scan());
+            for (uint8_t r = 0; r < MATRIX_ROWS; r++) {
+                EXPECT_EQ(matrix[r], r == row ? (matrix_row_t)(1 << col) : 0) << "row " << (int)row << " col " << (int)col;
+            }
+            press(row, col, false);
+            EXPECT_TRUE(matrix_scan());
+        }
+    }
+}
+
+TEST_F(MatrixScan, ChordsAcrossPortsAndRows) {
+    press(0, 0);
+    press(0, 4);
+    press(0, 7);
+    press(1, 2);
+    press(1, 3);
+    press(1, 6);
+    EXPECT_TRUE(matrix_scan());
+    EXPECT_EQ(matrix[0], 0b10010001);
+    EXPECT_EQ(matrix[1], 0b01001100);
+
+    EXPECT_FALSE(matrix_scan());
+}
+
+TEST_F(MatrixScan, ReadsPerScan) {
+    mock_pin_reads  = 0;
+    mock_port_reads = 0;
+    matrix_scan();
+
+#ifdef MATRIX_BATCH_PORT_READS
+    // Two ports per row, no matter how many columns sit on them
+    EXPECT_EQ(mock_port_reads, 2u * MATRIX_ROWS);
+    EXPECT_EQ(mock_pin_reads, 0u);
+#else
+    // One read per connected column per row
+    EXPECT_EQ(mock_pin_reads, 7u * MATRIX_ROWS);
+    EXPECT_EQ(mock_port_reads, 0u);
+#endif
+}
@@ -0,0 +1,71 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "matrix.h"
+#include "matrix/tests/mock.h"
+}
+
+extern matrix_row_t matrix[MATRIX_ROWS];
+
+static const pin_t row_pins[MATRIX_ROWS] = MATRIX_ROW_PINS;
+static const pin_t col_pins[MATRIX_COLS] = MATRIX_COL_PINS;
+
+class MatrixAdaptiveDelay : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        mock_reset();
+    }
+};
+
+TEST_F(MatrixAdaptiveDelay, InstantLinesCalibrateToZero) {
+    matrix_init();
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        EXPECT_EQ(matrix_get_line_settle_time(row), 0);
+    }
+}
+
+TEST_F(MatrixAdaptiveDelay, BootCalibrationMeasuresInputRecovery) {
+    mock_set_settle_reads(col_pins[6], 5);
+    matrix_init();
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        EXPECT_EQ(matrix_get_line_settle_time(row), 5);
+    }
+}
+
+TEST_F(MatrixAdaptiveDelay, PressedKeyRaisesOnlyItsLine) {
+    matrix_init();
+    mock_set_settle_reads(row_pins[1], 4);
+
+    mock_press(row_pins[1], col_pins[2], true);
+    EXPECT_TRUE(matrix_scan());
+    EXPECT_EQ(matrix[1], 1 << 2);
+    EXPECT_EQ(matrix_get_line_settle_time(0), 0);
+    EXPECT_EQ(matrix_get_line_settle_time(1), 4);
+
+    // The next row still reads correctly, the slow column had recovered before it was selected
+    mock_press(row_pins[0], col_pins[3], true);
+    EXPECT_TRUE(matrix_scan());
+    EXPECT_EQ(matrix[0], 1 << 3);
+    EXPECT_EQ(matrix[1], 1 << 2);
+}
+
+TEST_F(MatrixAdaptiveDelay, SettleTimeNeverDecreases) {
+    matrix_init();
+    mock_set_settle_reads(row_pins[0], 6);
+    mock_press(row_pins[0], col_pins[0], true);
+    matrix_scan();
+    EXPECT_EQ(matrix_get_line_settle_time(0), 6);
+
+    mock_set_settle_reads(row_pins[0], 1);
+    matrix_scan();
+    EXPECT_EQ(matrix_get_line_settle_time(0), 6);
+}
+
+TEST_F(MatrixAdaptiveDelay, SettleTimeIsBoundedByIoDelay) {
+    mock_set_settle_reads(col_pins[0], 200);
+    matrix_init();
+    EXPECT_EQ(matrix_get_line_settle_time(0), MATRIX_IO_DELAY);
+}
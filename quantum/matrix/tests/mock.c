@@ -0,0 +1,114 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "matrix.h"
+#include "debounce.h"
+#include "mock.h"
+
+#define MOCK_PIN_COUNT (MOCK_PORT_COUNT * 16)
+
+static bool output_low[MOCK_PIN_COUNT];
+static bool switches[MOCK_PIN_COUNT][MOCK_PIN_COUNT];
+static uint8_t settle_reads[MOCK_PIN_COUNT];
+static uint8_t pending_low[MOCK_PIN_COUNT];
+
+uint32_t mock_pin_reads;
+uint32_t mock_port_reads;
+
+// Releasing a pin driven low leaves it, and any input a closed switch connected to it, low for a few more reads
+static void release_pin(pin_t pin) {
+    if (!output_low[pin]) {
+        return;
+    }
+    output_low[pin]  = false;
+    pending_low[pin] = settle_reads[pin];
+    for (pin_t other = 0; other < MOCK_PIN_COUNT; other++) {
+        if (switches[pin][other] && pending_low[other] < settle_reads[pin]) {
+            pending_low[other] = settle_reads[pin];
+        }
+    }
+}
+
+void mock_set_pin_input_high(pin_t pin) {
+    release_pin(pin);
+}
+
+void mock_set_pin_output(pin_t pin) {}
+
+void mock_write_pin(pin_t pin, bool high) {
+    if (high) {
+        release_pin(pin);
+    } else {
+        output_low[pin] = true;
+    }
+}
+
+// An input is pulled high unless a closed switch connects it to a row driven low, or it has not settled yet
+static bool pin_level(pin_t pin) {
+    for (pin_t row = 0; row < MOCK_PIN_COUNT; row++) {
+        if (output_low[row] && switches[row][pin]) {
+            return false;
+        }
+    }
+    if (pending_low[pin] > 0) {
+        pending_low[pin]--;
+        return false;
+    }
+    return !output_low[pin];
+}
+
+bool mock_read_pin(pin_t pin) {
+    mock_pin_reads++;
+    return pin_level(pin);
+}
+
+uint16_t mock_read_port(gpio_port_t port) {
+    mock_port_reads++;
+    uint16_t value = 0;
+    for (uint8_t bit = 0; bit < 16; bit++) {
+        if (pin_level((port << 4) | bit)) {
+            value |= 1 << bit;
+        }
+    }
+    return value;
+}
+
+void mock_press(pin_t row_pin, pin_t col_pin, bool pressed) {
+    switches[row_pin][col_pin] = pressed;
+}
+
+void mock_set_settle_reads(pin_t pin, uint8_t reads) {
+    settle_reads[pin] = reads;
+}
+
+void mock_reset(void) {
+    memset(output_low, 0, sizeof(output_low));
+    memset(switches, 0, sizeof(switches));
+    memset(settle_reads, 0, sizeof(settle_reads));
+    memset(pending_low, 0, sizeof(pending_low));
+    mock_pin_reads  = 0;
+    mock_port_reads = 0;
+}
+
+/* Stand-ins for the rest of the keyboard, the debounce passes the raw matrix straight through. */
+
+void debounce_init(void) {}
+
+bool debounce(matrix_row_t raw[], matrix_row_t cooked[], bool changed) {
+    if (changed) {
+        memcpy(cooked, raw, sizeof(matrix_row_t) * MATRIX_ROWS);
+    }
+    return changed;
+}
+
+void matrix_output_select_delay(void) {}
+
+void matrix_output_unselect_delay(uint8_t line, bool key_pressed) {}
+
+void matrix_init_kb(void) {}
+
+void matrix_scan_kb(void) {}
+
+matrix_row_t raw_matrix[MATRIX_ROWS];
+matrix_row_t matrix[MATRIX_ROWS];
@@ -0,0 +1,38 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Mock pins are numbered 0xPB, where P is the port and B the bit within it. */
+typedef uint8_t pin_t;
+typedef uint8_t gpio_port_t;
+
+#define MOCK_PORT_COUNT 4
+
+#define gpio_set_pin_input_high(pin) mock_set_pin_input_high(pin)
+#define gpio_set_pin_output(pin) mock_set_pin_output(pin)
+#define gpio_write_pin_low(pin) mock_write_pin(pin, false)
+#define gpio_write_pin_high(pin) mock_write_pin(pin, true)
+#define gpio_read_pin(pin) mock_read_pin(pin)
+
+#define gpio_pin_port(pin) ((gpio_port_t)((pin) >> 4))
+#define gpio_pin_bit(pin) ((pin)&0xF)
+#define gpio_read_port(port) mock_read_port(port)
+
+void     mock_set_pin_input_high(pin_t pin);
+void     mock_set_pin_output(pin_t pin);
+void     mock_write_pin(pin_t pin, bool high);
+bool     mock_read_pin(pin_t pin);
+uint16_t mock_read_port(gpio_port_t port);
+
+/* Connects `col_pin` to `row_pin`, as if the switch between them was held down. */
+void mock_press(pin_t row_pin, pin_t col_pin, bool pressed);
+/* Makes `pin` read low for `reads` more reads after it, or a row it is switched to, stops being driven low. */
+void mock_set_settle_reads(pin_t pin, uint8_t reads);
+void mock_reset(void);
+
+extern uint32_t mock_pin_reads;
+extern uint32_t mock_port_reads;
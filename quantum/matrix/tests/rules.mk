@@ -0,0 +1,25 @@
+matrix_scan_DEFS := -DIGNORE_ATOMIC_BLOCK
+matrix_scan_CONFIG := $(QUANTUM_PATH)/matrix/tests/config_mock.h
+
+matrix_scan_SRC := \
+	$(QUANTUM_PATH)/matrix/tests/mock.c \
+	$(QUANTUM_PATH)/matrix/tests/matrix_tests.cpp \
+	$(QUANTUM_PATH)/matrix.c
+
+matrix_scan_port_reads_DEFS := -DIGNORE_ATOMIC_BLOCK -DMATRIX_BATCH_PORT_READS
+matrix_scan_port_reads_CONFIG := $(QUANTUM_PATH)/matrix/tests/config_mock.h
+
+matrix_scan_port_reads_SRC := \
+	$(QUANTUM_PATH)/matrix/tests/mock.c \
+	$(QUANTUM_PATH)/matrix/tests/matrix_tests.cpp \
+	$(QUANTUM_PATH)/matrix.c
+
+matrix_scan_adaptive_delay_DEFS := -DIGNORE_ATOMIC_BLOCK -DMATRIX_IO_DELAY_ADAPTIVE
+matrix_scan_adaptive_delay_CONFIG := $(QUANTUM_PATH)/matrix/tests/config_mock.h
+
+matrix_scan_adaptive_delay_SRC := \
+	platforms/test/timer.c \
+	$(QUANTUM_PATH)/matrix/tests/mock.c \
+	$(QUANTUM_PATH)/matrix/tests/matrix_tests.cpp \
+	$(QUANTUM_PATH)/matrix/tests/matrix_tests_adaptive_delay.cpp \
+	$(QUANTUM_PATH)/matrix.c
@@ -0,0 +1,4 @@
+TEST_LIST += \
+	matrix_scan \
+	matrix_scan_port_reads \
+	matrix_scan_adaptive_delay
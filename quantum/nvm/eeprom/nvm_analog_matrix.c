@@ -0,0 +1,40 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "compiler_support.h"
+#include "eeprom.h"
+#include "nvm_analog_matrix.h"
+#include "nvm_eeprom_eeconfig_internal.h"
+
+// Bump when the layout of analog_key_config_t changes, so stale settings are not applied.
+#define ANALOG_MATRIX_NVM_MAGIC (uint16_t)0xA7C1
+
+#define ANALOG_MATRIX_NVM_MAGIC_ADDR ((uint16_t *)EECONFIG_ANALOG_MATRIX)
+#define ANALOG_MATRIX_NVM_KEYS_ADDR (EECONFIG_ANALOG_MATRIX + sizeof(uint16_t))
+
+// The per-key settings sit at the end of eeconfig, so they are the first thing to overflow a small EEPROM.
+STATIC_ASSERT((EECONFIG_SIZE) <= (TOTAL_EEPROM_BYTE_COUNT), "Analog matrix settings do not fit in the EEPROM, reduce the matrix size or pick a larger EEPROM driver");
+
+static void *key_addr(uint8_t row, uint8_t col) {
+    return (void *)(ANALOG_MATRIX_NVM_KEYS_ADDR + ((row * MATRIX_COLS) + col) * sizeof(analog_key_config_t));
+}
+
+void nvm_analog_matrix_erase(void) {
+    eeprom_update_word(ANALOG_MATRIX_NVM_MAGIC_ADDR, 0xFFFF);
+}
+
+bool nvm_analog_matrix_is_valid(void) {
+    return eeprom_read_word(ANALOG_MATRIX_NVM_MAGIC_ADDR) == ANALOG_MATRIX_NVM_MAGIC;
+}
+
+void nvm_analog_matrix_set_valid(void) {
+    eeprom_update_word(ANALOG_MATRIX_NVM_MAGIC_ADDR, ANALOG_MATRIX_NVM_MAGIC);
+}
+
+void nvm_analog_matrix_read_key(uint8_t row, uint8_t col, analog_key_config_t *config) {
+    eeprom_read_block(config, key_addr(row, col), sizeof(analog_key_config_t));
+}
+
+void nvm_analog_matrix_update_key(uint8_t row, uint8_t col, const analog_key_config_t *config) {
+    eeprom_update_block(config, key_addr(row, col), sizeof(analog_key_config_t));
+}
@@ -45,40 +45,114 @@
 #    include "connection.h"
 #endif
 
+#ifdef EECONFIG_SNAPSHOT_ENABLE
+// RAM copy of the core eeconfig block, filled by a single bulk read the first time any of it is needed. Updates are
+// written through to the EEPROM, and skipped entirely when the copy shows the value is unchanged.
+static uint8_t eeconfig_snapshot[EECONFIG_BASE_SIZE];
+static bool    eeconfig_snapshot_loaded = false;
+
+static uint8_t *snapshot_at(const void *addr) {
+    if (!eeconfig_snapshot_loaded) {
+        eeprom_read_block(eeconfig_snapshot, (const void *)0, sizeof(eeconfig_snapshot));
+        eeconfig_snapshot_loaded = true;
+    }
+    return &eeconfig_snapshot[(uintptr_t)addr];
+}
+
+static void core_read_block(void *buf, const void *addr, size_t len) {
+    memcpy(buf, snapshot_at(addr), len);
+}
+
+static void core_update_block(const void *buf, void *addr, size_t len) {
+    uint8_t *cached = snapshot_at(addr);
+    if (memcmp(cached, buf, len) != 0) {
+        memcpy(cached, buf, len);
+        eeprom_update_block(buf, addr, len);
+    }
+}
+
+static uint8_t core_read_byte(const uint8_t *addr) {
+    return *snapshot_at(addr);
+}
+
+static uint16_t core_read_word(const uint16_t *addr) {
+    uint16_t val;
+    core_read_block(&val, addr, sizeof(val));
+    return val;
+}
+
+static uint32_t core_read_dword(const uint32_t *addr) {
+    uint32_t val;
+    core_read_block(&val, addr, sizeof(val));
+    return val;
+}
+
+static void core_update_byte(uint8_t *addr, uint8_t val) {
+    core_update_block(&val, addr, sizeof(val));
+}
+
+static void core_update_word(uint16_t *addr, uint16_t val) {
+    core_update_block(&val, addr, sizeof(val));
+}
+
+static void core_update_dword(uint32_t *addr, uint32_t val) {
+    core_update_block(&val, addr, sizeof(val));
+}
+
+static void nvm_eeconfig_snapshot_invalidate(void) {
+    eeconfig_snapshot_loaded = false;
+}
+#else
+#    define core_read_byte eeprom_read_byte
+#    define core_read_word eeprom_read_word
+#    define core_read_dword eeprom_read_dword
+#    define core_read_block eeprom_read_block
+#    define core_update_byte eeprom_update_byte
+#    define core_update_word eeprom_update_word
+#    define core_update_dword eeprom_update_dword
+#    define core_update_block eeprom_update_block
+#endif // EECONFIG_SNAPSHOT_ENABLE
+
 void nvm_eeconfig_erase(void) {
 #ifdef EEPROM_DRIVER
     eeprom_driver_format(false);
 #endif // EEPROM_DRIVER
+#ifdef EECONFIG_SNAPSHOT_ENABLE
+    nvm_eeconfig_snapshot_invalidate();
+#endif // EECONFIG_SNAPSHOT_ENABLE
 }
 
 bool nvm_eeconfig_is_enabled(void) {
-    return eeprom_read_word(EECONFIG_MAGIC) == EECONFIG_MAGIC_NUMBER;
+    return core_read_word(EECONFIG_MAGIC) == EECONFIG_MAGIC_NUMBER;
 }
 
 bool nvm_eeconfig_is_disabled(void) {
-    return eeprom_read_word(EECONFIG_MAGIC) == EECONFIG_MAGIC_NUMBER_OFF;
+    return core_read_word(EECONFIG_MAGIC) == EECONFIG_MAGIC_NUMBER_OFF;
 }
 
 void nvm_eeconfig_enable(void) {
-    eeprom_update_word(EECONFIG_MAGIC, EECONFIG_MAGIC_NUMBER);
+    core_update_word(EECONFIG_MAGIC, EECONFIG_MAGIC_NUMBER);
 }
 
 void nvm_eeconfig_disable(void) {
 #if defined(EEPROM_DRIVER)
     eeprom_driver_format(false);
 #endif
-    eeprom_update_word(EECONFIG_MAGIC, EECONFIG_MAGIC_NUMBER_OFF);
+#ifdef EECONFIG_SNAPSHOT_ENABLE
+    nvm_eeconfig_snapshot_invalidate();
+#endif // EECONFIG_SNAPSHOT_ENABLE
+    core_update_word(EECONFIG_MAGIC, EECONFIG_MAGIC_NUMBER_OFF);
 }
 
 void nvm_eeconfig_read_debug(debug_config_t *debug_config) {
-    debug_config->raw = eeprom_read_byte(EECONFIG_DEBUG);
+    debug_config->raw = core_read_byte(EECONFIG_DEBUG);
 }
 void nvm_eeconfig_update_debug(const debug_config_t *debug_config) {
-    eeprom_update_byte(EECONFIG_DEBUG, debug_config->raw);
+    core_update_byte(EECONFIG_DEBUG, debug_config->raw);
 }
 
 layer_state_t nvm_eeconfig_read_default_layer(void) {
-    uint8_t val = eeprom_read_byte(EECONFIG_DEFAULT_LAYER);
+    uint8_t val = core_read_byte(EECONFIG_DEFAULT_LAYER);
 #ifdef DEFAULT_LAYER_STATE_IS_VALUE_NOT_BITMASK
     // stored as a layer number, so convert back to bitmask
     return (layer_state_t)1 << val;
@@ -95,49 +169,49 @@ void nvm_eeconfig_update_default_layer(layer_state_t state) {
     // stored as 8-bit-wide bitmask, so write the value directly - handling truncation from 16/32 bit layer_state_t
     uint8_t val = (uint8_t)state;
 #endif
-    eeprom_update_byte(EECONFIG_DEFAULT_LAYER, val);
+    core_update_byte(EECONFIG_DEFAULT_LAYER, val);
 }
 
 void nvm_eeconfig_read_keymap(keymap_config_t *keymap_config) {
-    keymap_config->raw = eeprom_read_word(EECONFIG_KEYMAP);
+    keymap_config->raw = core_read_word(EECONFIG_KEYMAP);
 }
 void nvm_eeconfig_update_keymap(const keymap_config_t *keymap_config) {
-    eeprom_update_word(EECONFIG_KEYMAP, keymap_config->raw);
+    core_update_word(EECONFIG_KEYMAP, keymap_config->raw);
 }
 
 #ifdef AUDIO_ENABLE
 void nvm_eeconfig_read_audio(audio_config_t *audio_config) {
-    audio_config->raw = eeprom_read_byte(EECONFIG_AUDIO);
+    audio_config->raw = core_read_byte(EECONFIG_AUDIO);
 }
 void nvm_eeconfig_update_audio(const audio_config_t *audio_config) {
-    eeprom_update_byte(EECONFIG_AUDIO, audio_config->raw);
+    core_update_byte(EECONFIG_AUDIO, audio_config->raw);
 }
 #endif // AUDIO_ENABLE
 
 #ifdef UNICODE_COMMON_ENABLE
 void nvm_eeconfig_read_unicode_mode(unicode_config_t *unicode_config) {
-    unicode_config->raw = eeprom_read_byte(EECONFIG_UNICODEMODE);
+    unicode_config->raw = core_read_byte(EECONFIG_UNICODEMODE);
 }
 void nvm_eeconfig_update_unicode_mode(const unicode_config_t *unicode_config) {
-    eeprom_update_byte(EECONFIG_UNICODEMODE, unicode_config->raw);
+    core_update_byte(EECONFIG_UNICODEMODE, unicode_config->raw);
 }
 #endif // UNICODE_COMMON_ENABLE
 
 #ifdef BACKLIGHT_ENABLE
 void nvm_eeconfig_read_backlight(backlight_config_t *backlight_config) {
-    backlight_config->raw = eeprom_read_byte(EECONFIG_BACKLIGHT);
+    backlight_config->raw = core_read_byte(EECONFIG_BACKLIGHT);
 }
 void nvm_eeconfig_update_backlight(const backlight_config_t *backlight_config) {
-    eeprom_update_byte(EECONFIG_BACKLIGHT, backlight_config->raw);
+    core_update_byte(EECONFIG_BACKLIGHT, backlight_config->raw);
 }
 #endif // BACKLIGHT_ENABLE
 
 #ifdef STENO_ENABLE
 uint8_t nvm_eeconfig_read_steno_mode(void) {
-    return eeprom_read_byte(EECONFIG_STENOMODE);
+    return core_read_byte(EECONFIG_STENOMODE);
 }
 void nvm_eeconfig_update_steno_mode(uint8_t val) {
-    eeprom_update_byte(EECONFIG_STENOMODE, val);
+    core_update_byte(EECONFIG_STENOMODE, val);
 }
 #endif // STENO_ENABLE
 
@@ -146,80 +220,80 @@ void nvm_eeconfig_update_steno_mode(uint8_t val) {
 
 #ifdef RGB_MATRIX_ENABLE
 void nvm_eeconfig_read_rgb_matrix(rgb_config_t *rgb_matrix_config) {
-    eeprom_read_block(rgb_matrix_config, EECONFIG_RGB_MATRIX, sizeof(rgb_config_t));
+    core_read_block(rgb_matrix_config, EECONFIG_RGB_MATRIX, sizeof(rgb_config_t));
 }
 void nvm_eeconfig_update_rgb_matrix(const rgb_config_t *rgb_matrix_config) {
-    eeprom_update_block(rgb_matrix_config, EECONFIG_RGB_MATRIX, sizeof(rgb_config_t));
+    core_update_block(rgb_matrix_config, EECONFIG_RGB_MATRIX, sizeof(rgb_config_t));
 }
 #endif // RGB_MATRIX_ENABLE
 
 #ifdef LED_MATRIX_ENABLE
 void nvm_eeconfig_read_led_matrix(led_eeconfig_t *led_matrix_config) {
-    eeprom_read_block(led_matrix_config, EECONFIG_LED_MATRIX, sizeof(led_eeconfig_t));
+    core_read_block(led_matrix_config, EECONFIG_LED_MATRIX, sizeof(led_eeconfig_t));
 }
 void nvm_eeconfig_update_led_matrix(const led_eeconfig_t *led_matrix_config) {
-    eeprom_update_block(led_matrix_config, EECONFIG_LED_MATRIX, sizeof(led_eeconfig_t));
+    core_update_block(led_matrix_config, EECONFIG_LED_MATRIX, sizeof(led_eeconfig_t));
 }
 #endif // LED_MATRIX_ENABLE
 
 #ifdef RGBLIGHT_ENABLE
 void nvm_eeconfig_read_rgblight(rgblight_config_t *rgblight_config) {
-    rgblight_config->raw = eeprom_read_dword(EECONFIG_RGBLIGHT);
-    rgblight_config->raw |= ((uint64_t)eeprom_read_byte(EECONFIG_RGBLIGHT_EXTENDED) << 32);
+    rgblight_config->raw = core_read_dword(EECONFIG_RGBLIGHT);
+    rgblight_config->raw |= ((uint64_t)core_read_byte(EECONFIG_RGBLIGHT_EXTENDED) << 32);
 }
 void nvm_eeconfig_update_rgblight(const rgblight_config_t *rgblight_config) {
-    eeprom_update_dword(EECONFIG_RGBLIGHT, rgblight_config->raw & 0xFFFFFFFF);
-    eeprom_update_byte(EECONFIG_RGBLIGHT_EXTENDED, (rgblight_config->raw >> 32) & 0xFF);
+    core_update_dword(EECONFIG_RGBLIGHT, rgblight_config->raw & 0xFFFFFFFF);
+    core_update_byte(EECONFIG_RGBLIGHT_EXTENDED, (rgblight_config->raw >> 32) & 0xFF);
 }
 #endif // RGBLIGHT_ENABLE
 
 #if (EECONFIG_KB_DATA_SIZE) == 0
 uint32_t nvm_eeconfig_read_kb(void) {
-    return eeprom_read_dword(EECONFIG_KEYBOARD);
+    return core_read_dword(EECONFIG_KEYBOARD);
 }
 void nvm_eeconfig_update_kb(uint32_t val) {
-    eeprom_update_dword(EECONFIG_KEYBOARD, val);
+    core_update_dword(EECONFIG_KEYBOARD, val);
 }
 #endif // (EECONFIG_KB_DATA_SIZE) == 0
 
 #if (EECONFIG_USER_DATA_SIZE) == 0
 uint32_t nvm_eeconfig_read_user(void) {
-    return eeprom_read_dword(EECONFIG_USER);
+    return core_read_dword(EECONFIG_USER);
 }
 void nvm_eeconfig_update_user(uint32_t val) {
-    eeprom_update_dword(EECONFIG_USER, val);
+    core_update_dword(EECONFIG_USER, val);
 }
 #endif // (EECONFIG_USER_DATA_SIZE) == 0
 
 #ifdef HAPTIC_ENABLE
 void nvm_eeconfig_read_haptic(haptic_config_t *haptic_config) {
-    haptic_config->raw = eeprom_read_dword(EECONFIG_HAPTIC);
+    haptic_config->raw = core_read_dword(EECONFIG_HAPTIC);
 }
 void nvm_eeconfig_update_haptic(const haptic_config_t *haptic_config) {
-    eeprom_update_dword(EECONFIG_HAPTIC, haptic_config->raw);
+    core_update_dword(EECONFIG_HAPTIC, haptic_config->raw);
 }
 #endif // HAPTIC_ENABLE
 
 #ifdef CONNECTION_ENABLE
 void nvm_eeconfig_read_connection(connection_config_t *config) {
-    config->raw = eeprom_read_byte(EECONFIG_CONNECTION);
+    config->raw = core_read_byte(EECONFIG_CONNECTION);
 }
 void nvm_eeconfig_update_connection(const connection_config_t *config) {
-    eeprom_update_byte(EECONFIG_CONNECTION, config->raw);
+    core_update_byte(EECONFIG_CONNECTION, config->raw);
 }
 #endif // CONNECTION_ENABLE
 
 bool nvm_eeconfig_read_handedness(void) {
-    return !!eeprom_read_byte(EECONFIG_HANDEDNESS);
+    return !!core_read_byte(EECONFIG_HANDEDNESS);
 }
 void nvm_eeconfig_update_handedness(bool val) {
-    eeprom_update_byte(EECONFIG_HANDEDNESS, !!val);
+    core_update_byte(EECONFIG_HANDEDNESS, !!val);
 }
 
 #if (EECONFIG_KB_DATA_SIZE) > 0
 
 bool nvm_eeconfig_is_kb_datablock_valid(void) {
-    return eeprom_read_dword(EECONFIG_KEYBOARD) == (EECONFIG_KB_DATA_VERSION);
+    return core_read_dword(EECONFIG_KEYBOARD) == (EECONFIG_KB_DATA_VERSION);
 }
 
 uint32_t nvm_eeconfig_read_kb_datablock(void *data, uint32_t offset, uint32_t length) {
@@ -235,7 +309,7 @@ uint32_t nvm_eeconfig_read_kb_datablock(void *data, uint32_t offset, uint32_t le
 }
 
 uint32_t nvm_eeconfig_update_kb_datablock(const void *data, uint32_t offset, uint32_t length) {
-    eeprom_update_dword(EECONFIG_KEYBOARD, (EECONFIG_KB_DATA_VERSION));
+    core_update_dword(EECONFIG_KEYBOARD, (EECONFIG_KB_DATA_VERSION));
 
     void *ee_start = (void *)(uintptr_t)(EECONFIG_KB_DATABLOCK + offset);
     void *ee_end   = (void *)(uintptr_t)(EECONFIG_KB_DATABLOCK + MIN(EECONFIG_KB_DATA_SIZE, offset + length));
@@ -244,7 +318,7 @@ uint32_t nvm_eeconfig_update_kb_datablock(const void *data, uint32_t offset, uin
 }
 
 void nvm_eeconfig_init_kb_datablock(void) {
-    eeprom_update_dword(EECONFIG_KEYBOARD, (EECONFIG_KB_DATA_VERSION));
+    core_update_dword(EECONFIG_KEYBOARD, (EECONFIG_KB_DATA_VERSION));
 
     void   *start     = (void *)(uintptr_t)(EECONFIG_KB_DATABLOCK);
     void   *end       = (void *)(uintptr_t)(EECONFIG_KB_DATABLOCK + EECONFIG_KB_DATA_SIZE);
@@ -263,7 +337,7 @@ void nvm_eeconfig_init_kb_datablock(void) {
 #if (EECONFIG_USER_DATA_SIZE) > 0
 
 bool nvm_eeconfig_is_user_datablock_valid(void) {
-    return eeprom_read_dword(EECONFIG_USER) == (EECONFIG_USER_DATA_VERSION);
+    return core_read_dword(EECONFIG_USER) == (EECONFIG_USER_DATA_VERSION);
 }
 
 uint32_t nvm_eeconfig_read_user_datablock(void *data, uint32_t offset, uint32_t length) {
@@ -279,7 +353,7 @@ uint32_t nvm_eeconfig_read_user_datablock(void *data, uint32_t offset, uint32_t
 }
 
 uint32_t nvm_eeconfig_update_user_datablock(const void *data, uint32_t offset, uint32_t length) {
-    eeprom_update_dword(EECONFIG_USER, (EECONFIG_USER_DATA_VERSION));
+    core_update_dword(EECONFIG_USER, (EECONFIG_USER_DATA_VERSION));
 
     void *ee_start = (void *)(uintptr_t)(EECONFIG_USER_DATABLOCK + offset);
     void *ee_end   = (void *)(uintptr_t)(EECONFIG_USER_DATABLOCK + MIN(EECONFIG_USER_DATA_SIZE, offset + length));
@@ -288,7 +362,7 @@ uint32_t nvm_eeconfig_update_user_datablock(const void *data, uint32_t offset, u
 }
 
 void nvm_eeconfig_init_user_datablock(void) {
-    eeprom_update_dword(EECONFIG_USER, (EECONFIG_USER_DATA_VERSION));
+    core_update_dword(EECONFIG_USER, (EECONFIG_USER_DATA_VERSION));
 
     void   *start     = (void *)(uintptr_t)(EECONFIG_USER_DATABLOCK);
     void   *end       = (void *)(uintptr_t)(EECONFIG_USER_DATABLOCK + EECONFIG_USER_DATA_SIZE);
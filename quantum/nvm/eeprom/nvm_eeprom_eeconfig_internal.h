@@ -57,7 +57,16 @@ typedef struct PACKED {
 #define EECONFIG_KB_DATABLOCK ((uint8_t *)(EECONFIG_BASE_SIZE))
 #define EECONFIG_USER_DATABLOCK ((uint8_t *)((EECONFIG_BASE_SIZE) + (EECONFIG_KB_DATA_SIZE)))
 
+// Per-key analog matrix settings, preceded by a magic word
+#ifdef ANALOG_MATRIX_ENABLE
+#    include "analog_matrix.h"
+#    define EECONFIG_ANALOG_MATRIX_DATA_SIZE (sizeof(uint16_t) + sizeof(analog_key_config_t) * (MATRIX_ROWS) * (MATRIX_COLS))
+#else
+#    define EECONFIG_ANALOG_MATRIX_DATA_SIZE 0
+#endif // ANALOG_MATRIX_ENABLE
+#define EECONFIG_ANALOG_MATRIX ((uint8_t *)((EECONFIG_BASE_SIZE) + (EECONFIG_KB_DATA_SIZE) + (EECONFIG_USER_DATA_SIZE)))
+
 // Size of EEPROM being used, other code can refer to this for available EEPROM
-#define EECONFIG_SIZE ((EECONFIG_BASE_SIZE) + (EECONFIG_KB_DATA_SIZE) + (EECONFIG_USER_DATA_SIZE))
+#define EECONFIG_SIZE ((EECONFIG_BASE_SIZE) + (EECONFIG_KB_DATA_SIZE) + (EECONFIG_USER_DATA_SIZE) + (EECONFIG_ANALOG_MATRIX_DATA_SIZE))
 
-STATIC_ASSERT((intptr_t)EECONFIG_HANDEDNESS == 14, "EEPROM handedness offset is incorrect");
+STATIC_ASSERT(offsetof(eeprom_core_t, handedness) == 14, "EEPROM handedness offset is incorrect");
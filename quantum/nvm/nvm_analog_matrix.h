@@ -0,0 +1,15 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "analog_matrix.h"
+
+void nvm_analog_matrix_erase(void);
+
+bool nvm_analog_matrix_is_valid(void);
+void nvm_analog_matrix_set_valid(void);
+
+void nvm_analog_matrix_read_key(uint8_t row, uint8_t col, analog_key_config_t *config);
+void nvm_analog_matrix_update_key(uint8_t row, uint8_t col, const analog_key_config_t *config);
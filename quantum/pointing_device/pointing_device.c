@@ -25,6 +25,10 @@
 #    include "mousekey.h"
 #endif
 
+#if defined(ENCODER_MAP_ENABLE) && defined(ENCODER_MAP_COALESCE_SCROLL)
+#    include "encoder.h"
+#endif
+
 #ifdef POINTING_DEVICE_HIRES_SCROLL_ENABLE
 #    include "usb_descriptor_common.h"
 #endif
@@ -288,6 +292,109 @@ report_mouse_t pointing_device_adjust_by_defines(report_mouse_t mouse_report) {
     return mouse_report;
 }
 
+#ifdef POINTING_DEVICE_ACCUMULATE_ENABLE
+typedef struct {
+    int32_t  x;
+    int32_t  y;
+    int32_t  h;
+    int32_t  v;
+    uint8_t  buttons; // sensor button state at the last sample
+    uint8_t  next;    // sensor button state to send with the next report
+    uint8_t  changed; // buttons that already have an edge waiting for the next report
+    uint32_t last_sample;
+} pointing_device_accumulator_t;
+
+static pointing_device_accumulator_t accumulator = {};
+
+/**
+ * @brief Samples the local sensor and adds its motion to the accumulator
+ *
+ * Called on every pointing device task iteration, independent of POINTING_DEVICE_TASK_THROTTLE_MS, so the sensor is
+ * read at up to POINTING_DEVICE_SAMPLE_INTERVAL_US while reports still go out at the throttled rate. Each button gets at
+ * most one edge per report, so a click shorter than a report period is sent as a press and then a release; a further
+ * edge of the same button is left to the report after.
+ */
+static void pointing_device_accumulate(void) {
+#    if defined(SPLIT_POINTING_ENABLE)
+    if (!(POINTING_DEVICE_THIS_SIDE)) {
+        return;
+    }
+#    endif
+#    if (POINTING_DEVICE_SAMPLE_INTERVAL_US > 0)
+    if (timer_elapsed_us32(accumulator.last_sample) < POINTING_DEVICE_SAMPLE_INTERVAL_US) {
+        return;
+    }
+    accumulator.last_sample = timer_read_us32();
+#    endif
+#    ifdef POINTING_DEVICE_MOTION_PIN
+#        ifdef POINTING_DEVICE_MOTION_PIN_ACTIVE_LOW
+    if (gpio_read_pin(POINTING_DEVICE_MOTION_PIN)) {
+        return;
+    }
+#        else
+    if (!gpio_read_pin(POINTING_DEVICE_MOTION_PIN)) {
+        return;
+    }
+#        endif
+#    endif
+
+    report_mouse_t sample = {.buttons = accumulator.buttons};
+    sample                = pointing_device_driver->get_report(sample);
+
+    accumulator.x += sample.x;
+    accumulator.y += sample.y;
+    accumulator.h += sample.h;
+    accumulator.v += sample.v;
+
+    uint8_t fresh = (sample.buttons ^ accumulator.buttons) & ~accumulator.changed;
+    accumulator.next ^= fresh;
+    accumulator.changed |= fresh;
+    accumulator.buttons = sample.buttons;
+}
+
+static inline int32_t pointing_device_drain_axis(int32_t *accumulated, int32_t min, int32_t max) {
+    int32_t value = *accumulated < min ? min : (*accumulated > max ? max : *accumulated);
+    *accumulated -= value;
+    return value;
+}
+
+/**
+ * @brief Builds a single report from the motion accumulated since the previous one
+ *
+ * Motion that doesn't fit into the report is carried over to the next one instead of being clamped away, and so is a
+ * button whose sensor state has changed again since its edge was queued.
+ *
+ * @param[in] mouse_report report_mouse_t holding the current button state
+ * @return report_mouse_t with the accumulated motion and button changes applied
+ */
+static report_mouse_t pointing_device_drain_accumulator(report_mouse_t mouse_report) {
+    mouse_report.x       = pointing_device_drain_axis(&accumulator.x, MOUSE_REPORT_XY_MIN, MOUSE_REPORT_XY_MAX);
+    mouse_report.y       = pointing_device_drain_axis(&accumulator.y, MOUSE_REPORT_XY_MIN, MOUSE_REPORT_XY_MAX);
+    mouse_report.h       = pointing_device_drain_axis(&accumulator.h, MOUSE_REPORT_HV_MIN, MOUSE_REPORT_HV_MAX);
+    mouse_report.v       = pointing_device_drain_axis(&accumulator.v, MOUSE_REPORT_HV_MIN, MOUSE_REPORT_HV_MAX);
+    mouse_report.buttons = (mouse_report.buttons & ~accumulator.changed) | (accumulator.next & accumulator.changed);
+
+    // Buttons whose sensor state differs from what was just sent start the next report with an edge
+    accumulator.changed = accumulator.next ^ accumulator.buttons;
+    accumulator.next    = accumulator.buttons;
+    return mouse_report;
+}
+#endif
+
+/**
+ * @brief Reads the local sensor into a mouse report
+ *
+ * @param[in] mouse_report report_mouse_t to be updated
+ * @return report_mouse_t updated by the driver, or with the accumulated motion when POINTING_DEVICE_ACCUMULATE_ENABLE is defined
+ */
+static inline report_mouse_t pointing_device_read_sensor(report_mouse_t mouse_report) {
+#ifdef POINTING_DEVICE_ACCUMULATE_ENABLE
+    return pointing_device_drain_accumulator(mouse_report);
+#else
+    return pointing_device_driver->get_report(mouse_report);
+#endif
+}
+
 /**
  * @brief Retrieves and processes pointing device data.
  *
@@ -303,6 +410,12 @@ __attribute__((weak)) bool pointing_device_task(void) {
     };
 #endif
 
+#ifdef POINTING_DEVICE_ACCUMULATE_ENABLE
+    if (pointing_device_get_status() == POINTING_DEVICE_STATUS_SUCCESS) {
+        pointing_device_accumulate();
+    }
+#endif
+
 #if (POINTING_DEVICE_TASK_THROTTLE_MS > 0)
     static uint32_t last_exec = 0;
     if (timer_elapsed32(last_exec) < POINTING_DEVICE_TASK_THROTTLE_MS) {
@@ -320,6 +433,9 @@ __attribute__((weak)) bool pointing_device_task(void) {
 #    if defined(SPLIT_POINTING_ENABLE)
 #        error POINTING_DEVICE_MOTION_PIN not supported when sharing the pointing device report between sides.
 #    endif
+#endif
+    // When accumulating, the motion pin gates sampling instead, so leftover motion is still drained while it's inactive
+#if defined(POINTING_DEVICE_MOTION_PIN) && !defined(POINTING_DEVICE_ACCUMULATE_ENABLE)
 #    ifdef POINTING_DEVICE_MOTION_PIN_ACTIVE_LOW
     if (!gpio_read_pin(POINTING_DEVICE_MOTION_PIN))
 #    else
@@ -332,18 +448,18 @@ __attribute__((weak)) bool pointing_device_task(void) {
 #    if defined(POINTING_DEVICE_COMBINED)
         static uint8_t old_buttons = 0;
         local_mouse_report.buttons = old_buttons;
-        local_mouse_report         = pointing_device_driver->get_report(local_mouse_report);
+        local_mouse_report         = pointing_device_read_sensor(local_mouse_report);
         old_buttons                = local_mouse_report.buttons;
 #    elif defined(POINTING_DEVICE_LEFT) || defined(POINTING_DEVICE_RIGHT)
-        local_mouse_report = POINTING_DEVICE_THIS_SIDE ? pointing_device_driver->get_report(local_mouse_report) : shared_mouse_report;
+        local_mouse_report = POINTING_DEVICE_THIS_SIDE ? pointing_device_read_sensor(local_mouse_report) : shared_mouse_report;
 #    else
 #        error "You need to define the side(s) the pointing device is on. POINTING_DEVICE_COMBINED / POINTING_DEVICE_LEFT / POINTING_DEVICE_RIGHT"
 #    endif
 #else
-    local_mouse_report = pointing_device_driver->get_report(local_mouse_report);
+    local_mouse_report = pointing_device_read_sensor(local_mouse_report);
 #endif // defined(SPLIT_POINTING_ENABLE)
 
-#ifdef POINTING_DEVICE_MOTION_PIN
+#if defined(POINTING_DEVICE_MOTION_PIN) && !defined(POINTING_DEVICE_ACCUMULATE_ENABLE)
     }
 #endif
 
@@ -359,6 +475,9 @@ __attribute__((weak)) bool pointing_device_task(void) {
     local_mouse_report = is_keyboard_left() ? pointing_device_task_combined_kb(local_mouse_report, shared_mouse_report) : pointing_device_task_combined_kb(shared_mouse_report, local_mouse_report);
 #else
     local_mouse_report = pointing_device_adjust_by_defines(local_mouse_report);
+#endif
+#if defined(ENCODER_MAP_ENABLE) && defined(ENCODER_MAP_COALESCE_SCROLL)
+    local_mouse_report = encoder_map_scroll_report(local_mouse_report);
 #endif
     local_mouse_report = pointing_device_task_modules(local_mouse_report);
     local_mouse_report = pointing_device_task_kb(local_mouse_report);
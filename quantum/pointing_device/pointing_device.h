@@ -140,6 +140,15 @@ void           pointing_device_keycode_handler(uint16_t keycode, bool pressed);
 uint16_t pointing_device_get_hires_scroll_resolution(void);
 #endif
 
+#ifdef POINTING_DEVICE_ACCUMULATE_ENABLE
+#    if !defined(POINTING_DEVICE_TASK_THROTTLE_MS)
+#        define POINTING_DEVICE_TASK_THROTTLE_MS 1
+#    endif
+#    if !defined(POINTING_DEVICE_SAMPLE_INTERVAL_US)
+#        define POINTING_DEVICE_SAMPLE_INTERVAL_US 0
+#    endif
+#endif
+
 #if defined(SPLIT_POINTING_ENABLE)
 void     pointing_device_set_shared_report(report_mouse_t report);
 uint16_t pointing_device_get_shared_cpi(void);
@@ -180,6 +180,9 @@ static bool autoshift_press(uint16_t keycode, uint16_t now, keyrecord_t *record)
     // Store record to be sent to user functions if there's no release record then.
     autoshift_lastrecord            = *record;
     autoshift_lastrecord.event.time = 0;
+#ifdef KEYEVENT_TIME_US
+    autoshift_lastrecord.event.time_us = 0;
+#endif
     // clang-format off
 #if defined(AUTO_SHIFT_REPEAT) || defined(AUTO_SHIFT_REPEAT_PER_KEY)
     if (keycode == autoshift_lastkey &&
@@ -19,9 +19,13 @@
 #include "process_dynamic_macro.h"
 #include <stddef.h>
 #include "action_layer.h"
+#include "keyboard.h"
+#include "matrix.h"
 #include "keycodes.h"
 #include "debug.h"
 #include "wait.h"
+#include "timer.h"
+#include "util.h"
 
 #ifdef BACKLIGHT_ENABLE
 #    include "backlight.h"
@@ -82,6 +86,36 @@ __attribute__((weak)) bool dynamic_macro_valid_key_user(uint16_t keycode, keyrec
     return true;
 }
 
+/* Recorded events are stored in a packed byte stream instead of as
+ * whole keyrecord_t structs. Each event starts with a header byte:
+ *
+ *   bit 7     - pressed
+ *   bit 6     - key position follows (row, col); omitted if unchanged
+ *   bit 5     - tap state follows (one byte)
+ *   bit 4     - keycode follows (two bytes, little endian)
+ *   bits 0..3 - event type
+ *
+ * followed by the optional fields and the time since the previous
+ * event as a varint (7 bits per byte, low bits first).
+ *
+ * The event type DYNAMIC_MACRO_EVENT_REPEAT is used for repeated taps:
+ * it is followed by a single count byte, and stands for that many
+ * repetitions of the preceding press/release pair.
+ */
+#define DYNAMIC_MACRO_EVENT_PRESSED 0x80
+#define DYNAMIC_MACRO_EVENT_KEYPOS 0x40
+#define DYNAMIC_MACRO_EVENT_TAP 0x20
+#define DYNAMIC_MACRO_EVENT_KEYCODE 0x10
+#define DYNAMIC_MACRO_EVENT_TYPE_MASK 0x0F
+#define DYNAMIC_MACRO_EVENT_REPEAT 0x0F
+
+/* Largest encoded event: header, row, col, tap, keycode and a 16-bit varint. */
+#define DYNAMIC_MACRO_MAX_EVENT_SIZE 9
+
+#if defined(COMBO_ENABLE) || defined(REPEAT_KEY_ENABLE)
+#    define DYNAMIC_MACRO_HAS_KEYCODE
+#endif
+
 /* Convenience macros used for retrieving the debug info. All of them
  * need a `direction` variable accessible at the call site.
  */
@@ -94,13 +128,316 @@ static layer_state_t dm1_layer_state;
 static layer_state_t dm2_layer_state;
 #endif
 
+/* State shared by the encoder and the decoder, so both agree on what
+ * the previous event and the last press/release pair were. */
+typedef struct {
+    keyrecord_t last;
+    bool        has_last;
+    keyrecord_t pair_press;
+    keyrecord_t pair_release;
+    uint16_t    pair_press_delta;
+    uint16_t    pair_release_delta;
+    bool        has_pair;
+} dynamic_macro_stream_t;
+
+static bool dynamic_macro_same_event(const keyrecord_t *a, const keyrecord_t *b) {
+    return a->event.type == b->event.type && a->event.pressed == b->event.pressed && KEYEQ(a->event.key, b->event.key)
+#ifndef NO_ACTION_TAPPING
+           && a->tap.count == b->tap.count && a->tap.interrupted == b->tap.interrupted
+#endif
+#ifdef DYNAMIC_MACRO_HAS_KEYCODE
+           && a->keycode == b->keycode
+#endif
+        ;
+}
+
+static void dynamic_macro_stream_push(dynamic_macro_stream_t *stream, const keyrecord_t *record, uint16_t delta) {
+    stream->has_pair = false;
+    if (stream->has_last && stream->last.event.pressed && !record->event.pressed && stream->last.event.type == record->event.type && KEYEQ(stream->last.event.key, record->event.key)) {
+        stream->pair_press         = stream->last;
+        stream->pair_release       = *record;
+        stream->pair_release_delta = delta;
+        stream->has_pair           = true;
+    } else if (record->event.pressed) {
+        stream->pair_press_delta = delta;
+    }
+    stream->last     = *record;
+    stream->has_last = true;
+}
+
+/* Recording state */
+static dynamic_macro_stream_t record_stream;
+static keyrecord_t            pending_press;
+static bool                   has_pending_press;
+static uint8_t               *repeat_count;
+static uint8_t               *last_release_end;
+/* Keys pressed but not yet released in the recording, and the end of
+ * the last event that left none of them held. */
+static uint8_t  keys_held;
+static uint8_t *last_idle_end;
+/* Set once an event did not fit, after which nothing more is written,
+ * so a smaller release can't be stored without its press. */
+static bool is_full;
+
+/**
+ * Write raw bytes into the macro buffer, if they fit before the other macro.
+ */
+static bool dynamic_macro_write(uint8_t **macro_pointer, uint8_t *macro2_end, int8_t direction, const uint8_t *data, uint8_t size) {
+    /* The other end of the other macro is the last buffer element it
+     * is safe to use before overwriting the other macro.
+     */
+    if (is_full || direction * (macro2_end - *macro_pointer) + 1 < size) {
+        is_full = true;
+        return false;
+    }
+    for (uint8_t i = 0; i < size; i++) {
+        **macro_pointer = data[i];
+        *macro_pointer += direction;
+    }
+    return true;
+}
+
+static bool dynamic_macro_write_event(uint8_t **macro_pointer, uint8_t *macro2_end, int8_t direction, const keyrecord_t *record) {
+    uint8_t  data[DYNAMIC_MACRO_MAX_EVENT_SIZE];
+    uint8_t  size   = 1;
+    uint16_t delta  = record_stream.has_last ? (uint16_t)(record->event.time - record_stream.last.event.time) : 0;
+    uint8_t  header = record->event.type & DYNAMIC_MACRO_EVENT_TYPE_MASK;
+
+    if (record->event.pressed) {
+        header |= DYNAMIC_MACRO_EVENT_PRESSED;
+    }
+    if (!record_stream.has_last || !KEYEQ(record->event.key, record_stream.last.event.key)) {
+        header |= DYNAMIC_MACRO_EVENT_KEYPOS;
+        data[size++] = record->event.key.row;
+        data[size++] = record->event.key.col;
+    }
+#ifndef NO_ACTION_TAPPING
+    if (record->tap.count || record->tap.interrupted) {
+        header |= DYNAMIC_MACRO_EVENT_TAP;
+        data[size++] = (record->tap.count << 4) | (record->tap.interrupted ? 1 : 0);
+    }
+#endif
+#ifdef DYNAMIC_MACRO_HAS_KEYCODE
+    if (record->keycode) {
+        header |= DYNAMIC_MACRO_EVENT_KEYCODE;
+        data[size++] = record->keycode & 0xFF;
+        data[size++] = record->keycode >> 8;
+    }
+#endif
+    uint16_t value = delta;
+    do {
+        data[size] = value & 0x7F;
+        value >>= 7;
+        if (value) {
+            data[size] |= 0x80;
+        }
+        size++;
+    } while (value);
+    data[0] = header;
+
+    if (!dynamic_macro_write(macro_pointer, macro2_end, direction, data, size)) {
+        return false;
+    }
+    dynamic_macro_stream_push(&record_stream, record, delta);
+    repeat_count = NULL;
+    if (record->event.pressed) {
+        keys_held++;
+    } else {
+        last_release_end = *macro_pointer;
+        if (keys_held > 0) {
+            keys_held--;
+        }
+    }
+    if (keys_held == 0) {
+        last_idle_end = *macro_pointer;
+    }
+    return true;
+}
+
+static bool dynamic_macro_write_repeat(uint8_t **macro_pointer, uint8_t *macro2_end, int8_t direction, const keyrecord_t *record) {
+    if (repeat_count && *repeat_count < UINT8_MAX) {
+        ++*repeat_count;
+    } else {
+        uint8_t data[2] = {DYNAMIC_MACRO_EVENT_REPEAT, 1};
+        if (!dynamic_macro_write(macro_pointer, macro2_end, direction, data, sizeof(data))) {
+            return false;
+        }
+        repeat_count     = *macro_pointer - direction;
+        last_release_end = *macro_pointer;
+        if (keys_held == 0) {
+            last_idle_end = *macro_pointer;
+        }
+    }
+    /* Repeats replay with the timing of the first tap, so only keep the
+     * following delta short. */
+    record_stream.last.event.time = record->event.time;
+    return true;
+}
+
+/* Playback state */
+typedef struct {
+    uint8_t               *pointer;
+    uint8_t               *end;
+    int8_t                 direction;
+    uint8_t                repeats_left;
+    bool                   repeat_release;
+    uint16_t               time;
+    layer_state_t          saved_layer_state;
+    layer_state_t          macro_layers; // layers switched by the macro itself
+    matrix_row_t           held[MATRIX_ROWS]; // keys pressed by the macro and not released yet
+    dynamic_macro_stream_t stream;
+} dynamic_macro_player_t;
+
+/* One player per macro, so a macro can play the other one. */
+static dynamic_macro_player_t players[2];
+static uint8_t                players_active = 0;
+#ifdef DYNAMIC_MACRO_DELAY
+static uint16_t last_played = 0;
+#endif
+
+static inline uint8_t dynamic_macro_read(dynamic_macro_player_t *player) {
+    uint8_t value = *player->pointer;
+    player->pointer += player->direction;
+    return value;
+}
+
+/**
+ * Decode the next event of a macro being played.
+ *
+ * @return false once the end of the macro has been reached
+ */
+static bool dynamic_macro_next_event(dynamic_macro_player_t *player, keyrecord_t *record) {
+    if (player->repeats_left == 0 && player->pointer != player->end && (*player->pointer & DYNAMIC_MACRO_EVENT_TYPE_MASK) == DYNAMIC_MACRO_EVENT_REPEAT) {
+        dynamic_macro_read(player);
+        player->repeats_left   = dynamic_macro_read(player);
+        player->repeat_release = false;
+    }
+
+    if (player->repeats_left > 0 && player->stream.has_pair) {
+        if (!player->repeat_release) {
+            *record = player->stream.pair_press;
+            player->time += player->stream.pair_press_delta;
+        } else {
+            *record = player->stream.pair_release;
+            player->time += player->stream.pair_release_delta;
+            player->repeats_left--;
+        }
+        player->repeat_release = !player->repeat_release;
+        record->event.time     = player->time;
+#ifdef KEYEVENT_TIME_US
+        record->event.time_us = keyevent_time_us(player->time);
+#endif
+        return true;
+    }
+    player->repeats_left = 0;
+
+    if (player->pointer == player->end) {
+        return false;
+    }
+
+    uint8_t header = dynamic_macro_read(player);
+    *record        = (keyrecord_t){0};
+
+    record->event.type    = header & DYNAMIC_MACRO_EVENT_TYPE_MASK;
+    record->event.pressed = header & DYNAMIC_MACRO_EVENT_PRESSED;
+    if (header & DYNAMIC_MACRO_EVENT_KEYPOS) {
+        record->event.key.row = dynamic_macro_read(player);
+        record->event.key.col = dynamic_macro_read(player);
+    } else {
+        record->event.key = player->stream.last.event.key;
+    }
+    if (header & DYNAMIC_MACRO_EVENT_TAP) {
+        uint8_t tap = dynamic_macro_read(player);
+#ifndef NO_ACTION_TAPPING
+        record->tap.count       = tap >> 4;
+        record->tap.interrupted = tap & 1;
+#else
+        (void)tap;
+#endif
+    }
+    if (header & DYNAMIC_MACRO_EVENT_KEYCODE) {
+        uint16_t keycode = dynamic_macro_read(player);
+        keycode |= (uint16_t)dynamic_macro_read(player) << 8;
+#ifdef DYNAMIC_MACRO_HAS_KEYCODE
+        record->keycode = keycode;
+#else
+        (void)keycode;
+#endif
+    }
+    uint16_t delta = 0;
+    uint8_t  shift = 0;
+    uint8_t  byte;
+    do {
+        byte = dynamic_macro_read(player);
+        delta |= (uint16_t)(byte & 0x7F) << shift;
+        shift += 7;
+    } while (byte & 0x80);
+
+    player->time += delta;
+    record->event.time = player->time;
+#ifdef KEYEVENT_TIME_US
+    record->event.time_us = keyevent_time_us(player->time);
+#endif
+    dynamic_macro_stream_push(&player->stream, record, delta);
+    return true;
+}
+
+/**
+ * Process the next event of the innermost macro being played, or
+ * finish playing it.
+ */
+static void dynamic_macro_play_step(void) {
+    dynamic_macro_player_t *player = &players[players_active - 1];
+    keyrecord_t             record;
+
+    if (dynamic_macro_next_event(player, &record)) {
+        uint8_t row = record.event.key.row;
+        uint8_t col = record.event.key.col;
+        if (row < MATRIX_ROWS && col < MATRIX_COLS) {
+            if (record.event.pressed) {
+                player->held[row] |= MATRIX_ROW_SHIFTER << col;
+            } else {
+                player->held[row] &= ~(MATRIX_ROW_SHIFTER << col);
+            }
+        }
+
+        layer_state_t before = layer_state;
+        process_record(&record);
+        player->macro_layers |= before ^ layer_state;
+        return;
+    }
+
+    int8_t direction = player->direction;
+
+    /* Release what the macro left pressed, but not the keys the user
+     * holds: with DYNAMIC_MACRO_DELAY they may have been pressed during
+     * playback. */
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            if (player->held[row] & (MATRIX_ROW_SHIFTER << col)) {
+                record = (keyrecord_t){.event = MAKE_KEYEVENT(row, col, false)};
+                process_record(&record);
+            }
+        }
+    }
+
+    /* Only undo the layers the macro switched. With DYNAMIC_MACRO_DELAY
+     * the keyboard keeps running during playback, and layers the user
+     * changed meanwhile are left as they are. */
+    layer_state_set((layer_state & ~player->macro_layers) | (player->saved_layer_state & player->macro_layers));
+
+    players_active--;
+
+    dynamic_macro_play_kb(direction);
+}
+
 /**
  * Start recording of the dynamic macro.
  *
  * @param[out] macro_pointer The new macro buffer iterator.
  * @param[in]  macro_buffer  The macro buffer used to initialize macro_pointer.
  */
-void dynamic_macro_record_start(keyrecord_t **macro_pointer, keyrecord_t *macro_buffer, int8_t direction) {
+void dynamic_macro_record_start(uint8_t **macro_pointer, uint8_t *macro_buffer, int8_t direction) {
     dprintln("dynamic macro recording: started");
 
     dynamic_macro_record_start_kb(direction);
@@ -115,20 +452,43 @@ void dynamic_macro_record_start(keyrecord_t **macro_pointer, keyrecord_t *macro_
     layer_clear();
 #endif
     clear_keyboard();
-    *macro_pointer = macro_buffer;
+    *macro_pointer    = macro_buffer;
+    record_stream     = (dynamic_macro_stream_t){0};
+    has_pending_press = false;
+    repeat_count      = NULL;
+    last_release_end  = macro_buffer;
+    keys_held         = 0;
+    last_idle_end     = macro_buffer;
+    is_full           = false;
 }
 
 /**
  * Play the dynamic macro.
  *
+ * Without DYNAMIC_MACRO_DELAY the whole macro is played right away.
+ * Otherwise one event is played every DYNAMIC_MACRO_DELAY milliseconds
+ * from dynamic_macro_task(), instead of blocking until it's done.
+ *
  * @param macro_buffer[in] The beginning of the macro buffer being played.
  * @param macro_end[in]    The element after the last macro buffer element.
  * @param direction[in]    Either +1 or -1, which way to iterate the buffer.
  */
-void dynamic_macro_play(keyrecord_t *macro_buffer, keyrecord_t *macro_end, int8_t direction) {
+void dynamic_macro_play(uint8_t *macro_buffer, uint8_t *macro_end, int8_t direction) {
     dprintf("dynamic macro: slot %d playback\n", DYNAMIC_MACRO_CURRENT_SLOT());
 
-    layer_state_t saved_layer_state = layer_state;
+    if (players_active == ARRAY_SIZE(players)) {
+        dprintln("dynamic macro: ignoring recursive macro playback");
+        return;
+    }
+
+    dynamic_macro_player_t *player = &players[players_active];
+    *player                        = (dynamic_macro_player_t){
+                               .pointer           = macro_buffer,
+                               .end               = macro_end,
+                               .direction         = direction,
+                               .time              = timer_read(),
+                               .saved_layer_state = layer_state,
+    };
 
     clear_keyboard();
 #ifdef DYNAMIC_MACRO_KEEP_ORIGINAL_LAYER_STATE
@@ -140,66 +500,98 @@ void dynamic_macro_play(keyrecord_t *macro_buffer, keyrecord_t *macro_end, int8_
 #else
     layer_clear();
 #endif
+    player->macro_layers = player->saved_layer_state ^ layer_state;
 
-    while (macro_buffer != macro_end) {
-        process_record(macro_buffer);
-        macro_buffer += direction;
+    players_active++;
 #ifdef DYNAMIC_MACRO_DELAY
-        wait_ms(DYNAMIC_MACRO_DELAY);
-#endif
+    /* Play the first event on the next task run */
+    last_played = timer_read() - DYNAMIC_MACRO_DELAY;
+#else
+    uint8_t depth = players_active - 1;
+    while (players_active > depth) {
+        dynamic_macro_play_step();
     }
+#endif
+}
 
-    clear_keyboard();
-
-    layer_state_set(saved_layer_state);
-
-    dynamic_macro_play_kb(direction);
+/**
+ * Play pending macro events.
+ */
+void dynamic_macro_task(void) {
+#ifdef DYNAMIC_MACRO_DELAY
+    if (players_active > 0 && timer_elapsed(last_played) >= DYNAMIC_MACRO_DELAY) {
+        last_played = timer_read();
+        dynamic_macro_play_step();
+    }
+#endif
 }
 
 /**
  * Record a single key in a dynamic macro.
  *
+ * A press that matches the press of the previous tap is held back
+ * until its release arrives, so that a whole repeated tap can be
+ * stored as a repeat count.
+ *
  * @param macro_buffer[in] The start of the used macro buffer.
  * @param macro_pointer[in,out] The current buffer position.
  * @param macro2_end[in] The end of the other macro.
  * @param direction[in]  Either +1 or -1, which way to iterate the buffer.
  * @param record[in]     The current keypress.
  */
-void dynamic_macro_record_key(keyrecord_t *macro_buffer, keyrecord_t **macro_pointer, keyrecord_t *macro2_end, int8_t direction, keyrecord_t *record) {
+void dynamic_macro_record_key(uint8_t *macro_buffer, uint8_t **macro_pointer, uint8_t *macro2_end, int8_t direction, keyrecord_t *record) {
     /* If we've just started recording, ignore all the key releases. */
     if (!record->event.pressed && *macro_pointer == macro_buffer) {
         dprintln("dynamic macro: ignoring a leading key-up event");
         return;
     }
 
-    /* The other end of the other macro is the last buffer element it
-     * is safe to use before overwriting the other macro.
-     */
-    if (*macro_pointer - direction != macro2_end) {
-        **macro_pointer = *record;
-        *macro_pointer += direction;
+    if (has_pending_press) {
+        has_pending_press = false;
+        if (dynamic_macro_same_event(record, &record_stream.pair_release)) {
+            dynamic_macro_write_repeat(macro_pointer, macro2_end, direction, record);
+            dynamic_macro_record_key_kb(direction, record);
+            return;
+        }
+        dynamic_macro_write_event(macro_pointer, macro2_end, direction, &pending_press);
+    }
+
+    if (record_stream.has_pair && dynamic_macro_same_event(record, &record_stream.pair_press)) {
+        pending_press     = *record;
+        has_pending_press = true;
+    } else {
+        dynamic_macro_write_event(macro_pointer, macro2_end, direction, record);
     }
     dynamic_macro_record_key_kb(direction, record);
 
-    dprintf("dynamic macro: slot %d length: %d/%d\n", DYNAMIC_MACRO_CURRENT_SLOT(), DYNAMIC_MACRO_CURRENT_LENGTH(macro_buffer, *macro_pointer), DYNAMIC_MACRO_CURRENT_CAPACITY(macro_buffer, macro2_end));
+    dprintf("dynamic macro: slot %d length: %d/%d bytes\n", DYNAMIC_MACRO_CURRENT_SLOT(), DYNAMIC_MACRO_CURRENT_LENGTH(macro_buffer, *macro_pointer), DYNAMIC_MACRO_CURRENT_CAPACITY(macro_buffer, macro2_end));
 }
 
 /**
  * End recording of the dynamic macro. Essentially just update the
  * pointer to the end of the macro.
  */
-void dynamic_macro_record_end(keyrecord_t *macro_buffer, keyrecord_t *macro_pointer, int8_t direction, keyrecord_t **macro_end) {
+void dynamic_macro_record_end(uint8_t *macro_buffer, uint8_t *macro_pointer, int8_t direction, uint8_t **macro_end) {
     dynamic_macro_record_end_kb(direction);
 
+    /* If the buffer filled up, only keep whole press/release pairs: a
+     * key whose release did not fit would stay held during playback.
+     */
+    if (is_full && macro_pointer != last_idle_end) {
+        dprintln("dynamic macro: buffer full, trimming unreleased keys");
+        last_release_end = last_idle_end;
+    }
+
     /* Do not save the keys being held when stopping the recording,
      * i.e. the keys used to access the layer DM_RSTP is on.
      */
-    while (macro_pointer != macro_buffer && (macro_pointer - direction)->event.pressed) {
-        dprintln("dynamic macro: trimming a trailing key-down event");
-        macro_pointer -= direction;
+    if (macro_pointer != last_release_end || has_pending_press) {
+        dprintln("dynamic macro: trimming trailing key-down events");
+        macro_pointer     = last_release_end;
+        has_pending_press = false;
     }
 
-    dprintf("dynamic macro: slot %d saved, length: %d\n", DYNAMIC_MACRO_CURRENT_SLOT(), DYNAMIC_MACRO_CURRENT_LENGTH(macro_buffer, macro_pointer));
+    dprintf("dynamic macro: slot %d saved, length: %d bytes\n", DYNAMIC_MACRO_CURRENT_SLOT(), DYNAMIC_MACRO_CURRENT_LENGTH(macro_buffer, macro_pointer));
 
     *macro_end = macro_pointer;
 }
@@ -227,24 +619,29 @@ void dynamic_macro_record_end(keyrecord_t *macro_buffer, keyrecord_t *macro_poin
  * each other: for example one can either have two medium sized
  * macros or one long macro and one short macro. Or even one empty
  * and one using the whole buffer.
+ *
+ * The buffer takes as much RAM as DYNAMIC_MACRO_SIZE unpacked
+ * keyrecord_t would, but holds several times as many packed events.
  */
-static keyrecord_t macro_buffer[DYNAMIC_MACRO_SIZE];
+#define DYNAMIC_MACRO_BUFFER_SIZE (DYNAMIC_MACRO_SIZE * sizeof(keyrecord_t))
+
+static uint8_t macro_buffer[DYNAMIC_MACRO_BUFFER_SIZE];
 
 /* Pointer to the first buffer element after the first macro.
  * Initially points to the very beginning of the buffer since the
  * macro is empty. */
-static keyrecord_t *macro_end = macro_buffer;
+static uint8_t *macro_end = macro_buffer;
 
 /* The other end of the macro buffer. Serves as the beginning of
  * the second macro. */
-static keyrecord_t *const r_macro_buffer = macro_buffer + DYNAMIC_MACRO_SIZE - 1;
+static uint8_t *const r_macro_buffer = macro_buffer + DYNAMIC_MACRO_BUFFER_SIZE - 1;
 
 /* Like macro_end but for the second macro. */
-static keyrecord_t *r_macro_end = macro_buffer + DYNAMIC_MACRO_SIZE - 1;
+static uint8_t *r_macro_end = macro_buffer + DYNAMIC_MACRO_BUFFER_SIZE - 1;
 
 /* A persistent pointer to the current macro position (iterator)
  * used during the recording. */
-static keyrecord_t *macro_pointer = NULL;
+static uint8_t *macro_pointer = NULL;
 
 /* 0   - no macro is being recorded right now
  * 1,2 - either macro 1 or 2 is being recorded */
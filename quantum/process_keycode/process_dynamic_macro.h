@@ -22,10 +22,12 @@
 #include <stdbool.h>
 #include "action.h"
 
-/* May be overridden with a custom value. Be aware that the effective
- * macro length is half of this value: each keypress is recorded twice
- * because of the down-event and up-event. This is not a bug, it's the
- * intended behavior.
+/* May be overridden with a custom value. The buffer takes as much RAM
+ * as this many recorded events would in their unpacked form, but
+ * events are stored packed, so typically several times as many fit.
+ * Each keypress is recorded twice because of the down-event and
+ * up-event, while repeated taps of the same key are stored once with
+ * a repeat count.
  *
  * Usually it should be fine to set the macro size to at least 256 but
  * there have been reports of it being too much in some users' cases,
@@ -48,3 +50,4 @@ bool dynamic_macro_record_end_user(int8_t direction);
 bool dynamic_macro_valid_key_kb(uint16_t keycode, keyrecord_t *record);
 bool dynamic_macro_valid_key_user(uint16_t keycode, keyrecord_t *record);
 void dynamic_macro_stop_recording(void);
+void dynamic_macro_task(void);
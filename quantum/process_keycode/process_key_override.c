@@ -15,6 +15,7 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <string.h>
 #include "process_key_override.h"
 #include "report.h"
 #include "timer.h"
@@ -29,9 +30,6 @@
 #    define KEY_OVERRIDE_REPEAT_DELAY 500
 #endif
 
-// For benchmarking the time it takes to call process_key_override on every key press (needs keyboard debugging enabled as well)
-// #define BENCH_KEY_OVERRIDE
-
 // For debug output (needs keyboard debugging enabled as well)
 // #define DEBUG_KEY_OVERRIDE
 
@@ -244,13 +242,163 @@ static bool check_activation_event(const key_override_t *override, const bool ke
     }
 }
 
-/** Iterates through the list of key overrides and tries activating each, until it finds one that activates or reaches the end of overrides. Returns true if the key action for `keycode` should be sent */
+// Trigger index
+//
+// An override can only activate when its trigger is KC_NO, is the key that was just pressed, or is the last non-mod key that is still held down. The index holds the override indices sorted by trigger (stable, so array order is kept within a trigger), which lets every event visit only those (at most three) buckets instead of scanning all overrides.
+
+#define KEY_OVERRIDE_CANDIDATE_BUCKETS 3
+
+typedef struct {
+    uint16_t pos[KEY_OVERRIDE_CANDIDATE_BUCKETS];
+    uint16_t end[KEY_OVERRIDE_CANDIDATE_BUCKETS];
+} key_override_candidates_t;
+
+#ifndef KEY_OVERRIDE_NO_INDEX
+static uint16_t *index_storage = NULL;
+// Number of overrides covered by the index, or 0 if the index is not in use
+static uint16_t index_count = 0;
+// Value of key_override_count() when the index was built
+static uint16_t index_source_count = 0;
+static bool     index_valid        = false;
+
+void key_override_reindex(void) {
+    index_valid = false;
+}
+
+static uint16_t index_trigger(const uint16_t position) {
+    return key_override_get(index_storage[position])->trigger;
+}
+
+static void build_index(void) {
+    index_valid   = true;
+    index_count   = 0;
+    index_storage = key_override_index_storage_raw();
+
+    const uint16_t count = key_override_count();
+    index_source_count   = count;
+
+    // Dynamically provided overrides that do not fit the storage fall back to a full scan
+    if (count > key_override_count_raw()) {
+        return;
+    }
+
+    uint16_t n = 0;
+    for (; n < count; n++) {
+        const key_override_t *const override = key_override_get(n);
+
+        // End of array
+        if (override == NULL) {
+            break;
+        }
+
+        // Insertion sort, runs once and keeps overrides sharing a trigger in array order
+        uint16_t j = n;
+        while (j > 0 && index_trigger(j - 1) > override->trigger) {
+            index_storage[j] = index_storage[j - 1];
+            j--;
+        }
+        index_storage[j] = n;
+    }
+
+    index_count = n;
+}
+
+/** Finds the range of index positions holding overrides with the given trigger */
+static void find_trigger_range(const uint16_t trigger, uint16_t *const start, uint16_t *const end) {
+    uint16_t lo = 0;
+    uint16_t hi = index_count;
+    while (lo < hi) {
+        const uint16_t mid = lo + (hi - lo) / 2;
+        if (index_trigger(mid) < trigger) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    *start = lo;
+
+    while (hi < index_count && index_trigger(hi) == trigger) {
+        hi++;
+    }
+    *end = hi;
+}
+#else
+void key_override_reindex(void) {}
+#endif // KEY_OVERRIDE_NO_INDEX
+
+static void init_candidates(key_override_candidates_t *const candidates, const uint16_t keycode) {
+    memset(candidates, 0, sizeof(key_override_candidates_t));
+
+#ifndef KEY_OVERRIDE_NO_INDEX
+    if (!index_valid || index_source_count != key_override_count()) {
+        build_index();
+    }
+
+    if (index_count != 0) {
+        const uint16_t triggers[KEY_OVERRIDE_CANDIDATE_BUCKETS] = {KC_NO, keycode, last_key_down};
+
+        for (uint8_t b = 0; b < KEY_OVERRIDE_CANDIDATE_BUCKETS; b++) {
+            bool duplicate = false;
+            for (uint8_t other = 0; other < b; other++) {
+                duplicate |= triggers[other] == triggers[b];
+            }
+            if (!duplicate) {
+                find_trigger_range(triggers[b], &candidates->pos[b], &candidates->end[b]);
+            }
+        }
+        return;
+    }
+#endif
+
+    // No index, visit every override in the first bucket
+    candidates->end[0] = key_override_count();
+}
+
+/** Pops the lowest remaining override index across all buckets, so that overrides are tried in array order. Returns false when no candidates remain */
+static bool next_candidate(key_override_candidates_t *const candidates, uint16_t *const override_idx) {
+#ifndef KEY_OVERRIDE_NO_INDEX
+    if (index_count != 0) {
+        uint8_t  best     = KEY_OVERRIDE_CANDIDATE_BUCKETS;
+        uint16_t best_idx = UINT16_MAX;
+
+        for (uint8_t b = 0; b < KEY_OVERRIDE_CANDIDATE_BUCKETS; b++) {
+            if (candidates->pos[b] < candidates->end[b] && index_storage[candidates->pos[b]] < best_idx) {
+                best     = b;
+                best_idx = index_storage[candidates->pos[b]];
+            }
+        }
+
+        if (best == KEY_OVERRIDE_CANDIDATE_BUCKETS) {
+            return false;
+        }
+
+        candidates->pos[best]++;
+        *override_idx = best_idx;
+        return true;
+    }
+#endif
+
+    if (candidates->pos[0] >= candidates->end[0]) {
+        return false;
+    }
+
+    *override_idx = candidates->pos[0]++;
+    return true;
+}
+
+/** Iterates through the candidate key overrides and tries activating each, until it finds one that activates or runs out of candidates. Returns true if the key action for `keycode` should be sent */
 static bool try_activating_override(const uint16_t keycode, const uint8_t layer, const bool key_down, const bool is_mod, const uint8_t active_mods, bool *activated) {
+    *activated = false;
+
     if (key_override_count() == 0) {
         return true;
     }
 
-    for (uint8_t i = 0; i < key_override_count(); i++) {
+    key_override_candidates_t candidates;
+    init_candidates(&candidates, keycode);
+
+    uint16_t i;
+    while (next_candidate(&candidates, &i)) {
         const key_override_t *const override = key_override_get(i);
 
         // End of array
@@ -407,10 +555,6 @@ void key_override_task(void) {
 }
 
 bool process_key_override(const uint16_t keycode, const keyrecord_t *const record) {
-#ifdef BENCH_KEY_OVERRIDE
-    uint16_t start = timer_read();
-#endif
-
     const bool key_down = record->event.pressed;
     const bool is_mod   = IS_MODIFIER_KEYCODE(keycode);
 
@@ -520,11 +664,5 @@ bool process_key_override(const uint16_t keycode, const keyrecord_t *const recor
         }
     }
 
-#ifdef BENCH_KEY_OVERRIDE
-    uint16_t elapsed = timer_elapsed(start);
-
-    dprintf("Processing key overrides took: %u ms\n", elapsed);
-#endif
-
     return send_key_action;
 }
@@ -105,6 +105,9 @@ bool process_key_override(const uint16_t keycode, const keyrecord_t *const recor
 /** Perform any deferred keys */
 void key_override_task(void);
 
+/** Rebuilds the trigger index on the next key event. Call this after changing the contents of dynamically provided key overrides (see key_override_get()) */
+void key_override_reindex(void);
+
 /**
  *  Preferrably use these macros to create key overrides. They fix many of the options to a standard setting that should satisfy most basic use-cases. Only directly create a key_override_t struct when you really need to.
  */
@@ -93,6 +93,10 @@
 #    include "process_oneshot.h"
 #endif
 
+#ifdef I2C_QUEUE_ENABLE
+#    include "i2c_queue.h"
+#endif
+
 #ifdef AUDIO_ENABLE
 #    ifndef GOODBYE_SONG
 #        define GOODBYE_SONG SONG(GOODBYE_SOUND)
@@ -222,16 +226,25 @@ void shutdown_quantum(bool jump_to_bootloader) {
     PLAY_SONG(goodbye_song);
     shutdown_modules(jump_to_bootloader);
     shutdown_kb(jump_to_bootloader);
+#    ifdef I2C_QUEUE_ENABLE
+    i2c_queue_flush();
+#    endif
     while (timer_elapsed(timer_start) < 250)
         wait_ms(1);
     stop_all_notes();
 #else
     shutdown_modules(jump_to_bootloader);
     shutdown_kb(jump_to_bootloader);
+#    ifdef I2C_QUEUE_ENABLE
+    i2c_queue_flush();
+#    endif
     wait_ms(250);
 #endif
 #ifdef HAPTIC_ENABLE
     haptic_shutdown();
+#    ifdef I2C_QUEUE_ENABLE
+    i2c_queue_flush();
+#    endif
 #endif
 }
 
@@ -531,6 +544,11 @@ void suspend_power_down_quantum(void) {
     pointing_device_task();
 #    endif
 #endif
+
+#ifdef I2C_QUEUE_ENABLE
+    // The main loop no longer runs the queue while suspended
+    i2c_queue_flush();
+#endif
 }
 
 __attribute__((weak)) void suspend_wakeup_init_quantum(void) {
@@ -85,6 +85,9 @@ static uint8_t         rgb_last_effect    = UINT8_MAX;
 static uint8_t         rgb_current_effect = 0;
 static effect_params_t rgb_effect_params  = {0, LED_FLAG_ALL, false};
 static rgb_task_states rgb_task_state     = SYNCING;
+#ifdef RGBLIGHT_RGB_MATRIX
+static bool rgblight_flush_pending = false;
+#endif // RGBLIGHT_RGB_MATRIX
 
 // double buffers
 static uint32_t rgb_timer_buffer;
@@ -170,7 +173,7 @@ void rgb_matrix_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
 }
 
 void rgb_matrix_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
-#if defined(RGB_MATRIX_SPLIT)
+#if defined(RGB_MATRIX_SPLIT) || defined(RGBLIGHT_RGB_MATRIX)
     for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++)
         rgb_matrix_set_color(i, red, green, blue);
 #else
@@ -178,6 +181,23 @@ void rgb_matrix_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
 #endif
 }
 
+#ifdef RGBLIGHT_RGB_MATRIX
+// The rgblight LEDs follow the matrix LEDs in the driver's buffer, and are sent out with them.
+void rgb_matrix_set_rgblight_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
+    rgb_matrix_driver.set_color(RGB_MATRIX_LED_COUNT + index, red, green, blue);
+}
+
+void rgb_matrix_set_rgblight_color_all(uint8_t red, uint8_t green, uint8_t blue) {
+    for (uint8_t i = 0; i < RGBLIGHT_LED_COUNT; i++) {
+        rgb_matrix_set_rgblight_color(i, red, green, blue);
+    }
+}
+
+void rgb_matrix_flush_rgblight(void) {
+    rgblight_flush_pending = true;
+}
+#endif // RGBLIGHT_RGB_MATRIX
+
 void rgb_matrix_handle_key_event(uint8_t row, uint8_t col, bool pressed) {
 #ifndef RGB_MATRIX_SPLIT
     if (!is_keyboard_master()) return;
@@ -373,7 +393,11 @@ static void rgb_task_render(uint8_t effect) {
     // next task
     if (!rendering) {
         rgb_task_state = FLUSHING;
-        if (!rgb_effect_params.init && effect == RGB_MATRIX_NONE) {
+        if (!rgb_effect_params.init && effect == RGB_MATRIX_NONE
+#ifdef RGBLIGHT_RGB_MATRIX
+            && !rgblight_flush_pending
+#endif // RGBLIGHT_RGB_MATRIX
+        ) {
             // We only need to flush once if we are RGB_MATRIX_NONE
             rgb_task_state = SYNCING;
         }
@@ -387,6 +411,9 @@ static void rgb_task_flush(uint8_t effect) {
 
     // update pwm buffers
     rgb_matrix_update_pwm_buffers();
+#ifdef RGBLIGHT_RGB_MATRIX
+    rgblight_flush_pending = false;
+#endif // RGBLIGHT_RGB_MATRIX
 
     // next task
     rgb_task_state = SYNCING;
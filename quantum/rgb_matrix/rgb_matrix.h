@@ -156,6 +156,19 @@ int rgb_matrix_led_index(int index);
 void rgb_matrix_set_color(int index, uint8_t red, uint8_t green, uint8_t blue);
 void rgb_matrix_set_color_all(uint8_t red, uint8_t green, uint8_t blue);
 
+#ifdef RGBLIGHT_RGB_MATRIX
+/**
+ * \brief Driver functions of the rgblight `rgb_matrix` driver.
+ *
+ * The rgblight LEDs are chained after the matrix LEDs, in the same driver buffer.
+ * Only that buffer and its flush are shared: flushing rgblight only marks the
+ * buffer dirty, so that the next flush of the rgb_matrix task sends both out.
+ */
+void rgb_matrix_set_rgblight_color(int index, uint8_t red, uint8_t green, uint8_t blue);
+void rgb_matrix_set_rgblight_color_all(uint8_t red, uint8_t green, uint8_t blue);
+void rgb_matrix_flush_rgblight(void);
+#endif
+
 void rgb_matrix_handle_key_event(uint8_t row, uint8_t col, bool pressed);
 
 void rgb_matrix_task(void);
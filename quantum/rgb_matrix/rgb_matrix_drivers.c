@@ -143,7 +143,7 @@ const rgb_matrix_driver_t rgb_matrix_driver = {
 #elif defined(RGB_MATRIX_WS2812)
 #    if defined(RGBLIGHT_WS2812)
 #        pragma message "Cannot use RGBLIGHT and RGB Matrix using WS2812 at the same time."
-#        pragma message "You need to use a custom driver, or re-implement the WS2812 driver to use a different configuration."
+#        pragma message "Set RGBLIGHT_DRIVER = rgb_matrix to chain the RGBLIGHT LEDs after the RGB Matrix ones, or use a custom driver."
 #    endif
 
 const rgb_matrix_driver_t rgb_matrix_driver = {
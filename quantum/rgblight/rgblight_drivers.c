@@ -23,4 +23,21 @@ const rgblight_driver_t rgblight_driver = {
     .flush         = apa102_flush,
 };
 
+#elif defined(RGBLIGHT_RGB_MATRIX)
+#    include "rgb_matrix.h"
+
+#    if defined(RGB_MATRIX_SPLIT)
+#        error "RGBLIGHT_DRIVER = rgb_matrix does not support split RGB Matrix yet"
+#    endif
+
+// The LED chain is brought up by rgb_matrix_init()
+static void rgblight_rgb_matrix_init(void) {}
+
+const rgblight_driver_t rgblight_driver = {
+    .init          = rgblight_rgb_matrix_init,
+    .set_color     = rgb_matrix_set_rgblight_color,
+    .set_color_all = rgb_matrix_set_rgblight_color_all,
+    .flush         = rgb_matrix_flush_rgblight,
+};
+
 #endif
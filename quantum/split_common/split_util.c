@@ -133,7 +133,14 @@ static uint8_t peek_matrix_intersection(pin_t out_pin, pin_t in_pin) {
     uint8_t pin_state = gpio_read_pin(in_pin);
     // Set out_pin to a setting that is less susceptible to noise.
     gpio_set_pin_input_high(out_pin);
+#    ifdef MATRIX_IO_DELAY_ADAPTIVE
+    // Wait for the pull-up to go HIGH, but no longer than it actually takes.
+    for (uint8_t us = 0; us < MATRIX_IO_DELAY && !gpio_read_pin(in_pin); us++) {
+        wait_us(1);
+    }
+#    else
     matrix_io_delay(); // Wait for the pull-up to go HIGH.
+#    endif
     return pin_state;
 }
 #endif
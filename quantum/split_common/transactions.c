@@ -246,8 +246,9 @@ static bool encoder_handlers_master(matrix_row_t master_matrix[], matrix_row_t s
             bool    actioned = false;
             uint8_t index;
             bool    clockwise;
-            while (okay && encoder_dequeue_event_advanced(&split_shmem->encoders.events, &index, &clockwise)) {
-                okay &= encoder_queue_event(index, clockwise);
+            uint8_t count;
+            while (okay && encoder_dequeue_delta_advanced(&split_shmem->encoders.events, &index, &clockwise, &count)) {
+                okay &= encoder_queue_delta(index, clockwise, count);
                 actioned = true;
             }
 
@@ -814,7 +815,7 @@ static void watchdog_handlers_slave(matrix_row_t master_matrix[], matrix_row_t s
 
 #if defined(HAPTIC_ENABLE) && defined(SPLIT_HAPTIC_ENABLE)
 
-uint8_t                split_haptic_play = 0xFF;
+uint8_t                split_haptic_play_count = 0;
 extern haptic_config_t haptic_config;
 
 static bool haptic_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
@@ -822,22 +823,28 @@ static bool haptic_handlers_master(matrix_row_t master_matrix[], matrix_row_t sl
     split_slave_haptic_sync_t haptic_sync;
 
     memcpy(&haptic_sync.haptic_config, &haptic_config, sizeof(haptic_config_t));
-    haptic_sync.haptic_play = split_haptic_play;
+    haptic_sync.haptic_play_count = split_haptic_play_count;
 
-    bool okay = send_if_data_mismatch(PUT_HAPTIC, &last_update, &haptic_sync, &split_shmem->haptic_sync, sizeof(haptic_sync));
-
-    split_haptic_play = 0xFF;
-
-    return okay;
+    return send_if_data_mismatch(PUT_HAPTIC, &last_update, &haptic_sync, &split_shmem->haptic_sync, sizeof(haptic_sync));
 }
 
 static void haptic_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    static bool    synced          = false;
+    static uint8_t last_play_count = 0;
+    uint8_t        play_count      = split_shmem->haptic_sync.haptic_play_count;
+
     memcpy(&haptic_config, &split_shmem->haptic_sync.haptic_config, sizeof(haptic_config_t));
 
-    if (split_shmem->haptic_sync.haptic_play != 0xFF) {
-        haptic_set_mode(split_shmem->haptic_sync.haptic_play);
-        haptic_play();
+    // Play once for every haptic_play() on the master since the last transaction, so the same effect played on
+    // consecutive scans is not mistaken for one still in shared memory. The synced config already carries the master's
+    // mode, so playing does not need to write it to EEPROM again.
+    if (synced) {
+        for (uint8_t plays = play_count - last_play_count; plays > 0; plays--) {
+            haptic_play();
+        }
     }
+    synced          = true;
+    last_play_count = play_count;
 }
 
 // clang-format off
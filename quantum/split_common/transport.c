@@ -90,6 +90,7 @@ bool transport_execute_transaction(int8_t id, const void *initiator2target_buf,
 #else // USE_I2C
 
 #    include "serial.h"
+#    include "bus_stats.h"
 
 static split_shared_memory_t shared_memory;
 split_shared_memory_t *const split_shmem = &shared_memory;
@@ -108,7 +109,10 @@ bool transport_execute_transaction(int8_t id, const void *initiator2target_buf,
         memcpy(split_trans_initiator2target_buffer(trans), initiator2target_buf, len);
     }
 
-    if (!soft_serial_transaction(id)) {
+    BUS_STATS_BEGIN(SERIAL);
+    bool success = soft_serial_transaction(id);
+    BUS_STATS_END(SERIAL, trans->initiator2target_buffer_size + trans->target2initiator_buffer_size, success ? BUS_STATS_SUCCESS : BUS_STATS_ERROR);
+    if (!success) {
         return false;
     }
 
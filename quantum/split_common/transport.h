@@ -119,7 +119,7 @@ typedef struct _split_slave_pointing_sync_t {
 #    include "haptic.h"
 typedef struct _split_slave_haptic_sync_t {
     haptic_config_t haptic_config;
-    uint8_t         haptic_play;
+    uint8_t         haptic_play_count; // bumped by every haptic_play() on the master
 } split_slave_haptic_sync_t;
 #endif // defined(HAPTIC_ENABLE) && defined(SPLIT_HAPTIC_ENABLE)
 
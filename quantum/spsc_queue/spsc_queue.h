@@ -0,0 +1,146 @@
+// Copyright 2025 QMK Contributors
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "compiler_support.h"
+
+/**
+ * @brief Lock-free single-producer/single-consumer queue of fixed-size elements.
+ *
+ * Exactly one context (e.g. an ISR) may push and exactly one other context (e.g. the main loop) may pop, without
+ * disabling interrupts. The capacity must be a power of two no larger than 128; the head and tail indices run freely
+ * and are masked on access, so all slots are usable and `head - tail` is always the number of queued elements.
+ *
+ * The producer publishes an element by storing the new head with release ordering after copying the payload, and the
+ * consumer releases a slot by storing the new tail after copying the payload out, so neither side ever observes a
+ * partially written element.
+ */
+typedef struct {
+    uint8_t         *buffer;
+    uint8_t          element_size;
+    uint8_t          mask;
+    volatile uint8_t head;
+    volatile uint8_t tail;
+} spsc_queue_t;
+
+#define SPSC_QUEUE_IS_POW2(n) ((n) > 1 && (n) <= 128 && ((n) & ((n)-1)) == 0)
+
+/**
+ * @brief Static initializer for a queue backed by `storage`, which must hold `capacity` elements of `element_size` bytes.
+ */
+#define SPSC_QUEUE_INIT(storage, element_size_, capacity) \
+    { .buffer = (uint8_t *)(storage), .element_size = (element_size_), .mask = (capacity)-1, .head = 0, .tail = 0 }
+
+#define SPSC_QUEUE_ASSERT_CAPACITY(capacity) STATIC_ASSERT(SPSC_QUEUE_IS_POW2(capacity), "SPSC queue capacity must be a power of two between 2 and 128")
+
+#define SPSC_LOAD_ACQUIRE(x) __atomic_load_n(&(x), __ATOMIC_ACQUIRE)
+#define SPSC_LOAD_RELAXED(x) __atomic_load_n(&(x), __ATOMIC_RELAXED)
+#define SPSC_STORE_RELEASE(x, v) __atomic_store_n(&(x), (v), __ATOMIC_RELEASE)
+
+static inline void spsc_queue_init(spsc_queue_t *queue, void *storage, uint8_t element_size, uint8_t capacity) {
+    queue->buffer       = (uint8_t *)storage;
+    queue->element_size = element_size;
+    queue->mask         = capacity - 1;
+    queue->head         = 0;
+    queue->tail         = 0;
+}
+
+static inline uint8_t spsc_queue_capacity(const spsc_queue_t *queue) {
+    return queue->mask + 1;
+}
+
+/**
+ * @brief Number of queued elements. Exact from either side; may be stale by the time the other side acts on it.
+ */
+static inline uint8_t spsc_queue_count(spsc_queue_t *queue) {
+    return (uint8_t)(SPSC_LOAD_ACQUIRE(queue->head) - SPSC_LOAD_ACQUIRE(queue->tail));
+}
+
+static inline bool spsc_queue_empty(spsc_queue_t *queue) {
+    return spsc_queue_count(queue) == 0;
+}
+
+static inline bool spsc_queue_full(spsc_queue_t *queue) {
+    return spsc_queue_count(queue) == spsc_queue_capacity(queue);
+}
+
+static inline uint8_t *spsc_queue_slot(const spsc_queue_t *queue, uint8_t index) {
+    return queue->buffer + (uint16_t)(index & queue->mask) * queue->element_size;
+}
+
+/**
+ * @brief Producer side: copy up to `count` elements from `elements` into the queue.
+ *
+ * @return the number of elements actually queued, which is less than `count` if the queue filled up
+ */
+static inline uint8_t spsc_queue_push_batch(spsc_queue_t *queue, const void *elements, uint8_t count) {
+    uint8_t head = SPSC_LOAD_RELAXED(queue->head);
+    uint8_t tail = SPSC_LOAD_ACQUIRE(queue->tail);
+    uint8_t free = spsc_queue_capacity(queue) - (uint8_t)(head - tail);
+    if (count > free) {
+        count = free;
+    }
+
+    const uint8_t *src = (const uint8_t *)elements;
+    for (uint8_t i = 0; i < count; i++) {
+        memcpy(spsc_queue_slot(queue, head + i), src, queue->element_size);
+        src += queue->element_size;
+    }
+
+    SPSC_STORE_RELEASE(queue->head, (uint8_t)(head + count));
+    return count;
+}
+
+/**
+ * @brief Consumer side: copy up to `count` elements out of the queue into `elements`.
+ *
+ * @return the number of elements actually dequeued
+ */
+static inline uint8_t spsc_queue_pop_batch(spsc_queue_t *queue, void *elements, uint8_t count) {
+    uint8_t tail      = SPSC_LOAD_RELAXED(queue->tail);
+    uint8_t head      = SPSC_LOAD_ACQUIRE(queue->head);
+    uint8_t available = head - tail;
+    if (count > available) {
+        count = available;
+    }
+
+    uint8_t *dst = (uint8_t *)elements;
+    for (uint8_t i = 0; i < count; i++) {
+        memcpy(dst, spsc_queue_slot(queue, tail + i), queue->element_size);
+        dst += queue->element_size;
+    }
+
+    SPSC_STORE_RELEASE(queue->tail, (uint8_t)(tail + count));
+    return count;
+}
+
+static inline bool spsc_queue_push(spsc_queue_t *queue, const void *element) {
+    return spsc_queue_push_batch(queue, element, 1) == 1;
+}
+
+static inline bool spsc_queue_pop(spsc_queue_t *queue, void *element) {
+    return spsc_queue_pop_batch(queue, element, 1) == 1;
+}
+
+/**
+ * @brief Consumer side: copy the oldest element into `element` without removing it.
+ */
+static inline bool spsc_queue_peek(spsc_queue_t *queue, void *element) {
+    uint8_t tail = SPSC_LOAD_RELAXED(queue->tail);
+    if (SPSC_LOAD_ACQUIRE(queue->head) == tail) {
+        return false;
+    }
+    memcpy(element, spsc_queue_slot(queue, tail), queue->element_size);
+    return true;
+}
+
+/**
+ * @brief Consumer side: discard every element queued so far.
+ */
+static inline void spsc_queue_clear(spsc_queue_t *queue) {
+    SPSC_STORE_RELEASE(queue->tail, SPSC_LOAD_ACQUIRE(queue->head));
+}
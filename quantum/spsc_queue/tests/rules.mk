@@ -0,0 +1,4 @@
+spsc_queue_DEFS := -DNO_DEBUG
+
+spsc_queue_SRC := \
+	$(QUANTUM_PATH)/spsc_queue/tests/spsc_queue_tests.cpp
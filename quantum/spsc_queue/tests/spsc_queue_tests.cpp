@@ -0,0 +1,146 @@
+// Copyright 2025 QMK Contributors
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+#include <thread>
+
+extern "C" {
+#include "spsc_queue.h"
+}
+
+class SpscQueueTest : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        spsc_queue_init(&queue, storage, sizeof(uint16_t), 8);
+    }
+
+    uint16_t     storage[8];
+    spsc_queue_t queue;
+};
+
+TEST_F(SpscQueueTest, StartsEmpty) {
+    uint16_t value;
+    EXPECT_TRUE(spsc_queue_empty(&queue));
+    EXPECT_FALSE(spsc_queue_full(&queue));
+    EXPECT_EQ(spsc_queue_count(&queue), 0);
+    EXPECT_FALSE(spsc_queue_pop(&queue, &value));
+    EXPECT_FALSE(spsc_queue_peek(&queue, &value));
+}
+
+TEST_F(SpscQueueTest, PreservesOrder) {
+    for (uint16_t i = 0; i < 5; i++) {
+        uint16_t value = 1000 + i;
+        EXPECT_TRUE(spsc_queue_push(&queue, &value));
+    }
+    EXPECT_EQ(spsc_queue_count(&queue), 5);
+
+    uint16_t value;
+    EXPECT_TRUE(spsc_queue_peek(&queue, &value));
+    EXPECT_EQ(value, 1000);
+    for (uint16_t i = 0; i < 5; i++) {
+        EXPECT_TRUE(spsc_queue_pop(&queue, &value));
+        EXPECT_EQ(value, 1000 + i);
+    }
+    EXPECT_TRUE(spsc_queue_empty(&queue));
+}
+
+TEST_F(SpscQueueTest, UsesEverySlot) {
+    uint16_t value = 1;
+    for (int i = 0; i < 8; i++) {
+        EXPECT_TRUE(spsc_queue_push(&queue, &value));
+    }
+    EXPECT_TRUE(spsc_queue_full(&queue));
+    EXPECT_FALSE(spsc_queue_push(&queue, &value));
+    EXPECT_EQ(spsc_queue_count(&queue), 8);
+}
+
+TEST_F(SpscQueueTest, WrapsIndicesAround) {
+    // Run the free-running indices past 255 several times
+    for (uint16_t i = 0; i < 1000; i++) {
+        uint16_t in[3] = {i, (uint16_t)(i + 1), (uint16_t)(i + 2)};
+        uint16_t out[3];
+        EXPECT_EQ(spsc_queue_push_batch(&queue, in, 3), 3);
+        EXPECT_EQ(spsc_queue_pop_batch(&queue, out, 3), 3);
+        EXPECT_EQ(out[0], i);
+        EXPECT_EQ(out[2], i + 2);
+    }
+    EXPECT_TRUE(spsc_queue_empty(&queue));
+}
+
+TEST_F(SpscQueueTest, BatchesAreTruncated) {
+    uint16_t in[10] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    uint16_t out[10];
+    EXPECT_EQ(spsc_queue_push_batch(&queue, in, 10), 8);
+    EXPECT_EQ(spsc_queue_pop_batch(&queue, out, 3), 3);
+    EXPECT_EQ(spsc_queue_push_batch(&queue, &in[8], 2), 2);
+    EXPECT_EQ(spsc_queue_pop_batch(&queue, out, 10), 7);
+    EXPECT_EQ(out[0], 3);
+    EXPECT_EQ(out[4], 7);
+    EXPECT_EQ(out[5], 8);
+    EXPECT_EQ(out[6], 9);
+}
+
+TEST_F(SpscQueueTest, ClearDiscardsQueuedElements) {
+    uint16_t value = 42;
+    spsc_queue_push(&queue, &value);
+    spsc_queue_push(&queue, &value);
+    spsc_queue_clear(&queue);
+    EXPECT_TRUE(spsc_queue_empty(&queue));
+    EXPECT_TRUE(spsc_queue_push(&queue, &value));
+    EXPECT_EQ(spsc_queue_count(&queue), 1);
+}
+
+TEST(SpscQueueStressTest, TwoThreadsTransferEverythingInOrder) {
+    static const uint32_t total = 500000;
+
+    static uint32_t     storage[16];
+    static spsc_queue_t queue = SPSC_QUEUE_INIT(storage, sizeof(uint32_t), 16);
+
+    std::thread producer([] {
+        uint32_t next = 0;
+        while (next < total) {
+            // Alternate between single and batched pushes to exercise both paths
+            if (next % 3 == 0) {
+                if (spsc_queue_push(&queue, &next)) {
+                    next++;
+                } else {
+                    std::this_thread::yield();
+                }
+            } else {
+                uint32_t batch[5];
+                uint8_t  count = 0;
+                while (count < 5 && next + count < total) {
+                    batch[count] = next + count;
+                    count++;
+                }
+                uint8_t pushed = spsc_queue_push_batch(&queue, batch, count);
+                if (pushed == 0) {
+                    std::this_thread::yield();
+                }
+                next += pushed;
+            }
+        }
+    });
+
+    uint32_t expected   = 0;
+    uint32_t mismatches = 0;
+    while (expected < total) {
+        uint32_t batch[7];
+        uint8_t  count = spsc_queue_pop_batch(&queue, batch, 7);
+        if (count == 0) {
+            std::this_thread::yield();
+        }
+        for (uint8_t i = 0; i < count; i++) {
+            if (batch[i] != expected) {
+                mismatches++;
+            }
+            expected++;
+        }
+    }
+
+    producer.join();
+    EXPECT_EQ(mismatches, 0u);
+    EXPECT_EQ(expected, total);
+    EXPECT_TRUE(spsc_queue_empty(&queue));
+}
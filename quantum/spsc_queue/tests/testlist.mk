@@ -0,0 +1 @@
+TEST_LIST += spsc_queue
@@ -26,6 +26,9 @@
 #include "utf8.h"
 #include "debug.h"
 #include "quantum.h"
+#include "timer.h"
+#include "progmem.h"
+#include <string.h>
 
 #if defined(AUDIO_ENABLE)
 #    include "audio.h"
@@ -207,7 +210,9 @@ void unicode_input_mode_step_reverse(void) {
     cycle_unicode_input_mode(-1);
 }
 
-__attribute__((weak)) void unicode_input_start(void) {
+// Mode-specific setup shared by every code point in a sequence of input,
+// e.g. lifting caps lock on Linux or enabling num lock for HexNumpad.
+static void unicode_session_begin(void) {
     unicode_saved_led_state = host_keyboard_led_state();
 
     // Note the order matters here!
@@ -222,6 +227,30 @@ __attribute__((weak)) void unicode_input_start(void) {
     clear_mods();                    // Unregister mods to start from a clean state
     clear_weak_mods();
 
+    // For increased reliability, use numpad keys for inputting digits
+    if (unicode_config.input_mode == UNICODE_MODE_WINDOWS && !unicode_saved_led_state.num_lock) {
+        tap_code(KC_NUM_LOCK);
+    }
+}
+
+static void unicode_session_end(void) {
+    switch (unicode_config.input_mode) {
+        case UNICODE_MODE_LINUX:
+            if (unicode_saved_led_state.caps_lock) {
+                tap_code(KC_CAPS_LOCK);
+            }
+            break;
+        case UNICODE_MODE_WINDOWS:
+            if (!unicode_saved_led_state.num_lock) {
+                tap_code(KC_NUM_LOCK);
+            }
+            break;
+    }
+
+    set_mods(unicode_saved_mods); // Reregister previously set mods
+}
+
+static void unicode_sequence_begin(void) {
     switch (unicode_config.input_mode) {
         case UNICODE_MODE_MACOS:
             register_code(UNICODE_KEY_MAC);
@@ -230,10 +259,6 @@ __attribute__((weak)) void unicode_input_start(void) {
             tap_code16(UNICODE_KEY_LNX);
             break;
         case UNICODE_MODE_WINDOWS:
-            // For increased reliability, use numpad keys for inputting digits
-            if (!unicode_saved_led_state.num_lock) {
-                tap_code(KC_NUM_LOCK);
-            }
             register_code(KC_LEFT_ALT);
             wait_ms(UNICODE_TYPE_DELAY);
             tap_code(KC_KP_PLUS);
@@ -253,22 +278,16 @@ __attribute__((weak)) void unicode_input_start(void) {
     wait_ms(UNICODE_TYPE_DELAY);
 }
 
-__attribute__((weak)) void unicode_input_finish(void) {
+static void unicode_sequence_end(void) {
     switch (unicode_config.input_mode) {
         case UNICODE_MODE_MACOS:
             unregister_code(UNICODE_KEY_MAC);
             break;
         case UNICODE_MODE_LINUX:
             tap_code(KC_SPACE);
-            if (unicode_saved_led_state.caps_lock) {
-                tap_code(KC_CAPS_LOCK);
-            }
             break;
         case UNICODE_MODE_WINDOWS:
             unregister_code(KC_LEFT_ALT);
-            if (!unicode_saved_led_state.num_lock) {
-                tap_code(KC_NUM_LOCK);
-            }
             break;
         case UNICODE_MODE_WINCOMPOSE:
             tap_code(KC_ENTER);
@@ -277,8 +296,16 @@ __attribute__((weak)) void unicode_input_finish(void) {
             tap_code16(KC_ENTER);
             break;
     }
+}
 
-    set_mods(unicode_saved_mods); // Reregister previously set mods
+__attribute__((weak)) void unicode_input_start(void) {
+    unicode_session_begin();
+    unicode_sequence_begin();
+}
+
+__attribute__((weak)) void unicode_input_finish(void) {
+    unicode_sequence_end();
+    unicode_session_end();
 }
 
 __attribute__((weak)) void unicode_input_cancel(void) {
@@ -324,16 +351,73 @@ static void send_nibble_wrapper(uint8_t digit) {
 
 // clang-format on
 
+#ifdef UNICODE_BATCHED_INPUT
+// Returns the unmodified keycode typing `digit` in the current input mode, or
+// KC_NO if the active send_string layout needs a modifier for it.
+static uint8_t unicode_digit_keycode(uint8_t digit) {
+    if (unicode_config.input_mode == UNICODE_MODE_WINDOWS) {
+        return digit < 10 ? KC_KP_1 + (10 + digit - 1) % 10 : KC_A + (digit - 10);
+    }
+
+    uint8_t ascii = digit < 10 ? '0' + digit : 'a' + (digit - 10);
+    uint8_t mask  = 1 << (ascii % 8);
+    if ((pgm_read_byte(&ascii_to_shift_lut[ascii / 8]) | pgm_read_byte(&ascii_to_altgr_lut[ascii / 8]) | pgm_read_byte(&ascii_to_dead_lut[ascii / 8])) & mask) {
+        return KC_NO;
+    }
+    return pgm_read_byte(&ascii_to_keycode_lut[ascii]);
+}
+#endif
+
+static void unicode_send_digits(const uint8_t *digits, uint8_t count) {
+#ifdef UNICODE_BATCHED_INPUT
+    // Roll from one digit to the next: each report releases the previous digit
+    // and presses the next, halving the number of reports compared to tapping.
+    // Repeated digits still need a release in between to register twice.
+    uint8_t held = KC_NO;
+    for (uint8_t i = 0; i < count; i++) {
+        uint8_t kc = unicode_digit_keycode(digits[i]);
+        if (held != KC_NO && (kc == held || kc == KC_NO)) {
+            del_key(held);
+            send_keyboard_report();
+            held = KC_NO;
+        }
+        if (kc == KC_NO) {
+            send_nibble_wrapper(digits[i]);
+            continue;
+        }
+
+        if (held != KC_NO) {
+            del_key(held);
+        }
+        add_key(kc);
+        send_keyboard_report();
+        wait_ms(TAP_CODE_DELAY);
+        held = kc;
+    }
+    if (held != KC_NO) {
+        del_key(held);
+        send_keyboard_report();
+    }
+#else
+    for (uint8_t i = 0; i < count; i++) {
+        send_nibble_wrapper(digits[i]);
+    }
+#endif
+}
+
 void register_hex(uint16_t hex) {
+    uint8_t digits[4];
     for (int i = 3; i >= 0; i--) {
-        uint8_t digit = ((hex >> (i * 4)) & 0xF);
-        send_nibble_wrapper(digit);
+        digits[3 - i] = ((hex >> (i * 4)) & 0xF);
     }
+    unicode_send_digits(digits, ARRAY_SIZE(digits));
 }
 
 void register_hex32(uint32_t hex) {
-    bool first_digit        = true;
-    bool needs_leading_zero = (unicode_config.input_mode == UNICODE_MODE_WINCOMPOSE);
+    uint8_t digits[9];
+    uint8_t count              = 0;
+    bool    first_digit        = true;
+    bool    needs_leading_zero = (unicode_config.input_mode == UNICODE_MODE_WINCOMPOSE);
     for (int i = 7; i >= 0; i--) {
         // Work out the digit we're going to transmit
         uint8_t digit = ((hex >> (i * 4)) & 0xF);
@@ -341,7 +425,7 @@ void register_hex32(uint32_t hex) {
         // If we're still searching for the first digit, and found one
         // that needs a leading zero sent out, send the zero.
         if (first_digit && needs_leading_zero && digit > 9) {
-            send_nibble_wrapper(0);
+            digits[count++] = 0;
         }
 
         // Always send digits (including zero) if we're down to the last
@@ -350,19 +434,42 @@ void register_hex32(uint32_t hex) {
 
         // If we've found a digit worth transmitting, do so.
         if (digit != 0 || !first_digit || must_send) {
-            send_nibble_wrapper(digit);
-            first_digit = false;
+            digits[count++] = digit;
+            first_digit     = false;
         }
     }
+    unicode_send_digits(digits, count);
 }
 
-void register_unicode(uint32_t code_point) {
-    if (code_point > 0x10FFFF || (code_point > 0xFFFF && unicode_config.input_mode == UNICODE_MODE_WINDOWS)) {
-        // Code point out of range, do nothing
-        return;
+#ifdef UNICODE_STATS_ENABLE
+static unicode_stats_t unicode_stats;
+
+static void unicode_stats_record(uint32_t start, uint16_t code_points) {
+    unicode_stats.code_points += code_points;
+    unicode_stats.elapsed_ms += timer_elapsed32(start);
+}
+
+void unicode_get_stats(unicode_stats_t *stats) {
+    *stats = unicode_stats;
+}
+
+void unicode_reset_stats(void) {
+    memset(&unicode_stats, 0, sizeof(unicode_stats));
+}
+
+uint32_t unicode_get_chars_per_second(void) {
+    if (unicode_stats.elapsed_ms == 0) {
+        return 0;
     }
+    return (uint32_t)(((uint64_t)unicode_stats.code_points * 1000) / unicode_stats.elapsed_ms);
+}
+#endif
 
-    unicode_input_start();
+static bool unicode_code_point_supported(uint32_t code_point) {
+    return code_point <= 0x10FFFF && (code_point <= 0xFFFF || unicode_config.input_mode != UNICODE_MODE_WINDOWS);
+}
+
+static void unicode_send_code_point(uint32_t code_point) {
     if (code_point > 0xFFFF && unicode_config.input_mode == UNICODE_MODE_MACOS) {
         // Convert code point to UTF-16 surrogate pair on macOS
         code_point -= 0x10000;
@@ -372,7 +479,23 @@ void register_unicode(uint32_t code_point) {
     } else {
         register_hex32(code_point);
     }
+}
+
+void register_unicode(uint32_t code_point) {
+    if (!unicode_code_point_supported(code_point)) {
+        // Code point out of range, do nothing
+        return;
+    }
+
+#ifdef UNICODE_STATS_ENABLE
+    uint32_t start = timer_read32();
+#endif
+    unicode_input_start();
+    unicode_send_code_point(code_point);
     unicode_input_finish();
+#ifdef UNICODE_STATS_ENABLE
+    unicode_stats_record(start, 1);
+#endif
 }
 
 void send_unicode_string(const char *str) {
@@ -380,6 +503,34 @@ void send_unicode_string(const char *str) {
         return;
     }
 
+#ifdef UNICODE_BATCHED_INPUT
+    // The (possibly overridden) input hooks open and close the whole string,
+    // code points in between are only separated by the mode-specific framing.
+    uint32_t start       = timer_read32();
+    uint16_t code_points = 0;
+    while (*str) {
+        int32_t code_point = 0;
+        str                = decode_utf8(str, &code_point);
+
+        if (code_point >= 0 && unicode_code_point_supported(code_point)) {
+            if (code_points++ == 0) {
+                unicode_input_start();
+            } else {
+                unicode_sequence_end();
+                unicode_sequence_begin();
+            }
+            unicode_send_code_point(code_point);
+        }
+    }
+    if (code_points > 0) {
+        unicode_input_finish();
+    }
+#    ifdef UNICODE_STATS_ENABLE
+    unicode_stats_record(start, code_points);
+#    else
+    (void)start;
+#    endif
+#else
     while (*str) {
         int32_t code_point = 0;
         str                = decode_utf8(str, &code_point);
@@ -388,4 +539,5 @@ void send_unicode_string(const char *str) {
             register_unicode(code_point);
         }
     }
+#endif
 }
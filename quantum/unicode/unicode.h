@@ -133,4 +133,30 @@ void register_unicode(uint32_t code_point);
  */
 void send_unicode_string(const char *str);
 
+#ifdef UNICODE_STATS_ENABLE
+typedef struct unicode_stats_t {
+    uint32_t code_points; // Number of code points input
+    uint32_t elapsed_ms;  // Total time spent inputting them
+} unicode_stats_t;
+
+/**
+ * \brief Get the accumulated Unicode input statistics.
+ *
+ * \param stats Filled in with the code points input and the time spent so far.
+ */
+void unicode_get_stats(unicode_stats_t *stats);
+
+/**
+ * \brief Reset the Unicode input statistics.
+ */
+void unicode_reset_stats(void);
+
+/**
+ * \brief Get the average Unicode input rate.
+ *
+ * \return The number of code points input per second, or 0 if nothing has been input yet.
+ */
+uint32_t unicode_get_chars_per_second(void);
+#endif
+
 /** \} */
@@ -28,6 +28,7 @@
 
 #include "via.h"
 
+#include <string.h>
 #include "raw_hid.h"
 #include "dynamic_keymap.h"
 #include "eeconfig.h"
@@ -36,6 +37,7 @@
 #include "wait.h"
 #include "version.h" // for QMK_BUILDDATE used in EEPROM magic
 #include "nvm_via.h"
+#include "util.h"
 
 #if defined(SECURE_ENABLE)
 #    include "secure.h"
@@ -287,6 +289,256 @@ __attribute__((weak)) bool via_command_kb(uint8_t *data, uint8_t length) {
     return false;
 }
 
+#ifdef VIA_BULK_TRANSFER_ENABLE
+#    define VIA_BULK_ACTIVE (1 << 7)
+// id_custom_set_value, channel, bulk command id, seq, len
+#    define VIA_BULK_HEADER_SIZE 5
+#    define VIA_BULK_ERROR_LENGTH 0xFF
+
+// Staging the whole keymap lets a full upload be committed by a single end command.
+#    ifndef VIA_BULK_STAGING_SIZE
+#        define VIA_BULK_STAGING_SIZE (DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2)
+#    endif
+
+typedef struct {
+    uint8_t  flags;
+    uint8_t  seq;
+    uint16_t offset;
+    uint16_t size;
+    uint16_t done;
+} via_bulk_state_t;
+
+static via_bulk_state_t via_bulk;
+static uint8_t          via_bulk_staging[VIA_BULK_STAGING_SIZE];
+
+static uint32_t via_bulk_keymap_size(void) {
+    return (uint32_t)dynamic_keymap_get_layer_count() * MATRIX_ROWS * MATRIX_COLS * 2;
+}
+
+// Drops whatever a write transfer has staged, nothing of it has reached NVM yet.
+static void via_bulk_abort(void) {
+    via_bulk.flags = 0;
+}
+
+static bool via_bulk_stage(const uint8_t *data, uint16_t size) {
+    if (size > via_bulk.size - via_bulk.done) {
+        return false;
+    }
+    memcpy(&via_bulk_staging[via_bulk.done], data, size);
+    via_bulk.done += size;
+    return true;
+}
+
+static bool via_bulk_decompress(const uint8_t *payload, uint8_t length) {
+    uint8_t i = 0;
+    while (i < length) {
+        uint8_t  control = payload[i++];
+        uint16_t count   = (control & 0x7F) + 1;
+        if (control & 0x80) {
+            if (length - i < 2) {
+                return false;
+            }
+            for (uint16_t n = 0; n < count; n++) {
+                if (!via_bulk_stage(&payload[i], 2)) {
+                    return false;
+                }
+            }
+            i += 2;
+        } else {
+            if (length - i < count * 2 || !via_bulk_stage(&payload[i], count * 2)) {
+                return false;
+            }
+            i += count * 2;
+        }
+    }
+    return true;
+}
+
+static uint16_t via_bulk_read_keycode(uint16_t position) {
+    uint8_t keycode[2];
+    dynamic_keymap_get_buffer(via_bulk.offset + position, 2, keycode);
+    return (keycode[0] << 8) | keycode[1];
+}
+
+static uint8_t via_bulk_compress(uint8_t *payload, uint8_t room) {
+    uint8_t length = 0;
+    while (via_bulk.done < via_bulk.size && room - length >= 3) {
+        uint16_t remaining = (via_bulk.size - via_bulk.done) / 2;
+        uint16_t keycode   = via_bulk_read_keycode(via_bulk.done);
+        uint8_t  count     = 1;
+        while (count < 128 && count < remaining && via_bulk_read_keycode(via_bulk.done + count * 2) == keycode) {
+            count++;
+        }
+
+        if (count > 1) {
+            payload[length++] = 0x80 | (count - 1);
+            payload[length++] = keycode >> 8;
+            payload[length++] = keycode & 0xFF;
+            via_bulk.done += count * 2;
+            continue;
+        }
+
+        // Gather literals up to the start of the next run, or until the packet is full.
+        while (count < 128 && count < remaining && length + 1 + (count + 1) * 2 <= room) {
+            uint16_t next = via_bulk_read_keycode(via_bulk.done + count * 2);
+            if (count + 1 < remaining && via_bulk_read_keycode(via_bulk.done + (count + 1) * 2) == next) {
+                break;
+            }
+            count++;
+        }
+        payload[length++] = count - 1;
+        dynamic_keymap_get_buffer(via_bulk.offset + via_bulk.done, count * 2, &payload[length]);
+        length += count * 2;
+        via_bulk.done += count * 2;
+    }
+    return length;
+}
+
+static uint8_t via_bulk_begin(uint8_t *command_data) {
+    uint8_t  flags  = command_data[0];
+    uint16_t offset = (command_data[1] << 8) | command_data[2];
+    uint16_t size   = (command_data[3] << 8) | command_data[4];
+
+    // Starting a new transfer abandons whatever the previous one had staged.
+    via_bulk_abort();
+    if (size == 0 || (uint32_t)offset + size > via_bulk_keymap_size()) {
+        return VIA_BULK_ERROR_RANGE;
+    }
+    if ((flags & VIA_BULK_COMPRESSED) && ((offset | size) & 1)) {
+        return VIA_BULK_ERROR_RANGE;
+    }
+    // A write is staged whole and committed by the end command, so an
+    // interrupted transfer never leaves a partly updated keymap behind.
+    if ((flags & VIA_BULK_WRITE) && size > VIA_BULK_STAGING_SIZE) {
+        return VIA_BULK_ERROR_RANGE;
+    }
+
+    via_bulk = (via_bulk_state_t){
+        .flags  = (flags & (VIA_BULK_WRITE | VIA_BULK_COMPRESSED)) | VIA_BULK_ACTIVE,
+        .offset = offset,
+        .size   = size,
+    };
+    return VIA_BULK_OK;
+}
+
+// Returns false if the packet should not be acknowledged, i.e. it is neither
+// the last one of a window or of the transfer, nor was it rejected.
+static bool via_bulk_write(uint8_t *data, uint8_t length) {
+    uint8_t  seq     = data[3];
+    uint8_t  size    = data[4];
+    uint8_t *payload = &data[VIA_BULK_HEADER_SIZE];
+    uint8_t  status  = VIA_BULK_OK;
+
+    if ((via_bulk.flags & (VIA_BULK_ACTIVE | VIA_BULK_WRITE)) != (VIA_BULK_ACTIVE | VIA_BULK_WRITE)) {
+        status = VIA_BULK_ERROR_STATE;
+    } else if (seq != via_bulk.seq) {
+        status = VIA_BULK_ERROR_SEQUENCE;
+    } else if (size > length - VIA_BULK_HEADER_SIZE) {
+        status = VIA_BULK_ERROR_PAYLOAD;
+    } else if (!((via_bulk.flags & VIA_BULK_COMPRESSED) ? via_bulk_decompress(payload, size) : via_bulk_stage(payload, size))) {
+        status = VIA_BULK_ERROR_PAYLOAD;
+    }
+
+    if (status != VIA_BULK_OK) {
+        via_bulk_abort();
+    } else {
+        via_bulk.seq++;
+        if (via_bulk.seq % VIA_BULK_WINDOW_SIZE != 0 && via_bulk.done < via_bulk.size) {
+            return false;
+        }
+    }
+
+    data[3] = status;
+    data[4] = via_bulk.seq;
+    return true;
+}
+
+static void via_bulk_read(uint8_t *data, uint8_t length) {
+    uint8_t room   = length - VIA_BULK_HEADER_SIZE;
+    uint8_t status = VIA_BULK_OK;
+
+    if ((via_bulk.flags & (VIA_BULK_ACTIVE | VIA_BULK_WRITE)) != VIA_BULK_ACTIVE || via_bulk.done == via_bulk.size) {
+        status = VIA_BULK_ERROR_STATE;
+    } else if (data[3] != via_bulk.seq) {
+        status = VIA_BULK_ERROR_SEQUENCE;
+    }
+
+    if (status != VIA_BULK_OK) {
+        data[4] = VIA_BULK_ERROR_LENGTH;
+        data[5] = status;
+        raw_hid_send(data, length);
+        return;
+    }
+
+    for (uint8_t i = 0; i < VIA_BULK_WINDOW_SIZE && via_bulk.done < via_bulk.size; i++) {
+        uint8_t *payload = &data[VIA_BULK_HEADER_SIZE];
+        uint8_t  size;
+        if (via_bulk.flags & VIA_BULK_COMPRESSED) {
+            size = via_bulk_compress(payload, room);
+        } else {
+            size = MIN(room, via_bulk.size - via_bulk.done);
+            dynamic_keymap_get_buffer(via_bulk.offset + via_bulk.done, size, payload);
+            via_bulk.done += size;
+        }
+        memset(&payload[size], 0, room - size);
+
+        data[3] = via_bulk.seq++;
+        data[4] = size;
+        raw_hid_send(data, length);
+    }
+}
+
+static void via_bulk_end(uint8_t *command_data) {
+    uint8_t status = VIA_BULK_OK;
+    if (!(via_bulk.flags & VIA_BULK_ACTIVE)) {
+        status = VIA_BULK_ERROR_STATE;
+    } else if (via_bulk.done != via_bulk.size) {
+        status = VIA_BULK_ERROR_INCOMPLETE;
+    } else if (via_bulk.flags & VIA_BULK_WRITE) {
+        dynamic_keymap_set_buffer(via_bulk.offset, via_bulk.size, via_bulk_staging);
+    }
+
+    command_data[0] = status;
+    command_data[1] = via_bulk.done >> 8;
+    command_data[2] = via_bulk.done & 0xFF;
+    via_bulk_abort();
+}
+
+// data = [ id_custom_set_value, VIA_BULK_CHANNEL_ID, bulk command id, ... ]
+// Returns false if there is no reply to send, or it has already been sent.
+static bool via_bulk_command(uint8_t *data, uint8_t length) {
+    uint8_t *bulk_command_id = &(data[2]);
+    uint8_t *bulk_data       = &(data[3]);
+
+    switch (*bulk_command_id) {
+        case id_via_bulk_begin: {
+            bulk_data[0] = via_bulk_begin(bulk_data);
+            bulk_data[1] = VIA_BULK_WINDOW_SIZE;
+            bulk_data[2] = length - VIA_BULK_HEADER_SIZE;
+            bulk_data[3] = VIA_BULK_STAGING_SIZE >> 8;
+            bulk_data[4] = VIA_BULK_STAGING_SIZE & 0xFF;
+            return true;
+        }
+        case id_via_bulk_write: {
+            return via_bulk_write(data, length);
+        }
+        case id_via_bulk_read: {
+            // Replies with a whole window of packets on its own.
+            via_bulk_read(data, length);
+            return false;
+        }
+        case id_via_bulk_end: {
+            via_bulk_end(bulk_data);
+            return true;
+        }
+        default: {
+            data[0] = id_unhandled;
+            return true;
+        }
+    }
+}
+#endif // VIA_BULK_TRANSFER_ENABLE
+
 void raw_hid_receive(uint8_t *data, uint8_t length) {
     uint8_t *command_id   = &(data[0]);
     uint8_t *command_data = &(data[1]);
@@ -404,6 +656,14 @@ void raw_hid_receive(uint8_t *data, uint8_t length) {
         case id_custom_set_value:
         case id_custom_get_value:
         case id_custom_save: {
+#ifdef VIA_BULK_TRANSFER_ENABLE
+            if (*command_id == id_custom_set_value && command_data[0] == VIA_BULK_CHANNEL_ID) {
+                if (!via_bulk_command(data, length)) {
+                    return;
+                }
+                break;
+            }
+#endif
             via_custom_value_command(data, length);
             break;
         }
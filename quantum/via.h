@@ -51,6 +51,23 @@
 #    define VIA_FIRMWARE_VERSION 0x00000000
 #endif
 
+// Bulk keymap transfers (VIA_BULK_TRANSFER_ENABLE) let the host stream the
+// dynamic keymap without a round trip per 28-byte chunk. Writes are
+// acknowledged once per window of data packets, and are staged whole in RAM,
+// so NVM is only written once the transfer has ended successfully. The
+// staging area holds the whole keymap unless VIA_BULK_STAGING_SIZE is lowered
+// to save RAM, in which case longer writes are rejected.
+#ifndef VIA_BULK_WINDOW_SIZE
+#    define VIA_BULK_WINDOW_SIZE 8
+#endif
+
+// Bulk transfers are custom value commands on their own channel, so they
+// leave VIA's command ids and protocol version alone. Change this if a
+// keyboard's own custom values already use the channel.
+#ifndef VIA_BULK_CHANNEL_ID
+#    define VIA_BULK_CHANNEL_ID 0xF0
+#endif
+
 enum via_command_id {
     id_get_protocol_version                 = 0x01, // always 0x01
     id_get_keyboard_value                   = 0x02,
@@ -76,6 +93,46 @@ enum via_command_id {
     id_unhandled                            = 0xFF,
 };
 
+// Bulk keymap transfer protocol, all multi-byte values big endian. Every
+// packet starts with [ 0x07 (id_custom_set_value), VIA_BULK_CHANNEL_ID ],
+// left out below. Firmware without bulk transfers replies 0xFF (id_unhandled)
+// in place of 0x07.
+//
+// begin: [ 0x01, flags, offset(2), size(2) ]
+//     -> [ 0x01, status, window, max payload, max write size(2) ]
+// write: [ 0x02, seq, len, payload ] (no reply until the end of a window)
+//     -> [ 0x02, status, next seq ]
+// read:  [ 0x03, seq ]
+//     -> up to `window` packets of [ 0x03, seq, len, payload ],
+//        or [ 0x03, seq, 0xFF, status ] on error
+// end:   [ 0x04 ]
+//     -> [ 0x04, status, bytes transferred(2) ]
+//
+// Compressed payloads are a sequence of tokens over 16-bit keycodes: a control
+// byte `n` < 0x80 is followed by n+1 literal keycodes, and a control byte
+// 0x80|n is followed by a single keycode repeated n+1 times. A token never
+// spans two packets.
+enum via_bulk_command_id {
+    id_via_bulk_begin = 0x01,
+    id_via_bulk_write = 0x02,
+    id_via_bulk_read  = 0x03,
+    id_via_bulk_end   = 0x04,
+};
+
+enum via_bulk_flags {
+    VIA_BULK_WRITE      = (1 << 0),
+    VIA_BULK_COMPRESSED = (1 << 1),
+};
+
+enum via_bulk_status {
+    VIA_BULK_OK               = 0x00,
+    VIA_BULK_ERROR_STATE      = 0x01,
+    VIA_BULK_ERROR_RANGE      = 0x02,
+    VIA_BULK_ERROR_SEQUENCE   = 0x03,
+    VIA_BULK_ERROR_PAYLOAD    = 0x04,
+    VIA_BULK_ERROR_INCOMPLETE = 0x05,
+};
+
 enum via_keyboard_value_id {
     id_uptime              = 0x01,
     id_layout_options      = 0x02,
@@ -0,0 +1,120 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_keymap_key.hpp"
+
+extern "C" {
+#include "boot_trace.h"
+#include "usb_device_state.h"
+}
+
+using testing::_;
+
+class BootTrace : public TestFixture {
+   protected:
+    void SetUp() override {
+        boot_trace_reset();
+    }
+
+    static std::vector<boot_trace_entry_t> entries() {
+        std::vector<boot_trace_entry_t> result;
+        boot_trace_entry_t              entry;
+        for (uint8_t i = 0; boot_trace_get(i, &entry); i++) {
+            result.push_back(entry);
+        }
+        return result;
+    }
+
+    static int position(uint8_t stage) {
+        auto all = entries();
+        for (size_t i = 0; i < all.size(); i++) {
+            if (all[i].stage == stage) {
+                return i;
+            }
+        }
+        return -1;
+    }
+};
+
+TEST_F(BootTrace, KeyboardInitStagesAreRecordedInOrder) {
+    TestDriver driver;
+    keyboard_init();
+
+    auto all = entries();
+    ASSERT_GE(all.size(), 4u);
+
+    EXPECT_GE(position(BOOT_TRACE_KEYBOARD_INIT), 0);
+    EXPECT_LT(position(BOOT_TRACE_KEYBOARD_INIT), position(BOOT_TRACE_MATRIX));
+    EXPECT_LT(position(BOOT_TRACE_MATRIX), position(BOOT_TRACE_QUANTUM));
+    EXPECT_LT(position(BOOT_TRACE_QUANTUM), position(BOOT_TRACE_HOST));
+    EXPECT_LT(position(BOOT_TRACE_HOST), position(BOOT_TRACE_POST_INIT));
+
+    // Disabled features leave no trace
+    EXPECT_EQ(position(BOOT_TRACE_RGB_MATRIX), -1);
+    EXPECT_EQ(position(BOOT_TRACE_POINTING), -1);
+
+    for (size_t i = 1; i < all.size(); i++) {
+        EXPECT_GE(all[i].time_us, all[i - 1].time_us);
+    }
+}
+
+TEST_F(BootTrace, StagesBeforeKeyboardInitAreRecordedWithIt) {
+    TestDriver driver;
+
+    // As the protocol layer does, before keyboard_init() starts the timer
+    usb_device_state_init();
+    usb_device_state_set_reset();
+    EXPECT_EQ(boot_trace_count(), 0u);
+
+    idle_for(10);
+    keyboard_init();
+
+    auto all = entries();
+    ASSERT_GE(all.size(), 3u);
+    EXPECT_EQ(all[0].stage, BOOT_TRACE_USB_INIT);
+    EXPECT_EQ(all[1].stage, BOOT_TRACE_USB_RESET);
+    EXPECT_EQ(all[2].stage, BOOT_TRACE_KEYBOARD_INIT);
+    EXPECT_EQ(all[0].time_us, all[2].time_us);
+    EXPECT_EQ(all[1].time_us, all[2].time_us);
+
+    for (size_t i = 1; i < all.size(); i++) {
+        EXPECT_GE(all[i].time_us, all[i - 1].time_us);
+    }
+}
+
+TEST_F(BootTrace, MilestonesAreRecordedOnce) {
+    TestDriver driver;
+    KeymapKey  key_a = KeymapKey(0, 0, 0, KC_A);
+    set_keymap({key_a});
+
+    keyboard_init();
+    int initialised = boot_trace_count();
+
+    usb_device_state_set_configuration(true, 1);
+    EXPECT_EQ(boot_trace_count(), initialised + 1);
+    EXPECT_EQ(position(BOOT_TRACE_USB_CONFIGURED), initialised);
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_a);
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(boot_trace_count(), initialised + 2);
+    EXPECT_EQ(position(BOOT_TRACE_FIRST_REPORT), initialised + 1);
+
+    usb_device_state_set_reset();
+    usb_device_state_set_configuration(true, 1);
+    EXPECT_EQ(position(BOOT_TRACE_USB_CONFIGURED), initialised);
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_a);
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(boot_trace_count(), initialised + 3);
+    EXPECT_FALSE(boot_trace_get(boot_trace_count(), nullptr));
+
+    boot_trace_print();
+}
@@ -0,0 +1,140 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+using ::testing::_;
+using ::testing::AnyNumber;
+using ::testing::InSequence;
+
+class DynamicMacroDelay : public TestFixture {
+   protected:
+    KeymapKey rec1     = KeymapKey(0, 0, 0, DM_REC1);
+    KeymapKey stop     = KeymapKey(0, 2, 0, DM_RSTP);
+    KeymapKey play1    = KeymapKey(0, 3, 0, DM_PLY1);
+    KeymapKey key_a    = KeymapKey(0, 5, 0, KC_A);
+    KeymapKey key_b    = KeymapKey(0, 6, 0, KC_B);
+    KeymapKey key_lsft = KeymapKey(0, 7, 0, KC_LSFT);
+    KeymapKey toggle   = KeymapKey(0, 8, 0, TG(1));
+
+    void SetUp() override {
+        set_keymap({rec1, stop, play1, key_a, key_b, key_lsft, toggle, KeymapKey(1, 5, 0, KC_C), KeymapKey(1, 8, 0, KC_TRNS)});
+    }
+
+    void record(TestDriver &driver, const std::vector<KeymapKey> &keys) {
+        EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+        tap_key(rec1);
+        for (auto key : keys) {
+            tap_key(key);
+        }
+        tap_key(stop);
+        VERIFY_AND_CLEAR(driver);
+    }
+};
+
+TEST_F(DynamicMacroDelay, PlaysOneEventPerDelay) {
+    TestDriver driver;
+    record(driver, {key_a, key_b});
+
+    // The first event is played right away
+    EXPECT_REPORT(driver, (KC_A));
+    tap_key(play1);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_REPORT(driver);
+    idle_for(DYNAMIC_MACRO_DELAY - 3);
+    VERIFY_AND_CLEAR(driver);
+
+    {
+        InSequence s;
+        EXPECT_EMPTY_REPORT(driver);
+        EXPECT_REPORT(driver, (KC_B));
+        EXPECT_EMPTY_REPORT(driver);
+    }
+    idle_for(DYNAMIC_MACRO_DELAY * 4);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DynamicMacroDelay, KeyboardKeepsRunningDuringPlayback) {
+    TestDriver driver;
+    record(driver, {key_a, key_b});
+
+    EXPECT_REPORT(driver, (KC_A));
+    tap_key(play1);
+    VERIFY_AND_CLEAR(driver);
+
+    // A key pressed by the user is reported while the macro is still playing
+    EXPECT_REPORT(driver, (KC_A, KC_LSFT));
+    key_lsft.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    {
+        InSequence s;
+        EXPECT_REPORT(driver, (KC_LSFT));
+        EXPECT_REPORT(driver, (KC_LSFT, KC_B));
+    }
+    idle_for(DYNAMIC_MACRO_DELAY * 2);
+    VERIFY_AND_CLEAR(driver);
+
+    {
+        InSequence s;
+        EXPECT_REPORT(driver, (KC_B));
+        EXPECT_EMPTY_REPORT(driver);
+    }
+    key_lsft.release();
+    idle_for(DYNAMIC_MACRO_DELAY * 2);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DynamicMacroDelay, KeepsLayerChangedDuringPlayback) {
+    TestDriver driver;
+    record(driver, {key_a});
+
+    EXPECT_REPORT(driver, (KC_A));
+    tap_key(play1);
+    VERIFY_AND_CLEAR(driver);
+
+    // Toggled on by the user before the macro has finished
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(toggle);
+    idle_for(DYNAMIC_MACRO_DELAY * 3);
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_TRUE(layer_state_is(1));
+
+    {
+        InSequence s;
+        EXPECT_REPORT(driver, (KC_C));
+        EXPECT_EMPTY_REPORT(driver);
+    }
+    tap_key(key_a);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DynamicMacroDelay, KeepsKeyHeldPastTheEndOfPlayback) {
+    TestDriver driver;
+    record(driver, {key_a});
+
+    EXPECT_REPORT(driver, (KC_A));
+    tap_key(play1);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_A, KC_LSFT));
+    key_lsft.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // Only the macro's own key is released when it ends
+    EXPECT_REPORT(driver, (KC_LSFT));
+    idle_for(DYNAMIC_MACRO_DELAY * 3);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_lsft.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,190 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+using ::testing::_;
+using ::testing::AnyNumber;
+using ::testing::InSequence;
+
+class DynamicMacro : public TestFixture {
+   protected:
+    KeymapKey rec1   = KeymapKey(0, 0, 0, DM_REC1);
+    KeymapKey rec2   = KeymapKey(0, 1, 0, DM_REC2);
+    KeymapKey stop   = KeymapKey(0, 2, 0, DM_RSTP);
+    KeymapKey play1  = KeymapKey(0, 3, 0, DM_PLY1);
+    KeymapKey play2  = KeymapKey(0, 4, 0, DM_PLY2);
+    KeymapKey key_a  = KeymapKey(0, 5, 0, KC_A);
+    KeymapKey key_b  = KeymapKey(0, 6, 0, KC_B);
+    KeymapKey key_lsft = KeymapKey(0, 7, 0, KC_LSFT);
+
+    void SetUp() override {
+        set_keymap({rec1, rec2, stop, play1, play2, key_a, key_b, key_lsft});
+    }
+
+    void record(TestDriver &driver, KeymapKey &start, const std::vector<KeymapKey> &keys) {
+        EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+        tap_key(start);
+        for (auto key : keys) {
+            tap_key(key);
+        }
+        tap_key(stop);
+        VERIFY_AND_CLEAR(driver);
+    }
+};
+
+TEST_F(DynamicMacro, PlaysBackRecordedKeys) {
+    TestDriver driver;
+    record(driver, rec1, {key_a, key_b});
+
+    {
+        InSequence s;
+        EXPECT_REPORT(driver, (KC_A));
+        EXPECT_EMPTY_REPORT(driver);
+        EXPECT_REPORT(driver, (KC_B));
+        EXPECT_EMPTY_REPORT(driver);
+    }
+    tap_key(play1);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DynamicMacro, PlaysBackHeldModifiers) {
+    TestDriver driver;
+    {
+        EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+        tap_key(rec2);
+        key_lsft.press();
+        run_one_scan_loop();
+        tap_key(key_a);
+        key_lsft.release();
+        run_one_scan_loop();
+        tap_key(stop);
+        VERIFY_AND_CLEAR(driver);
+    }
+
+    {
+        InSequence s;
+        EXPECT_REPORT(driver, (KC_LSFT));
+        EXPECT_REPORT(driver, (KC_LSFT, KC_A));
+        EXPECT_REPORT(driver, (KC_LSFT));
+        EXPECT_EMPTY_REPORT(driver);
+    }
+    tap_key(play2);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DynamicMacro, RepeatedTapsArePlayedBack) {
+    TestDriver driver;
+    std::vector<KeymapKey> keys(50, key_a);
+    keys.push_back(key_b);
+    record(driver, rec1, keys);
+
+    {
+        InSequence s;
+        for (int i = 0; i < 50; i++) {
+            EXPECT_REPORT(driver, (KC_A));
+            EXPECT_EMPTY_REPORT(driver);
+        }
+        EXPECT_REPORT(driver, (KC_B));
+        EXPECT_EMPTY_REPORT(driver);
+    }
+    tap_key(play1);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DynamicMacro, HoldsMoreEventsThanUnpackedRecords) {
+    TestDriver driver;
+    // 16 events, twice what DYNAMIC_MACRO_SIZE unpacked records would hold
+    record(driver, rec1, {key_a, key_b, key_a, key_b, key_a, key_b, key_a, key_b});
+
+    {
+        InSequence s;
+        for (int i = 0; i < 4; i++) {
+            EXPECT_REPORT(driver, (KC_A));
+            EXPECT_EMPTY_REPORT(driver);
+            EXPECT_REPORT(driver, (KC_B));
+            EXPECT_EMPTY_REPORT(driver);
+        }
+    }
+    tap_key(play1);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DynamicMacro, BothMacrosShareTheBuffer) {
+    TestDriver driver;
+    record(driver, rec1, {key_a, key_b});
+    record(driver, rec2, {key_b, key_a});
+
+    {
+        InSequence s;
+        EXPECT_REPORT(driver, (KC_B));
+        EXPECT_EMPTY_REPORT(driver);
+        EXPECT_REPORT(driver, (KC_A));
+        EXPECT_EMPTY_REPORT(driver);
+    }
+    tap_key(play2);
+    VERIFY_AND_CLEAR(driver);
+
+    {
+        InSequence s;
+        EXPECT_REPORT(driver, (KC_A));
+        EXPECT_EMPTY_REPORT(driver);
+        EXPECT_REPORT(driver, (KC_B));
+        EXPECT_EMPTY_REPORT(driver);
+    }
+    tap_key(play1);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DynamicMacro, FullBufferKeepsWholeTaps) {
+    TestDriver driver;
+    std::vector<KeymapKey> keys;
+    for (int i = 0; i < 40; i++) {
+        keys.push_back(i % 2 ? key_b : key_a);
+    }
+    record(driver, rec1, keys);
+
+    std::vector<report_keyboard_t> reports;
+    EXPECT_ANY_REPORT(driver).WillRepeatedly([&](report_keyboard_t &report) { reports.push_back(report); });
+    tap_key(play1);
+    VERIFY_AND_CLEAR(driver);
+
+    // Only a prefix fitted, but every press is followed by its release
+    ASSERT_GT(reports.size(), 0u);
+    ASSERT_LT(reports.size(), 80u);
+    ASSERT_EQ(reports.size() % 2, 0u);
+    for (size_t i = 0; i < reports.size(); i += 2) {
+        EXPECT_EQ(reports[i].keys[0], i % 4 ? KC_B : KC_A);
+        EXPECT_EQ(reports[i + 1].keys[0], KC_NO);
+    }
+}
+
+TEST_F(DynamicMacro, FullBufferDropsKeyWhoseReleaseDidNotFit) {
+    TestDriver driver;
+    std::vector<KeymapKey> keys;
+    for (int i = 0; i < 40; i++) {
+        keys.push_back(i % 2 ? key_b : key_a);
+    }
+    {
+        EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+        tap_key(rec1);
+        key_lsft.press();
+        run_one_scan_loop();
+        for (auto key : keys) {
+            tap_key(key);
+        }
+        key_lsft.release();
+        run_one_scan_loop();
+        tap_key(stop);
+        VERIFY_AND_CLEAR(driver);
+    }
+
+    // Shift was held across everything that fitted, so nothing is left to play
+    EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+    tap_key(play1);
+    VERIFY_AND_CLEAR(driver);
+}
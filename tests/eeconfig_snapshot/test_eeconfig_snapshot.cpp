@@ -0,0 +1,56 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+
+extern "C" {
+#include "eeconfig.h"
+#include "eeprom.h"
+#include "nvm_eeconfig.h"
+#include "nvm_eeprom_eeconfig_internal.h"
+}
+
+using testing::_;
+
+class EeconfigSnapshot : public TestFixture {};
+
+TEST_F(EeconfigSnapshot, UpdatesAreWrittenThrough) {
+    keymap_config_t keymap_config;
+    eeconfig_read_keymap(&keymap_config);
+    keymap_config.swap_lalt_lgui = !keymap_config.swap_lalt_lgui;
+    eeconfig_update_keymap(&keymap_config);
+
+    EXPECT_EQ(eeprom_read_word(EECONFIG_KEYMAP), keymap_config.raw);
+
+    keymap_config_t read_back;
+    eeconfig_read_keymap(&read_back);
+    EXPECT_EQ(read_back.raw, keymap_config.raw);
+}
+
+TEST_F(EeconfigSnapshot, ReadsAreServedFromSnapshot) {
+    EXPECT_FALSE(eeconfig_read_handedness());
+
+    // Bypassing the eeconfig API is not seen until the snapshot is reloaded
+    eeprom_update_byte(EECONFIG_HANDEDNESS, 1);
+    EXPECT_FALSE(eeconfig_read_handedness());
+
+    nvm_eeconfig_erase();
+    EXPECT_TRUE(eeconfig_read_handedness());
+
+    eeconfig_update_handedness(false);
+    EXPECT_EQ(eeprom_read_byte(EECONFIG_HANDEDNESS), 0);
+}
+
+TEST_F(EeconfigSnapshot, MultiByteFieldsRoundTrip) {
+    eeconfig_update_kb(0x12345678);
+    EXPECT_EQ(eeconfig_read_kb(), 0x12345678u);
+    EXPECT_EQ(eeprom_read_dword(EECONFIG_KEYBOARD), 0x12345678u);
+
+    EXPECT_TRUE(eeconfig_is_enabled());
+    eeconfig_disable();
+    EXPECT_FALSE(eeconfig_is_enabled());
+    EXPECT_EQ(eeprom_read_word(EECONFIG_MAGIC), EECONFIG_MAGIC_NUMBER_OFF);
+    eeconfig_init();
+    EXPECT_TRUE(eeconfig_is_enabled());
+}
@@ -0,0 +1,11 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define NUM_ENCODERS 1
+#define ENCODER_MAP_KEY_DELAY 0
+#define ENCODER_COALESCE_DETENTS
+#define ENCODER_MAP_COALESCE_SCROLL
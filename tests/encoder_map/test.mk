@@ -0,0 +1,11 @@
+# Copyright 2025 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+ENCODER_ENABLE = yes
+ENCODER_DRIVER = custom
+ENCODER_MAP_ENABLE = yes
+MOUSEKEY_ENABLE = yes
+POINTING_DEVICE_ENABLE = yes
+POINTING_DEVICE_DRIVER = custom
+
+INTROSPECTION_KEYMAP_C = test_encoder_maps.c
@@ -0,0 +1,122 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "mouse_report_util.hpp"
+#include "test_common.hpp"
+#include "test_keymap_key.hpp"
+#include "test_pointing_device_driver.h"
+
+extern "C" {
+#include "encoder.h"
+
+void encoder_driver_init(void) {}
+void encoder_driver_task(void) {}
+}
+
+using testing::_;
+using testing::InSequence;
+
+static int  wheel_presses;
+static bool block_wheel;
+
+extern "C" bool process_record_user(uint16_t keycode, keyrecord_t *record) {
+    if (keycode == MS_WHLD && record->event.pressed) {
+        wheel_presses++;
+    }
+    return !(block_wheel && keycode == MS_WHLD);
+}
+
+class EncoderMap : public TestFixture {
+   protected:
+    void SetUp() override {
+        // The fixture keymap stands in for encoder_map, so the encoder positions are mapped here
+        set_keymap({
+            KeymapKey(0, 0, KEYLOC_ENCODER_CW, MS_WHLD),
+            KeymapKey(0, 0, KEYLOC_ENCODER_CCW, KC_A),
+            KeymapKey(1, 0, KEYLOC_ENCODER_CW, MS_WHLU),
+        });
+        encoder_init();
+        wheel_presses = 0;
+        block_wheel   = false;
+    }
+};
+
+TEST_F(EncoderMap, wheel_detents_are_sent_in_one_report) {
+    TestDriver driver;
+
+    EXPECT_NO_REPORT(driver);
+    EXPECT_MOUSE_REPORT(driver, (0, 0, 0, -3, 0)).Times(1);
+    encoder_queue_delta(0, true, 3);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(EncoderMap, wheel_overflow_is_carried_to_next_report) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_MOUSE_REPORT(driver, (0, 0, 0, MOUSE_REPORT_HV_MIN, 0));
+    EXPECT_MOUSE_REPORT(driver, (0, 0, 0, -200 - MOUSE_REPORT_HV_MIN, 0));
+    encoder_queue_delta(0, true, 200);
+    run_one_scan_loop();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_MOUSE_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(EncoderMap, wheel_detents_join_pointing_device_report) {
+    TestDriver driver;
+
+    EXPECT_MOUSE_REPORT(driver, (5, 0, 0, -3, 0)).Times(1);
+    pd_set_x(5);
+    encoder_queue_delta(0, true, 3);
+    run_one_scan_loop();
+    pd_clear_movement();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(EncoderMap, other_keycodes_are_tapped_per_detent) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    encoder_queue_delta(0, false, 2);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(EncoderMap, wheel_detents_are_seen_by_process_record) {
+    TestDriver driver;
+
+    EXPECT_MOUSE_REPORT(driver, (0, 0, 0, -3, 0)).Times(1);
+    encoder_queue_delta(0, true, 3);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(wheel_presses, 3);
+
+    block_wheel = true;
+    EXPECT_NO_MOUSE_REPORT(driver);
+    encoder_queue_delta(0, true, 3);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(wheel_presses, 6);
+}
+
+TEST_F(EncoderMap, wheel_detents_follow_the_active_layer) {
+    TestDriver driver;
+
+    layer_on(1);
+    EXPECT_MOUSE_REPORT(driver, (0, 0, 0, 2, 0)).Times(1);
+    encoder_queue_delta(0, true, 2);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+    layer_off(1);
+}
@@ -0,0 +1,50 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include "gtest/gtest.h"
+#include "test_common.hpp"
+#include "key_override_test_config.h"
+
+/**
+ * @brief Measures the per-event cost of process_key_override() against the number of key overrides.
+ *
+ * The override array is padded with Shift overrides on triggers that are never pressed, and a non-trigger key is then tapped while Shift is held, which is the worst case for the override search.
+ */
+static void run_key_override_benchmark(const char* variant) {
+    static const uint16_t counts[]   = {8, 32, 64, 128, 250};
+    const uint32_t        iterations = 20000;
+
+    keyrecord_t record = {};
+    record.event.type  = KEY_EVENT;
+
+    register_mods(MOD_BIT(KC_LEFT_SHIFT));
+
+    for (uint16_t count : counts) {
+        ASSERT_LE(count, KEY_OVERRIDE_TEST_CAPACITY);
+
+        key_override_test_pad(count);
+
+        auto start = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < iterations; i++) {
+            record.event.pressed = true;
+            EXPECT_TRUE(process_key_override(KC_G, &record));
+            record.event.pressed = false;
+            EXPECT_TRUE(process_key_override(KC_G, &record));
+        }
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+
+        double per_event = (double)elapsed.count() / (iterations * 2);
+        std::cout << "[ BENCH    ] key_override " << variant << ": " << std::setw(3) << count << " overrides, " << std::fixed << std::setprecision(1) << per_event << " ns/event" << std::endl;
+        testing::Test::RecordProperty(std::string(variant) + "_ns_per_event_" + std::to_string(count), std::to_string(per_event));
+    }
+
+    unregister_mods(MOD_BIT(KC_LEFT_SHIFT));
+
+    key_override_test_reset();
+}
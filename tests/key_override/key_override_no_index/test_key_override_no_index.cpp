@@ -0,0 +1,19 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+#include "../key_override_benchmark.hpp"
+
+using testing::_;
+using testing::AnyNumber;
+
+class KeyOverrideNoIndex : public TestFixture {};
+
+TEST_F(KeyOverrideNoIndex, benchmark_per_event_cost) {
+    TestDriver driver;
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    run_key_override_benchmark("linear");
+    VERIFY_AND_CLEAR(driver);
+}
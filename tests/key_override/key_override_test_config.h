@@ -0,0 +1,24 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+
+#define KEY_OVERRIDE_TEST_CAPACITY 256
+#define KEY_OVERRIDE_TEST_STATIC_COUNT 4
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Appends a Shift + G = H override and reindexes */
+void key_override_test_add_shift_g(void);
+/** Pads the key overrides with never matching Shift overrides up to `count` entries and reindexes */
+void key_override_test_pad(uint16_t count);
+/** Removes every override added at runtime */
+void key_override_test_reset(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,156 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+#include "key_override_benchmark.hpp"
+
+using testing::_;
+using testing::AnyNumber;
+using testing::InSequence;
+
+class KeyOverride : public TestFixture {};
+
+TEST_F(KeyOverride, activates_on_trigger_down) {
+    TestDriver driver;
+    InSequence s;
+    auto       shift_key = KeymapKey(0, 0, 0, KC_LEFT_SHIFT);
+    auto       a_key     = KeymapKey(0, 1, 0, KC_A);
+
+    set_keymap({shift_key, a_key});
+
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    shift_key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // The first matching override in array order wins
+    EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+    EXPECT_REPORT(driver, (KC_B));
+    a_key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    a_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    shift_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyOverride, does_not_activate_without_mods) {
+    TestDriver driver;
+    auto       a_key = KeymapKey(0, 1, 0, KC_A);
+
+    set_keymap({a_key});
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(a_key);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyOverride, activates_on_required_mod_down) {
+    TestDriver driver;
+    InSequence s;
+    auto       shift_key = KeymapKey(0, 0, 0, KC_LEFT_SHIFT);
+    auto       a_key     = KeymapKey(0, 1, 0, KC_A);
+
+    set_keymap({shift_key, a_key});
+
+    EXPECT_REPORT(driver, (KC_A));
+    a_key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // Pressing Shift while A is the last held key activates the override through the last key bucket
+    EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+    EXPECT_REPORT(driver, (KC_B));
+    shift_key.press();
+    idle_for(KEY_OVERRIDE_REPEAT_DELAY);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT)).Times(AnyNumber());
+    EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+    a_key.release();
+    run_one_scan_loop();
+    shift_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyOverride, activates_mods_only_override) {
+    TestDriver driver;
+    InSequence s;
+    auto       ctrl_key  = KeymapKey(0, 0, 0, KC_LEFT_CTRL);
+    auto       shift_key = KeymapKey(0, 1, 0, KC_LEFT_SHIFT);
+
+    set_keymap({ctrl_key, shift_key});
+
+    EXPECT_REPORT(driver, (KC_LEFT_CTRL));
+    ctrl_key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // The trigger-less Ctrl + Shift override is found without any non-mod key being held
+    EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+    EXPECT_REPORT(driver, (KC_D));
+    shift_key.press();
+    idle_for(KEY_OVERRIDE_REPEAT_DELAY);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    shift_key.release();
+    run_one_scan_loop();
+    ctrl_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyOverride, reindex_picks_up_runtime_changes) {
+    TestDriver driver;
+    InSequence s;
+    auto       shift_key = KeymapKey(0, 0, 0, KC_LEFT_SHIFT);
+    auto       g_key     = KeymapKey(0, 1, 0, KC_G);
+
+    set_keymap({shift_key, g_key});
+
+    key_override_test_add_shift_g();
+
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    shift_key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+    EXPECT_REPORT(driver, (KC_H));
+    g_key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    g_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    shift_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    key_override_test_reset();
+}
+
+TEST_F(KeyOverride, benchmark_per_event_cost) {
+    TestDriver driver;
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    run_key_override_benchmark("indexed");
+    VERIFY_AND_CLEAR(driver);
+}
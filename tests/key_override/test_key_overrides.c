@@ -0,0 +1,45 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "quantum.h"
+#include "key_override_test_config.h"
+
+// Shift + A = B
+const key_override_t shift_a_override = ko_make_basic(MOD_MASK_SHIFT, KC_A, KC_B);
+// Shift + A = C, shadowed by the override above
+const key_override_t shift_a_shadowed_override = ko_make_basic(MOD_MASK_SHIFT, KC_A, KC_C);
+// Ctrl + Shift = D, without a trigger key
+const key_override_t ctrl_shift_override = ko_make_basic(MOD_MASK_CTRL | MOD_MASK_SHIFT, KC_NO, KC_D);
+// Ctrl + Shift + E = F, shadowed by the override above as it comes later in the array
+const key_override_t ctrl_shift_e_override = ko_make_basic(MOD_MASK_CTRL | MOD_MASK_SHIFT, KC_E, KC_F);
+
+// Shift + G = H, only added at runtime
+static const key_override_t shift_g_override = ko_make_basic(MOD_MASK_SHIFT, KC_G, KC_H);
+
+// The array is sized for the benchmark, which fills the trailing NULL slots at runtime
+const key_override_t *key_overrides[KEY_OVERRIDE_TEST_CAPACITY] = {
+    &shift_a_override,
+    &shift_a_shadowed_override,
+    &ctrl_shift_override,
+    &ctrl_shift_e_override,
+};
+
+static key_override_t padding[KEY_OVERRIDE_TEST_CAPACITY];
+
+void key_override_test_add_shift_g(void) {
+    key_overrides[KEY_OVERRIDE_TEST_STATIC_COUNT] = &shift_g_override;
+    key_override_reindex();
+}
+
+void key_override_test_pad(uint16_t count) {
+    for (uint16_t i = KEY_OVERRIDE_TEST_STATIC_COUNT; i < KEY_OVERRIDE_TEST_CAPACITY; i++) {
+        // Shift overrides on custom keycodes that are never pressed
+        padding[i]       = ko_make_basic(MOD_MASK_SHIFT, QK_USER + i, KC_NO);
+        key_overrides[i] = i < count ? &padding[i] : NULL;
+    }
+    key_override_reindex();
+}
+
+void key_override_test_reset(void) {
+    key_override_test_pad(0);
+}
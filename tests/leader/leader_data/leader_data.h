@@ -0,0 +1,42 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/*******************************************************************************
+  88888888888 888      d8b                .d888 d8b 888               d8b
+      888     888      Y8P               d88P"  Y8P 888               Y8P
+      888     888                        888        888
+      888     88888b.  888 .d8888b       888888 888 888  .d88b.       888 .d8888b
+      888     888 "88b 888 88K           888    888 888 d8P  Y8b      888 88K
+      888     888  888 888 "Y8888b.      888    888 888 88888888      888 "Y8888b.
+      888     888  888 888      X88      888    888 888 Y8b.          888      X88
+      888     888  888 888  88888P'      888    888 888  "Y8888       888  88888P'
+                                                        888                 888
+                                                        888                 888
+                                                        888                 888
+     .d88b.   .d88b.  88888b.   .d88b.  888d888 8888b.  888888 .d88b.   .d88888
+    d88P"88b d8P  Y8b 888 "88b d8P  Y8b 888P"      "88b 888   d8P  Y8b d88" 888
+    888  888 88888888 888  888 88888888 888    .d888888 888   88888888 888  888
+    Y88b 888 Y8b.     888  888 Y8b.     888    888  888 Y88b. Y8b.     Y88b 888
+     "Y88888  "Y8888  888  888  "Y8888  888    "Y888888  "Y888 "Y8888   "Y88888
+         888
+    Y8b d88P
+     "Y88P"
+*******************************************************************************/
+
+#pragma once
+
+// Leader sequences (5 entries):
+//   KC_A                               -> KC_1
+//   KC_A KC_B                          -> KC_2
+//   KC_A KC_B KC_C KC_D KC_E KC_F KC_G -> KC_7
+//   KC_C KC_D                          -> LSFT(KC_3)
+//   KC_X KC_Y KC_Z                     -> KC_9
+
+#define LEADER_DATA_MAX_LENGTH 7
+#define LEADER_DATA_SIZE 42
+
+static const uint16_t leader_data[LEADER_DATA_SIZE] PROGMEM = {
+    0x0003, KC_A, 7, KC_C, 29, KC_X, 34, 0x8001, KC_1, KC_B, 11, 0x8001, KC_2, KC_C, 15, 0x0001,
+    KC_D, 18, 0x0001, KC_E, 21, 0x0001, KC_F, 24, 0x0001, KC_G, 27, 0x8000, KC_7, 0x0001, KC_D, 32,
+    0x8000, LSFT(KC_3), 0x0001, KC_Y, 37, 0x0001, KC_Z, 40, 0x8000, KC_9
+};
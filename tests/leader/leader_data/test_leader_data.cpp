@@ -0,0 +1,133 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+class LeaderData : public TestFixture {
+   protected:
+    KeymapKey key_leader = KeymapKey(0, 0, 0, QK_LEADER);
+    KeymapKey key_a      = KeymapKey(0, 1, 0, KC_A);
+    KeymapKey key_b      = KeymapKey(0, 2, 0, KC_B);
+    KeymapKey key_c      = KeymapKey(0, 3, 0, KC_C);
+    KeymapKey key_d      = KeymapKey(0, 4, 0, KC_D);
+    KeymapKey key_e      = KeymapKey(0, 5, 0, KC_E);
+    KeymapKey key_f      = KeymapKey(0, 6, 0, KC_F);
+    KeymapKey key_g      = KeymapKey(0, 7, 0, KC_G);
+    KeymapKey key_x      = KeymapKey(0, 8, 0, KC_X);
+    KeymapKey key_y      = KeymapKey(0, 9, 0, KC_Y);
+
+    void SetUp() override {
+        set_keymap({key_leader, key_a, key_b, key_c, key_d, key_e, key_f, key_g, key_x, key_y});
+    }
+};
+
+TEST_F(LeaderData, unambiguous_sequence_fires_without_timeout) {
+    TestDriver driver;
+
+    EXPECT_NO_REPORT(driver);
+    tap_key(key_leader);
+    tap_key(key_c);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(leader_sequence_active(), true);
+
+    {
+        InSequence s;
+        EXPECT_REPORT(driver, (KC_LSFT));
+        EXPECT_REPORT(driver, (KC_LSFT, KC_3));
+        EXPECT_REPORT(driver, (KC_LSFT));
+        EXPECT_EMPTY_REPORT(driver);
+    }
+    tap_key(key_d);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(leader_sequence_active(), false);
+    EXPECT_EQ(leader_sequence_timed_out(), false);
+}
+
+TEST_F(LeaderData, prefix_sequence_waits_for_timeout) {
+    TestDriver driver;
+
+    EXPECT_NO_REPORT(driver);
+    tap_key(key_leader);
+    tap_key(key_a);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(leader_sequence_active(), true);
+
+    EXPECT_REPORT(driver, (KC_1));
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(300);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(leader_sequence_active(), false);
+}
+
+TEST_F(LeaderData, longest_match_wins_after_timeout) {
+    TestDriver driver;
+
+    EXPECT_NO_REPORT(driver);
+    tap_key(key_leader);
+    tap_key(key_a);
+    tap_key(key_b);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_2));
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(300);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(LeaderData, sequences_longer_than_five_keys) {
+    TestDriver driver;
+
+    EXPECT_NO_REPORT(driver);
+    tap_key(key_leader);
+    for (auto key : {key_a, key_b, key_c, key_d, key_e, key_f}) {
+        tap_key(key);
+    }
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_7));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_g);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(leader_sequence_active(), false);
+}
+
+TEST_F(LeaderData, unknown_sequence_sends_nothing) {
+    TestDriver driver;
+
+    EXPECT_NO_REPORT(driver);
+    tap_key(key_leader);
+    tap_key(key_x);
+    tap_key(key_a);
+    idle_for(300);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(leader_sequence_active(), false);
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_a);
+}
+
+TEST_F(LeaderData, incomplete_sequence_sends_nothing) {
+    TestDriver driver;
+
+    EXPECT_NO_REPORT(driver);
+    tap_key(key_leader);
+    tap_key(key_x);
+    tap_key(key_y);
+    idle_for(300);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(leader_sequence_active(), false);
+}
@@ -0,0 +1,7 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+// Same dictionary as the leader_data tests
+#include "../leader_data/leader_data.h"
@@ -0,0 +1,44 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+
+extern "C" {
+// Ends the sequence on KC_B, which is followed by longer sequences in the dictionary.
+bool leader_add_user(uint16_t keycode) {
+    return keycode == KC_B;
+}
+}
+
+class LeaderDataAddUser : public TestFixture {
+   protected:
+    KeymapKey key_leader = KeymapKey(0, 0, 0, QK_LEADER);
+    KeymapKey key_a      = KeymapKey(0, 1, 0, KC_A);
+    KeymapKey key_b      = KeymapKey(0, 2, 0, KC_B);
+
+    void SetUp() override {
+        set_keymap({key_leader, key_a, key_b});
+    }
+};
+
+TEST_F(LeaderDataAddUser, ending_on_the_final_key_dispatches_the_full_sequence) {
+    TestDriver driver;
+
+    EXPECT_NO_REPORT(driver);
+    tap_key(key_leader);
+    tap_key(key_a);
+    VERIFY_AND_CLEAR(driver);
+
+    // KC_A KC_B -> KC_2, not the KC_A -> KC_1 prefix
+    EXPECT_REPORT(driver, (KC_2));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_b);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(leader_sequence_active(), false);
+}
@@ -0,0 +1,9 @@
+// Copyright 2025 QMK Contributors
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define POINTING_DEVICE_ACCUMULATE_ENABLE
+#define POINTING_DEVICE_TASK_THROTTLE_MS 4
@@ -0,0 +1,143 @@
+// Copyright 2025 QMK Contributors
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include "mouse_report_util.hpp"
+#include "test_common.hpp"
+#include "test_pointing_device_driver.h"
+
+using testing::_;
+
+// The synthetic sensor reports the configured motion on every sample, i.e. once per scan loop, while reports are only
+// built every POINTING_DEVICE_TASK_THROTTLE_MS. The fixture resets the timer, so reports go out at multiples of 4ms.
+class PointingAccumulate : public TestFixture {
+   protected:
+    void SyncToReportBoundary() {
+        pd_clear_movement();
+        idle_for(POINTING_DEVICE_TASK_THROTTLE_MS);
+    }
+};
+
+TEST_F(PointingAccumulate, CoalescesSamplesIntoOneReport) {
+    TestDriver driver;
+    SyncToReportBoundary();
+
+    pd_set_x(3);
+    pd_set_y(-2);
+    EXPECT_MOUSE_REPORT(driver, (3, -2, 0, 0, 0));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // Four samples, one report
+    EXPECT_MOUSE_REPORT(driver, (12, -8, 0, 0, 0));
+    idle_for(POINTING_DEVICE_TASK_THROTTLE_MS);
+    VERIFY_AND_CLEAR(driver);
+
+    pd_clear_movement();
+    EXPECT_NO_MOUSE_REPORT(driver);
+    idle_for(POINTING_DEVICE_TASK_THROTTLE_MS * 2);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(PointingAccumulate, CarriesMotionThatDoesNotFitIntoReport) {
+    TestDriver driver;
+    SyncToReportBoundary();
+
+    pd_set_x(100);
+    EXPECT_MOUSE_REPORT(driver, (100, 0, 0, 0, 0));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_MOUSE_REPORT(driver, (127, 0, 0, 0, 0));
+    idle_for(POINTING_DEVICE_TASK_THROTTLE_MS);
+    VERIFY_AND_CLEAR(driver);
+
+    // The sensor stopped, but 273 counts are still owed to the host
+    pd_clear_movement();
+    {
+        testing::InSequence s;
+        EXPECT_MOUSE_REPORT(driver, (127, 0, 0, 0, 0)).Times(2);
+        EXPECT_MOUSE_REPORT(driver, (19, 0, 0, 0, 0));
+    }
+    idle_for(POINTING_DEVICE_TASK_THROTTLE_MS * 3);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_MOUSE_REPORT(driver);
+    idle_for(POINTING_DEVICE_TASK_THROTTLE_MS * 2);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(PointingAccumulate, KeepsButtonChangesBetweenReports) {
+    TestDriver driver;
+    SyncToReportBoundary();
+
+    // Pressed and sampled right after a report, sent with the next one
+    EXPECT_NO_MOUSE_REPORT(driver);
+    run_one_scan_loop();
+    pd_press_button(POINTING_DEVICE_BUTTON1);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_MOUSE_REPORT(driver, (0, 0, 0, 0, 1));
+    idle_for(POINTING_DEVICE_TASK_THROTTLE_MS - 1);
+    VERIFY_AND_CLEAR(driver);
+
+    pd_release_button(POINTING_DEVICE_BUTTON1);
+    EXPECT_EMPTY_MOUSE_REPORT(driver);
+    idle_for(POINTING_DEVICE_TASK_THROTTLE_MS);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(PointingAccumulate, SendsClickShorterThanReportPeriod) {
+    TestDriver driver;
+    SyncToReportBoundary();
+
+    // Pressed and released again before the next report is built
+    EXPECT_NO_MOUSE_REPORT(driver);
+    run_one_scan_loop();
+    pd_press_button(POINTING_DEVICE_BUTTON1);
+    run_one_scan_loop();
+    pd_release_button(POINTING_DEVICE_BUTTON1);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    {
+        testing::InSequence s;
+        EXPECT_MOUSE_REPORT(driver, (0, 0, 0, 0, 1));
+        EXPECT_EMPTY_MOUSE_REPORT(driver);
+    }
+    idle_for(POINTING_DEVICE_TASK_THROTTLE_MS * 2);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(PointingAccumulate, SendsReleaseBeforeRepress) {
+    TestDriver driver;
+    SyncToReportBoundary();
+
+    pd_press_button(POINTING_DEVICE_BUTTON1);
+    EXPECT_MOUSE_REPORT(driver, (0, 0, 0, 0, 1));
+    idle_for(POINTING_DEVICE_TASK_THROTTLE_MS);
+    VERIFY_AND_CLEAR(driver);
+
+    // Released and pressed again before the next report is built
+    EXPECT_NO_MOUSE_REPORT(driver);
+    run_one_scan_loop();
+    pd_release_button(POINTING_DEVICE_BUTTON1);
+    run_one_scan_loop();
+    pd_press_button(POINTING_DEVICE_BUTTON1);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    {
+        testing::InSequence s;
+        EXPECT_EMPTY_MOUSE_REPORT(driver);
+        EXPECT_MOUSE_REPORT(driver, (0, 0, 0, 0, 1));
+    }
+    idle_for(POINTING_DEVICE_TASK_THROTTLE_MS * 2);
+    VERIFY_AND_CLEAR(driver);
+
+    pd_release_button(POINTING_DEVICE_BUTTON1);
+    EXPECT_EMPTY_MOUSE_REPORT(driver);
+    idle_for(POINTING_DEVICE_TASK_THROTTLE_MS);
+    VERIFY_AND_CLEAR(driver);
+}
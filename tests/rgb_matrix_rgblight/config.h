@@ -0,0 +1,13 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define RGB_MATRIX_LED_COUNT 4
+#define RGBLIGHT_LED_COUNT 3
+#define RGB_MATRIX_LED_FLUSH_LIMIT 16
+
+// The extended rgblight config sits past the default 32 bytes of the test EEPROM
+#define TOTAL_EEPROM_BYTE_COUNT 64
@@ -0,0 +1,7 @@
+# Copyright 2025 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+RGB_MATRIX_ENABLE = yes
+RGB_MATRIX_DRIVER = custom
+RGBLIGHT_ENABLE = yes
+RGBLIGHT_DRIVER = rgb_matrix
@@ -0,0 +1,111 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "test_common.hpp"
+
+using testing::_;
+
+extern "C" {
+#include "rgb_matrix.h"
+#include "rgblight.h"
+
+led_config_t g_led_config = {
+    {{0, 1, 2, 3}},
+    {{0, 0}, {75, 0}, {150, 0}, {224, 0}},
+    {LED_FLAG_KEYLIGHT, LED_FLAG_KEYLIGHT, LED_FLAG_KEYLIGHT, LED_FLAG_KEYLIGHT},
+};
+}
+
+static const int LED_COUNT = RGB_MATRIX_LED_COUNT + RGBLIGHT_LED_COUNT;
+
+// What the custom driver holds, and what it last sent to the LEDs.
+static rgb_t buffer[LED_COUNT];
+static rgb_t sent[LED_COUNT];
+static int   flushes;
+
+static void driver_init(void) {}
+
+static void driver_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
+    ASSERT_LT(index, LED_COUNT);
+    buffer[index] = {red, green, blue};
+}
+
+static void driver_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
+    for (int i = 0; i < LED_COUNT; i++) {
+        driver_set_color(i, red, green, blue);
+    }
+}
+
+static void driver_flush(void) {
+    memcpy(sent, buffer, sizeof(sent));
+    flushes++;
+}
+
+extern "C" const rgb_matrix_driver_t rgb_matrix_driver = {
+    .init          = driver_init,
+    .set_color     = driver_set_color,
+    .set_color_all = driver_set_color_all,
+    .flush         = driver_flush,
+};
+
+static bool is_red(const rgb_t &led) {
+    return led.r > 0 && led.g == 0 && led.b == 0;
+}
+
+static bool is_blue(const rgb_t &led) {
+    return led.r == 0 && led.g == 0 && led.b > 0;
+}
+
+class RGBMatrixRGBLight : public TestFixture {
+   protected:
+    TestDriver driver;
+
+    void SetUp() override {
+        rgb_matrix_enable_noeeprom();
+        rgb_matrix_mode_noeeprom(RGB_MATRIX_SOLID_COLOR);
+        rgb_matrix_sethsv_noeeprom(HSV_RED);
+        rgblight_enable_noeeprom();
+        rgblight_mode_noeeprom(RGBLIGHT_MODE_STATIC_LIGHT);
+        rgblight_sethsv_noeeprom(HSV_BLUE);
+        idle_for(RGB_MATRIX_LED_FLUSH_LIMIT * 4);
+    }
+};
+
+TEST_F(RGBMatrixRGBLight, BothLayersAreSentInOneBuffer) {
+    for (int i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        EXPECT_TRUE(is_red(sent[i])) << "matrix LED " << i;
+    }
+    for (int i = RGB_MATRIX_LED_COUNT; i < LED_COUNT; i++) {
+        EXPECT_TRUE(is_blue(sent[i])) << "rgblight LED " << i - RGB_MATRIX_LED_COUNT;
+    }
+}
+
+TEST_F(RGBMatrixRGBLight, MatrixFramesLeaveTheRGBLightLEDsAlone) {
+    rgb_matrix_sethsv_noeeprom(HSV_GREEN);
+    idle_for(RGB_MATRIX_LED_FLUSH_LIMIT * 4);
+
+    for (int i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        EXPECT_GT(sent[i].g, 0) << "matrix LED " << i;
+    }
+    for (int i = RGB_MATRIX_LED_COUNT; i < LED_COUNT; i++) {
+        EXPECT_TRUE(is_blue(sent[i])) << "rgblight LED " << i - RGB_MATRIX_LED_COUNT;
+    }
+}
+
+TEST_F(RGBMatrixRGBLight, RGBLightChangesGoOutWithTheMatrixFlush) {
+    // With RGB Matrix off, its task runs RGB_MATRIX_NONE and stops flushing, but rgblight changes still have to reach
+    // the LEDs.
+    rgb_matrix_disable_noeeprom();
+    idle_for(RGB_MATRIX_LED_FLUSH_LIMIT * 4);
+    int idle_flushes = flushes;
+    idle_for(RGB_MATRIX_LED_FLUSH_LIMIT * 4);
+    EXPECT_EQ(flushes, idle_flushes);
+
+    rgblight_sethsv_noeeprom(HSV_RED);
+    idle_for(RGB_MATRIX_LED_FLUSH_LIMIT * 4);
+
+    EXPECT_GT(flushes, idle_flushes);
+    for (int i = RGB_MATRIX_LED_COUNT; i < LED_COUNT; i++) {
+        EXPECT_TRUE(is_red(sent[i])) << "rgblight LED " << i - RGB_MATRIX_LED_COUNT;
+    }
+}
@@ -0,0 +1,136 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "action_tapping.h"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+extern "C" {
+#include "action.h"
+
+void advance_time_us(uint32_t us);
+}
+
+using testing::_;
+using testing::InSequence;
+
+class KeyeventTimeUs : public TestFixture {};
+
+TEST_F(KeyeventTimeUs, tap_released_within_tapping_term) {
+    TestDriver driver;
+    InSequence s;
+    auto       mod_tap_hold_key = KeymapKey(0, 1, 0, SFT_T(KC_P));
+
+    set_keymap({mod_tap_hold_key});
+
+    EXPECT_NO_REPORT(driver);
+    mod_tap_hold_key.press();
+    idle_for(TAPPING_TERM - 1);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_P));
+    EXPECT_EMPTY_REPORT(driver);
+    mod_tap_hold_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyeventTimeUs, hold_after_tapping_term) {
+    TestDriver driver;
+    InSequence s;
+    auto       mod_tap_hold_key = KeymapKey(0, 1, 0, SFT_T(KC_P));
+
+    set_keymap({mod_tap_hold_key});
+
+    EXPECT_NO_REPORT(driver);
+    mod_tap_hold_key.press();
+    idle_for(TAPPING_TERM);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_LSFT));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    mod_tap_hold_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyeventTimeUs, tap_released_less_than_a_millisecond_before_tapping_term) {
+    TestDriver driver;
+    InSequence s;
+    auto       mod_tap_hold_key = KeymapKey(0, 1, 0, SFT_T(KC_P));
+
+    set_keymap({mod_tap_hold_key});
+
+    // Pressed at 0.5 ms and released at TAPPING_TERM + 0.3 ms, so the key is held 0.2 ms short of the tapping term
+    // even though the millisecond timestamps are TAPPING_TERM apart.
+    EXPECT_NO_REPORT(driver);
+    advance_time_us(500);
+    mod_tap_hold_key.press();
+    run_one_scan_loop();
+    idle_for(TAPPING_TERM - 3);
+    advance_time_us(800);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_P));
+    EXPECT_EMPTY_REPORT(driver);
+    mod_tap_hold_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyeventTimeUs, not_held_until_the_whole_tapping_term_has_passed) {
+    TestDriver driver;
+    InSequence s;
+    auto       mod_tap_hold_key = KeymapKey(0, 1, 0, SFT_T(KC_P));
+
+    set_keymap({mod_tap_hold_key});
+
+    // Pressed at 0.9 ms. At TAPPING_TERM + 0.1 ms the millisecond timestamps are TAPPING_TERM apart, but only
+    // TAPPING_TERM - 0.8 ms have passed.
+    EXPECT_NO_REPORT(driver);
+    advance_time_us(900);
+    mod_tap_hold_key.press();
+    run_one_scan_loop();
+    idle_for(TAPPING_TERM - 2);
+    advance_time_us(200);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_LSFT));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    mod_tap_hold_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyeventTimeUs, event_without_microsecond_time) {
+    TestDriver driver;
+    InSequence s;
+    auto       mod_tap_hold_key = KeymapKey(0, 1, 0, SFT_T(KC_P));
+
+    set_keymap({mod_tap_hold_key});
+    idle_for(1000);
+
+    // Built by hand, as a dynamic macro or a keyboard's own code might, rather than by MAKE_KEYEVENT()
+    keyevent_t press = {.key = mod_tap_hold_key.position, .time = timer_read(), .type = KEY_EVENT, .pressed = true};
+
+    EXPECT_NO_REPORT(driver);
+    action_exec(press);
+    idle_for(TAPPING_TERM - 1);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_P));
+    EXPECT_EMPTY_REPORT(driver);
+    keyevent_t release = {.key = mod_tap_hold_key.position, .time = timer_read(), .type = KEY_EVENT, .pressed = false};
+    action_exec(release);
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,138 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+class UnicodeBatched : public TestFixture {
+   protected:
+    void SetUp() override {
+        set_unicode_input_mode(UNICODE_MODE_LINUX);
+        unicode_reset_stats();
+    }
+};
+
+static void expect_linux_prefix(TestDriver &driver) {
+    EXPECT_REPORT(driver, (KC_LEFT_CTRL, KC_LEFT_SHIFT));
+    EXPECT_REPORT(driver, (KC_LEFT_CTRL, KC_LEFT_SHIFT, KC_U));
+    EXPECT_REPORT(driver, (KC_LEFT_CTRL, KC_LEFT_SHIFT));
+    EXPECT_EMPTY_REPORT(driver);
+}
+
+static void expect_linux_suffix(TestDriver &driver) {
+    EXPECT_REPORT(driver, (KC_SPACE));
+    EXPECT_EMPTY_REPORT(driver);
+}
+
+TEST_F(UnicodeBatched, rolls_between_digits) {
+    TestDriver driver;
+    InSequence s;
+
+    auto key_uc = KeymapKey(0, 0, 0, UC(0x2013)); // –
+    set_keymap({key_uc});
+
+    expect_linux_prefix(driver);
+    EXPECT_REPORT(driver, (KC_2));
+    EXPECT_REPORT(driver, (KC_0));
+    EXPECT_REPORT(driver, (KC_1));
+    EXPECT_REPORT(driver, (KC_3));
+    EXPECT_EMPTY_REPORT(driver);
+    expect_linux_suffix(driver);
+    tap_key(key_uc);
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(UnicodeBatched, releases_between_repeated_digits) {
+    TestDriver driver;
+    InSequence s;
+
+    expect_linux_prefix(driver);
+    EXPECT_REPORT(driver, (KC_0));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_0));
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    expect_linux_suffix(driver);
+    register_unicode(0x00AA); // ª
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(UnicodeBatched, string_lifts_caps_lock_once) {
+    TestDriver driver;
+    InSequence s;
+
+    led_t leds = {.caps_lock = true};
+    driver.set_leds(leds.raw);
+
+    EXPECT_REPORT(driver, (KC_CAPS_LOCK));
+    EXPECT_EMPTY_REPORT(driver);
+    expect_linux_prefix(driver);
+    EXPECT_REPORT(driver, (KC_0));
+    EXPECT_REPORT(driver, (KC_3));
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_REPORT(driver, (KC_8));
+    EXPECT_EMPTY_REPORT(driver);
+    expect_linux_suffix(driver);
+    expect_linux_prefix(driver);
+    EXPECT_REPORT(driver, (KC_2));
+    EXPECT_REPORT(driver, (KC_0));
+    EXPECT_REPORT(driver, (KC_1));
+    EXPECT_REPORT(driver, (KC_3));
+    EXPECT_EMPTY_REPORT(driver);
+    expect_linux_suffix(driver);
+    EXPECT_REPORT(driver, (KC_CAPS_LOCK));
+    EXPECT_EMPTY_REPORT(driver);
+    send_unicode_string("Ψ–");
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(UnicodeBatched, restores_mods_after_string) {
+    TestDriver driver;
+
+    EXPECT_ANY_REPORT(driver).Times(testing::AnyNumber());
+    register_mods(MOD_BIT(KC_LEFT_ALT));
+    send_unicode_string("ΨΨ");
+    EXPECT_EQ(get_mods(), MOD_BIT(KC_LEFT_ALT));
+    unregister_mods(MOD_BIT(KC_LEFT_ALT));
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(UnicodeBatched, counts_code_points) {
+    TestDriver driver;
+    unicode_stats_t stats;
+
+    EXPECT_ANY_REPORT(driver).Times(testing::AnyNumber());
+    register_unicode(0x03A8);
+    send_unicode_string("ΨΨΨ");
+    register_unicode(0x110000); // Out of range, not counted
+    VERIFY_AND_CLEAR(driver);
+
+    unicode_get_stats(&stats);
+    EXPECT_EQ(stats.code_points, 4u);
+}
+
+TEST_F(UnicodeBatched, reports_chars_per_second) {
+    TestDriver driver;
+    unicode_stats_t stats;
+
+    EXPECT_EQ(unicode_get_chars_per_second(), 0u);
+
+    EXPECT_ANY_REPORT(driver).Times(testing::AnyNumber());
+    send_unicode_string("ΨΨΨΨ");
+    VERIFY_AND_CLEAR(driver);
+
+    unicode_get_stats(&stats);
+    EXPECT_EQ(stats.code_points, 4u);
+    ASSERT_GT(stats.elapsed_ms, 0u);
+    EXPECT_EQ(unicode_get_chars_per_second(), 4000u / stats.elapsed_ms);
+}
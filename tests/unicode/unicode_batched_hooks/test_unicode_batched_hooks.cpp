@@ -0,0 +1,71 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+extern "C" {
+void unicode_input_start(void) {
+    tap_code(KC_F13);
+    tap_code16(LCTL(LSFT(KC_U)));
+}
+
+void unicode_input_finish(void) {
+    tap_code(KC_SPACE);
+    tap_code(KC_F14);
+}
+}
+
+class UnicodeBatchedHooks : public TestFixture {
+   protected:
+    void SetUp() override {
+        set_unicode_input_mode(UNICODE_MODE_LINUX);
+    }
+};
+
+static void expect_linux_prefix(TestDriver &driver) {
+    EXPECT_REPORT(driver, (KC_LEFT_CTRL, KC_LEFT_SHIFT));
+    EXPECT_REPORT(driver, (KC_LEFT_CTRL, KC_LEFT_SHIFT, KC_U));
+    EXPECT_REPORT(driver, (KC_LEFT_CTRL, KC_LEFT_SHIFT));
+    EXPECT_EMPTY_REPORT(driver);
+}
+
+static void expect_psi(TestDriver &driver) {
+    EXPECT_REPORT(driver, (KC_0));
+    EXPECT_REPORT(driver, (KC_3));
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_REPORT(driver, (KC_8));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_SPACE));
+    EXPECT_EMPTY_REPORT(driver);
+}
+
+TEST_F(UnicodeBatchedHooks, string_calls_input_hooks_once) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_REPORT(driver, (KC_F13));
+    EXPECT_EMPTY_REPORT(driver);
+    expect_linux_prefix(driver);
+    expect_psi(driver);
+    expect_linux_prefix(driver);
+    expect_psi(driver);
+    EXPECT_REPORT(driver, (KC_F14));
+    EXPECT_EMPTY_REPORT(driver);
+    send_unicode_string("ΨΨ");
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(UnicodeBatchedHooks, empty_string_skips_input_hooks) {
+    TestDriver driver;
+
+    EXPECT_NO_REPORT(driver);
+    send_unicode_string("");
+
+    VERIFY_AND_CLEAR(driver);
+}
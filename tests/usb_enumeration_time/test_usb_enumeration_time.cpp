@@ -0,0 +1,38 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+
+extern "C" {
+#include "usb_device_state.h"
+}
+
+using testing::_;
+
+class UsbEnumerationTime : public TestFixture {};
+
+static uint32_t enumerated_calls;
+static uint32_t enumerated_time;
+
+extern "C" void usb_enumerated_user(uint32_t boot_time_ms) {
+    enumerated_calls++;
+    enumerated_time = boot_time_ms;
+}
+
+TEST_F(UsbEnumerationTime, IsReportedOnce) {
+    TestDriver driver;
+
+    EXPECT_NO_REPORT(driver);
+    idle_for(50);
+    uint32_t now = timer_read32();
+
+    usb_device_state_set_configuration(true, 1);
+    EXPECT_EQ(enumerated_calls, 1u);
+    EXPECT_GE(enumerated_time, now);
+    EXPECT_EQ(usb_device_state_get_enumeration_time(), enumerated_time);
+
+    usb_device_state_set_reset();
+    usb_device_state_set_configuration(true, 1);
+    EXPECT_EQ(enumerated_calls, 1u);
+}
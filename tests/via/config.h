@@ -0,0 +1,13 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define VIA_BULK_TRANSFER_ENABLE
+#define VIA_BULK_WINDOW_SIZE 4
+#define DYNAMIC_KEYMAP_LAYER_COUNT 4
+
+// Sized like an ATmega32U4, so the dynamic keymaps fit in the test EEPROM
+#define TOTAL_EEPROM_BYTE_COUNT 1024
@@ -0,0 +1,346 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <cstdint>
+#include <vector>
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+
+extern "C" {
+#include "dynamic_keymap.h"
+#include "host.h"
+#include "raw_hid.h"
+#include "via.h"
+}
+
+// Matches RAW_EPSIZE, the raw HID report size VIA uses.
+static constexpr uint8_t packet_size = 32;
+
+using Packet = std::array<uint8_t, packet_size>;
+
+static constexpr uint16_t layer_size  = MATRIX_ROWS * MATRIX_COLS * 2;
+static constexpr uint16_t keymap_size = DYNAMIC_KEYMAP_LAYER_COUNT * layer_size;
+// Behind id_custom_set_value, the channel, the bulk command id, seq and len
+static constexpr uint8_t  max_payload = packet_size - 5;
+// The two layers sample_keymap() fills
+static constexpr uint16_t sample_size = 2 * layer_size;
+
+static std::vector<Packet> replies;
+
+static void capture_raw_hid(uint8_t *data, uint8_t length) {
+    Packet packet{};
+    std::copy(data, data + length, packet.begin());
+    replies.push_back(packet);
+}
+
+class ViaBulk : public TestFixture {
+   protected:
+    host_driver_t raw_driver;
+
+    void SetUp() override {
+        dynamic_keymap_reset();
+    }
+
+    std::vector<Packet> send_raw(Packet packet) {
+        // Route raw HID replies into `replies` on top of the driver installed by the test.
+        if (host_get_driver() != &raw_driver) {
+            raw_driver              = *host_get_driver();
+            raw_driver.send_raw_hid = capture_raw_hid;
+            host_set_driver(&raw_driver);
+        }
+        replies.clear();
+        raw_hid_receive(packet.data(), packet.size());
+        return replies;
+    }
+
+    // Sends a bulk command on its custom value channel, and returns the replies with that prefix removed.
+    std::vector<Packet> send(const std::vector<uint8_t> &command) {
+        Packet packet{id_custom_set_value, VIA_BULK_CHANNEL_ID};
+        std::copy(command.begin(), command.end(), packet.begin() + 2);
+
+        std::vector<Packet> bulk_replies;
+        for (auto &reply : send_raw(packet)) {
+            EXPECT_EQ(reply[0], id_custom_set_value);
+            EXPECT_EQ(reply[1], VIA_BULK_CHANNEL_ID);
+            Packet bulk_reply{};
+            std::copy(reply.begin() + 2, reply.end(), bulk_reply.begin());
+            bulk_replies.push_back(bulk_reply);
+        }
+        return bulk_replies;
+    }
+
+    uint8_t begin(uint8_t flags, uint16_t offset, uint16_t size) {
+        auto reply = send({id_via_bulk_begin, flags, (uint8_t)(offset >> 8), (uint8_t)offset, (uint8_t)(size >> 8), (uint8_t)size});
+        EXPECT_EQ(reply.size(), 1u);
+        EXPECT_EQ(reply[0][2], VIA_BULK_WINDOW_SIZE);
+        EXPECT_EQ(reply[0][3], max_payload);
+        EXPECT_EQ((reply[0][4] << 8) | reply[0][5], keymap_size);
+        return reply[0][1];
+    }
+
+    std::vector<Packet> write(uint8_t seq, const std::vector<uint8_t> &payload) {
+        std::vector<uint8_t> command{id_via_bulk_write, seq, (uint8_t)payload.size()};
+        command.insert(command.end(), payload.begin(), payload.end());
+        return send(command);
+    }
+
+    Packet end() {
+        auto reply = send({id_via_bulk_end});
+        EXPECT_EQ(reply.size(), 1u);
+        return reply[0];
+    }
+
+    // Writes `payloads` one packet at a time, checking that only window ends and the final packet are acknowledged.
+    void write_all(const std::vector<std::vector<uint8_t>> &payloads) {
+        for (size_t i = 0; i < payloads.size(); i++) {
+            auto reply = write(i, payloads[i]);
+            if ((i + 1) % VIA_BULK_WINDOW_SIZE == 0 || i + 1 == payloads.size()) {
+                ASSERT_EQ(reply.size(), 1u);
+                EXPECT_EQ(reply[0][1], VIA_BULK_OK);
+                EXPECT_EQ(reply[0][2], i + 1);
+            } else {
+                EXPECT_TRUE(reply.empty());
+            }
+        }
+    }
+
+    // Reads the rest of the current transfer, one window per request.
+    std::vector<uint8_t> read_all(bool compressed) {
+        std::vector<uint8_t> result;
+        uint8_t              seq = 0;
+        while (true) {
+            auto packets = send({id_via_bulk_read, seq});
+            EXPECT_LE(packets.size(), (size_t)VIA_BULK_WINDOW_SIZE);
+            for (auto &packet : packets) {
+                if (packet[2] == 0xFF) {
+                    return result;
+                }
+                EXPECT_EQ(packet[1], seq);
+                seq++;
+                std::vector<uint8_t> payload(packet.begin() + 3, packet.begin() + 3 + packet[2]);
+                std::vector<uint8_t> bytes = compressed ? decompress(payload) : payload;
+                result.insert(result.end(), bytes.begin(), bytes.end());
+            }
+        }
+    }
+
+    static std::vector<uint8_t> to_bytes(const std::vector<uint16_t> &keycodes) {
+        std::vector<uint8_t> bytes;
+        for (auto keycode : keycodes) {
+            bytes.push_back(keycode >> 8);
+            bytes.push_back(keycode & 0xFF);
+        }
+        return bytes;
+    }
+
+    static std::vector<std::vector<uint8_t>> chunk(const std::vector<uint8_t> &bytes) {
+        std::vector<std::vector<uint8_t>> payloads;
+        for (size_t i = 0; i < bytes.size(); i += max_payload) {
+            payloads.emplace_back(bytes.begin() + i, bytes.begin() + std::min(bytes.size(), i + max_payload));
+        }
+        return payloads;
+    }
+
+    // Host-side encoder: runs of two or more keycodes become run tokens, anything else is grouped into literal tokens.
+    static std::vector<std::vector<uint8_t>> compress(const std::vector<uint16_t> &keycodes) {
+        std::vector<std::vector<uint8_t>> payloads(1);
+        size_t                            literal = SIZE_MAX; // index of the open literal token's control byte
+        for (size_t i = 0; i < keycodes.size();) {
+            size_t run = 1;
+            while (run < 128 && i + run < keycodes.size() && keycodes[i + run] == keycodes[i]) {
+                run++;
+            }
+            auto &payload = payloads.back();
+            if (run == 1 && literal != SIZE_MAX && payload[literal] < 127 && payload.size() + 2 <= max_payload) {
+                payload[literal]++;
+            } else {
+                if (payloads.back().size() + 3 > max_payload) {
+                    payloads.emplace_back();
+                }
+                literal = run > 1 ? SIZE_MAX : payloads.back().size();
+                payloads.back().push_back(run > 1 ? 0x80 | (run - 1) : 0);
+            }
+            payloads.back().push_back(keycodes[i] >> 8);
+            payloads.back().push_back(keycodes[i] & 0xFF);
+            i += run;
+        }
+        return payloads;
+    }
+
+    static std::vector<uint8_t> decompress(const std::vector<uint8_t> &payload) {
+        std::vector<uint8_t> bytes;
+        for (size_t i = 0; i < payload.size();) {
+            uint8_t control = payload[i++];
+            size_t  count   = (control & 0x7F) + 1;
+            if (control & 0x80) {
+                for (size_t n = 0; n < count; n++) {
+                    bytes.push_back(payload[i]);
+                    bytes.push_back(payload[i + 1]);
+                }
+                i += 2;
+            } else {
+                bytes.insert(bytes.end(), payload.begin() + i, payload.begin() + i + count * 2);
+                i += count * 2;
+            }
+        }
+        return bytes;
+    }
+
+    static std::vector<uint16_t> sample_keymap() {
+        std::vector<uint16_t> keycodes(sample_size / 2, KC_TRANSPARENT);
+        for (size_t i = 0; i < MATRIX_ROWS * MATRIX_COLS; i++) {
+            keycodes[i] = KC_A + (i % 26);
+        }
+        for (size_t i = MATRIX_ROWS * MATRIX_COLS; i < 2 * MATRIX_ROWS * MATRIX_COLS; i += 7) {
+            keycodes[i] = KC_LSFT;
+        }
+        return keycodes;
+    }
+
+    static std::vector<uint8_t> nvm_contents(uint16_t size = keymap_size) {
+        std::vector<uint8_t> bytes(size);
+        dynamic_keymap_get_buffer(0, size, bytes.data());
+        return bytes;
+    }
+};
+
+TEST_F(ViaBulk, UncompressedWriteIsAcknowledgedPerWindow) {
+    TestDriver driver;
+    auto       bytes = to_bytes(sample_keymap());
+
+    EXPECT_EQ(begin(VIA_BULK_WRITE, 0, sample_size), VIA_BULK_OK);
+    write_all(chunk(bytes));
+    auto reply = end();
+    EXPECT_EQ(reply[1], VIA_BULK_OK);
+    EXPECT_EQ((reply[2] << 8) | reply[3], sample_size);
+
+    EXPECT_EQ(nvm_contents(sample_size), bytes);
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 0, 1), KC_B);
+}
+
+TEST_F(ViaBulk, CompressedRoundTrip) {
+    TestDriver driver;
+    auto       keycodes = sample_keymap();
+    auto       payloads = compress(keycodes);
+    EXPECT_LT(payloads.size(), chunk(to_bytes(keycodes)).size());
+
+    EXPECT_EQ(begin(VIA_BULK_WRITE | VIA_BULK_COMPRESSED, 0, sample_size), VIA_BULK_OK);
+    write_all(payloads);
+    EXPECT_EQ(end()[1], VIA_BULK_OK);
+    EXPECT_EQ(nvm_contents(sample_size), to_bytes(keycodes));
+
+    // Reads are not staged, so one transfer covers the whole keymap
+    EXPECT_EQ(begin(VIA_BULK_COMPRESSED, 0, keymap_size), VIA_BULK_OK);
+    EXPECT_EQ(read_all(true), nvm_contents());
+    EXPECT_EQ(end()[1], VIA_BULK_OK);
+}
+
+TEST_F(ViaBulk, UncompressedReadMatchesBufferReads) {
+    TestDriver driver;
+    auto       before = nvm_contents();
+
+    EXPECT_EQ(begin(0, 40, 100), VIA_BULK_OK);
+    auto bytes = read_all(false);
+    EXPECT_EQ(bytes, std::vector<uint8_t>(before.begin() + 40, before.begin() + 140));
+    EXPECT_EQ(end()[1], VIA_BULK_OK);
+}
+
+TEST_F(ViaBulk, WritesAreDeferredUntilEnd) {
+    TestDriver driver;
+    auto       before = nvm_contents();
+    auto       bytes  = to_bytes(std::vector<uint16_t>(32, KC_Z));
+
+    EXPECT_EQ(begin(VIA_BULK_WRITE, 0, bytes.size()), VIA_BULK_OK);
+    auto payloads = chunk(bytes);
+    EXPECT_TRUE(write(0, payloads[0]).empty());
+    EXPECT_TRUE(write(1, payloads[1]).empty());
+    EXPECT_EQ(nvm_contents(), before);
+
+    EXPECT_EQ(write(2, payloads[2]).size(), 1u);
+    EXPECT_EQ(nvm_contents(), before);
+
+    EXPECT_EQ(end()[1], VIA_BULK_OK);
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 0, 0), KC_Z);
+}
+
+TEST_F(ViaBulk, OutOfSequencePacketAbortsTransfer) {
+    TestDriver driver;
+    auto       before = nvm_contents();
+
+    EXPECT_EQ(begin(VIA_BULK_WRITE, 0, 64), VIA_BULK_OK);
+    EXPECT_TRUE(write(0, std::vector<uint8_t>(max_payload, 0x11)).empty());
+
+    auto reply = write(2, std::vector<uint8_t>(max_payload, 0x22));
+    ASSERT_EQ(reply.size(), 1u);
+    EXPECT_EQ(reply[0][1], VIA_BULK_ERROR_SEQUENCE);
+    EXPECT_EQ(reply[0][2], 1);
+
+    EXPECT_EQ(end()[1], VIA_BULK_ERROR_STATE);
+    EXPECT_EQ(nvm_contents(), before);
+}
+
+TEST_F(ViaBulk, IncompleteTransferIsDiscarded) {
+    TestDriver driver;
+    auto       before = nvm_contents();
+
+    EXPECT_EQ(begin(VIA_BULK_WRITE, 0, 64), VIA_BULK_OK);
+    write(0, std::vector<uint8_t>(max_payload, 0x11));
+
+    auto reply = end();
+    EXPECT_EQ(reply[1], VIA_BULK_ERROR_INCOMPLETE);
+    EXPECT_EQ((reply[2] << 8) | reply[3], max_payload);
+    EXPECT_EQ(nvm_contents(), before);
+}
+
+TEST_F(ViaBulk, RejectsInvalidRanges) {
+    TestDriver driver;
+
+    EXPECT_EQ(begin(VIA_BULK_WRITE, keymap_size - 2, 4), VIA_BULK_ERROR_RANGE);
+    EXPECT_EQ(begin(VIA_BULK_WRITE, 0, 0), VIA_BULK_ERROR_RANGE);
+    EXPECT_EQ(begin(VIA_BULK_WRITE | VIA_BULK_COMPRESSED, 1, 4), VIA_BULK_ERROR_RANGE);
+    EXPECT_EQ(begin(VIA_BULK_WRITE, keymap_size - 2, 2), VIA_BULK_OK);
+}
+
+TEST_F(ViaBulk, WholeKeymapIsCommittedByOneEnd) {
+    TestDriver driver;
+    auto       before = nvm_contents();
+    auto       bytes  = std::vector<uint8_t>(keymap_size);
+    for (size_t i = 0; i < bytes.size(); i++) {
+        bytes[i] = i * 7;
+    }
+
+    EXPECT_EQ(begin(VIA_BULK_WRITE, 0, keymap_size), VIA_BULK_OK);
+    write_all(chunk(bytes));
+    EXPECT_EQ(nvm_contents(), before);
+
+    auto reply = end();
+    EXPECT_EQ(reply[1], VIA_BULK_OK);
+    EXPECT_EQ((reply[2] << 8) | reply[3], keymap_size);
+    EXPECT_EQ(nvm_contents(), bytes);
+}
+
+TEST_F(ViaBulk, LeavesViaCommandSpaceAlone) {
+    TestDriver driver;
+
+    auto version = send_raw({id_get_protocol_version});
+    ASSERT_EQ(version.size(), 1u);
+    EXPECT_EQ((version[0][1] << 8) | version[0][2], 0x000C);
+
+    auto unknown = send_raw({id_custom_set_value, VIA_BULK_CHANNEL_ID, 0x7F});
+    ASSERT_EQ(unknown.size(), 1u);
+    EXPECT_EQ(unknown[0][0], id_unhandled);
+}
+
+TEST_F(ViaBulk, AbortedWriteLeavesKeymapUntouched) {
+    TestDriver driver;
+    auto       before = nvm_contents();
+
+    // Two windows have been acknowledged when the transfer is abandoned for a new one
+    EXPECT_EQ(begin(VIA_BULK_WRITE, 0, keymap_size), VIA_BULK_OK);
+    write_all(chunk(std::vector<uint8_t>(max_payload * VIA_BULK_WINDOW_SIZE * 2, 0x11)));
+    EXPECT_EQ(begin(0, 0, 2), VIA_BULK_OK);
+
+    EXPECT_EQ(nvm_contents(), before);
+}
@@ -0,0 +1,6 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+/* Stands in for platforms/chibios/chibios_config.h, which needs the MCU headers. */
@@ -0,0 +1,118 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+/* Just enough of the ChibiOS HAL for usb_driver.c to run on the host. There
+ * are no threads, so the locks do nothing and waiting for a buffer times out
+ * straight away. The test plays the host by completing transmissions. */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifndef TRUE
+#    define TRUE 1
+#endif
+#ifndef FALSE
+#    define FALSE 0
+#endif
+
+#define HAL_USE_USB TRUE
+
+typedef uint32_t systime_t;
+typedef uint32_t sysinterval_t;
+typedef int32_t  msg_t;
+
+#define TIME_IMMEDIATE ((sysinterval_t)0)
+#define TIME_INFINITE ((sysinterval_t)-1)
+
+#define MSG_OK ((msg_t)0)
+#define MSG_TIMEOUT ((msg_t)-1)
+#define MSG_RESET ((msg_t)-2)
+
+#define osalSysLock()
+#define osalSysUnlock()
+#define osalSysLockFromISR()
+#define osalSysUnlockFromISR()
+#define osalOsRescheduleS()
+#define osalDbgCheck(c) (void)(c)
+#define osalDbgAssert(c, remark) (void)(c)
+
+#include "hal_buffers.h"
+
+#define USB_MAX_ENDPOINTS 8
+
+#define USB_EP_MODE_TYPE_CTRL 0x0000U
+#define USB_EP_MODE_TYPE_ISOC 0x0001U
+#define USB_EP_MODE_TYPE_BULK 0x0002U
+#define USB_EP_MODE_TYPE_INTR 0x0003U
+
+typedef uint8_t          usbep_t;
+typedef struct USBDriver USBDriver;
+typedef bool (*usbreqhandler_t)(USBDriver *usbp);
+typedef void (*usbepcallback_t)(USBDriver *usbp, usbep_t ep);
+
+typedef enum {
+    USB_UNINIT    = 0,
+    USB_STOP      = 1,
+    USB_READY     = 2,
+    USB_SELECTED  = 3,
+    USB_ACTIVE    = 4,
+    USB_SUSPENDED = 5,
+} usbstate_t;
+
+typedef struct {
+    size_t         txsize;
+    const uint8_t *txbuf;
+} USBInEndpointState;
+
+typedef struct {
+    size_t   rxsize;
+    size_t   rxcnt;
+    uint8_t *rxbuf;
+} USBOutEndpointState;
+
+typedef struct {
+    uint32_t             ep_mode;
+    usbepcallback_t      setup_cb;
+    usbepcallback_t      in_cb;
+    usbepcallback_t      out_cb;
+    uint16_t             in_maxsize;
+    uint16_t             out_maxsize;
+    USBInEndpointState  *in_state;
+    USBOutEndpointState *out_state;
+    uint16_t             in_multiplier;
+    uint8_t             *setup_buf;
+} USBEndpointConfig;
+
+struct USBDriver {
+    usbstate_t               state;
+    const USBEndpointConfig *epc[USB_MAX_ENDPOINTS + 1];
+    void                    *in_params[USB_MAX_ENDPOINTS];
+    void                    *out_params[USB_MAX_ENDPOINTS];
+    uint16_t                 transmitting;
+    uint16_t                 receiving;
+    uint8_t                  setup[8];
+};
+
+#define usbGetDriverStateI(usbp) ((usbp)->state)
+#define usbGetTransmitStatusI(usbp, ep) (((usbp)->transmitting & (1U << (ep))) != 0U)
+#define usbGetReceiveStatusI(usbp, ep) (((usbp)->receiving & (1U << (ep))) != 0U)
+#define usbGetReceiveTransactionSizeX(usbp, ep) ((usbp)->epc[ep]->out_state->rxcnt)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void usbInitEndpointI(USBDriver *usbp, usbep_t ep, const USBEndpointConfig *epcp);
+void usbStartTransmitI(USBDriver *usbp, usbep_t ep, const uint8_t *buf, size_t n);
+void usbStartReceiveI(USBDriver *usbp, usbep_t ep, uint8_t *buf, size_t n);
+
+/* Completes the transmission in progress on an IN endpoint, as if the host had
+ * polled it, and returns the number of bytes the host received. */
+size_t mock_usb_host_poll(USBDriver *usbp, usbep_t ep);
+
+#ifdef __cplusplus
+}
+#endif
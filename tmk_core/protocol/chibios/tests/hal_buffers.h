@@ -0,0 +1,70 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+/* The buffers queues of the ChibiOS HAL, with the same layout and bookkeeping
+ * so usb_driver.c sees the queue it runs on. A write that has to wait for a
+ * free buffer times out at once, whatever its timeout, as nothing else can
+ * free one while it waits. */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#define BQ_BUFFER_SIZE(n, size) (((size_t)(size) + sizeof(size_t)) * (size_t)(n))
+
+typedef struct io_buffers_queue io_buffers_queue_t;
+
+typedef void (*bqnotify_t)(io_buffers_queue_t *bqp);
+
+struct io_buffers_queue {
+    bool       suspended;
+    size_t     bcounter;
+    uint8_t   *bwrptr;
+    uint8_t   *brdptr;
+    uint8_t   *btop;
+    size_t     bsize;
+    size_t     bn;
+    uint8_t   *buffers;
+    uint8_t   *ptr;
+    uint8_t   *top;
+    bqnotify_t notify;
+    void      *link;
+};
+
+typedef io_buffers_queue_t input_buffers_queue_t;
+typedef io_buffers_queue_t output_buffers_queue_t;
+
+#define bqSizeX(bqp) ((bqp)->bn)
+#define bqSpaceI(bqp) ((bqp)->bcounter)
+#define bqGetLinkX(bqp) ((bqp)->link)
+#define bqSuspendI(bqp) ((bqp)->suspended = true)
+#define bqResumeX(bqp) ((bqp)->suspended = false)
+
+#define ibqIsEmptyI(ibqp) ((bool)(bqSpaceI(ibqp) == 0U))
+#define ibqIsFullI(ibqp) ((bool)(((ibqp)->bwrptr == (ibqp)->brdptr) && ((ibqp)->bcounter != 0U)))
+#define obqIsEmptyI(obqp) ((bool)(((obqp)->bwrptr == (obqp)->brdptr) && ((obqp)->bcounter != 0U)))
+#define obqIsFullI(obqp) ((bool)(bqSpaceI(obqp) == 0U))
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void     ibqObjectInit(input_buffers_queue_t *ibqp, bool suspended, uint8_t *bp, size_t size, size_t n, bqnotify_t infy, void *link);
+void     ibqResetI(input_buffers_queue_t *ibqp);
+uint8_t *ibqGetEmptyBufferI(input_buffers_queue_t *ibqp);
+void     ibqPostFullBufferI(input_buffers_queue_t *ibqp, size_t size);
+size_t   ibqReadTimeout(input_buffers_queue_t *ibqp, uint8_t *bp, size_t n, uint32_t timeout);
+
+void     obqObjectInit(output_buffers_queue_t *obqp, bool suspended, uint8_t *bp, size_t size, size_t n, bqnotify_t onfy, void *link);
+void     obqResetI(output_buffers_queue_t *obqp);
+uint8_t *obqGetFullBufferI(output_buffers_queue_t *obqp, size_t *sizep);
+void     obqReleaseEmptyBufferI(output_buffers_queue_t *obqp);
+int32_t  obqPutTimeout(output_buffers_queue_t *obqp, uint8_t b, uint32_t timeout);
+size_t   obqWriteTimeout(output_buffers_queue_t *obqp, const uint8_t *bp, size_t n, uint32_t timeout);
+void     obqFlush(output_buffers_queue_t *obqp);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,199 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "hal.h"
+
+/* Buffers queues, following ChibiOS' hal_buffers.c minus the waiting threads. */
+
+static void bq_init(io_buffers_queue_t *bqp, bool suspended, uint8_t *bp, size_t size, size_t n, bqnotify_t nfy, void *link, size_t bcounter) {
+    bqp->suspended = suspended;
+    bqp->bcounter  = bcounter;
+    bqp->brdptr    = bp;
+    bqp->bwrptr    = bp;
+    bqp->btop      = bp + ((size + sizeof(size_t)) * n);
+    bqp->bsize     = size + sizeof(size_t);
+    bqp->bn        = n;
+    bqp->buffers   = bp;
+    bqp->ptr       = NULL;
+    bqp->top       = NULL;
+    bqp->notify    = nfy;
+    bqp->link      = link;
+}
+
+static uint8_t *bq_advance(io_buffers_queue_t *bqp, uint8_t *p) {
+    p += bqp->bsize;
+    return p >= bqp->btop ? bqp->buffers : p;
+}
+
+void ibqObjectInit(input_buffers_queue_t *ibqp, bool suspended, uint8_t *bp, size_t size, size_t n, bqnotify_t infy, void *link) {
+    bq_init(ibqp, suspended, bp, size, n, infy, link, 0);
+}
+
+void ibqResetI(input_buffers_queue_t *ibqp) {
+    ibqp->bcounter = 0;
+    ibqp->brdptr   = ibqp->buffers;
+    ibqp->bwrptr   = ibqp->buffers;
+    ibqp->ptr      = NULL;
+    ibqp->top      = NULL;
+}
+
+uint8_t *ibqGetEmptyBufferI(input_buffers_queue_t *ibqp) {
+    if (ibqIsFullI(ibqp)) {
+        return NULL;
+    }
+    return ibqp->bwrptr + sizeof(size_t);
+}
+
+void ibqPostFullBufferI(input_buffers_queue_t *ibqp, size_t size) {
+    *((size_t *)ibqp->bwrptr) = size;
+    ibqp->bwrptr              = bq_advance(ibqp, ibqp->bwrptr);
+    ibqp->bcounter++;
+}
+
+size_t ibqReadTimeout(input_buffers_queue_t *ibqp, uint8_t *bp, size_t n, uint32_t timeout) {
+    size_t r = 0;
+
+    while (r < n) {
+        if (ibqp->ptr == NULL) {
+            if (ibqp->suspended || ibqIsEmptyI(ibqp)) {
+                return r;
+            }
+            ibqp->ptr = ibqp->brdptr + sizeof(size_t);
+            ibqp->top = ibqp->ptr + *((size_t *)ibqp->brdptr);
+        }
+
+        size_t size = (size_t)(ibqp->top - ibqp->ptr);
+        if (size > n - r) {
+            size = n - r;
+        }
+        memcpy(bp + r, ibqp->ptr, size);
+        ibqp->ptr += size;
+        r += size;
+
+        if (ibqp->ptr >= ibqp->top) {
+            ibqp->brdptr = bq_advance(ibqp, ibqp->brdptr);
+            ibqp->bcounter--;
+            ibqp->ptr = NULL;
+            if (ibqp->notify != NULL) {
+                ibqp->notify(ibqp);
+            }
+        }
+    }
+    return r;
+}
+
+void obqObjectInit(output_buffers_queue_t *obqp, bool suspended, uint8_t *bp, size_t size, size_t n, bqnotify_t onfy, void *link) {
+    bq_init(obqp, suspended, bp, size, n, onfy, link, n);
+}
+
+void obqResetI(output_buffers_queue_t *obqp) {
+    obqp->bcounter = bqSizeX(obqp);
+    obqp->brdptr   = obqp->buffers;
+    obqp->bwrptr   = obqp->buffers;
+    obqp->ptr      = NULL;
+    obqp->top      = NULL;
+}
+
+uint8_t *obqGetFullBufferI(output_buffers_queue_t *obqp, size_t *sizep) {
+    if (obqIsEmptyI(obqp)) {
+        return NULL;
+    }
+    *sizep = *((size_t *)obqp->brdptr);
+    return obqp->brdptr + sizeof(size_t);
+}
+
+void obqReleaseEmptyBufferI(output_buffers_queue_t *obqp) {
+    obqp->brdptr = bq_advance(obqp, obqp->brdptr);
+    obqp->bcounter++;
+}
+
+static bool obq_get_empty_buffer(output_buffers_queue_t *obqp) {
+    if (obqp->suspended || obqIsFullI(obqp)) {
+        return false;
+    }
+    obqp->ptr = obqp->bwrptr + sizeof(size_t);
+    obqp->top = obqp->bwrptr + obqp->bsize;
+    return true;
+}
+
+static void obq_post_full_buffer(output_buffers_queue_t *obqp, size_t size) {
+    *((size_t *)obqp->bwrptr) = size;
+    obqp->bwrptr              = bq_advance(obqp, obqp->bwrptr);
+    obqp->bcounter--;
+    obqp->ptr = NULL;
+    if (obqp->notify != NULL) {
+        obqp->notify(obqp);
+    }
+}
+
+int32_t obqPutTimeout(output_buffers_queue_t *obqp, uint8_t b, uint32_t timeout) {
+    if (obqp->ptr == NULL && !obq_get_empty_buffer(obqp)) {
+        return MSG_TIMEOUT;
+    }
+    *obqp->ptr++ = b;
+    if (obqp->ptr >= obqp->top) {
+        obq_post_full_buffer(obqp, obqp->bsize - sizeof(size_t));
+    }
+    return MSG_OK;
+}
+
+size_t obqWriteTimeout(output_buffers_queue_t *obqp, const uint8_t *bp, size_t n, uint32_t timeout) {
+    size_t w = 0;
+
+    while (w < n) {
+        if (obqp->ptr == NULL && !obq_get_empty_buffer(obqp)) {
+            return w;
+        }
+
+        size_t size = (size_t)(obqp->top - obqp->ptr);
+        if (size > n - w) {
+            size = n - w;
+        }
+        memcpy(obqp->ptr, bp + w, size);
+        obqp->ptr += size;
+        w += size;
+
+        if (obqp->ptr >= obqp->top) {
+            obq_post_full_buffer(obqp, obqp->bsize - sizeof(size_t));
+        }
+    }
+    return w;
+}
+
+void obqFlush(output_buffers_queue_t *obqp) {
+    if (obqp->ptr != NULL) {
+        size_t size = (size_t)(obqp->ptr - (obqp->bwrptr + sizeof(size_t)));
+        if (size > 0U) {
+            obq_post_full_buffer(obqp, size);
+        }
+    }
+}
+
+/* USB driver */
+
+void usbInitEndpointI(USBDriver *usbp, usbep_t ep, const USBEndpointConfig *epcp) {
+    usbp->epc[ep] = epcp;
+}
+
+void usbStartTransmitI(USBDriver *usbp, usbep_t ep, const uint8_t *buf, size_t n) {
+    usbp->transmitting |= 1U << ep;
+    usbp->epc[ep]->in_state->txbuf  = buf;
+    usbp->epc[ep]->in_state->txsize = n;
+}
+
+void usbStartReceiveI(USBDriver *usbp, usbep_t ep, uint8_t *buf, size_t n) {
+    usbp->receiving |= 1U << ep;
+    usbp->epc[ep]->out_state->rxbuf  = buf;
+    usbp->epc[ep]->out_state->rxsize = n;
+}
+
+size_t mock_usb_host_poll(USBDriver *usbp, usbep_t ep) {
+    if (!usbGetTransmitStatusI(usbp, ep)) {
+        return 0;
+    }
+    size_t size = usbp->epc[ep]->in_state->txsize;
+    usbp->transmitting &= ~(1U << ep);
+    usbp->epc[ep]->in_cb(usbp, ep);
+    return size;
+}
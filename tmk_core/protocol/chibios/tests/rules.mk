@@ -0,0 +1,8 @@
+usb_driver_INC := \
+	$(TMK_PATH)/protocol/chibios/tests \
+	$(TMK_PATH)/protocol/chibios
+
+usb_driver_SRC := \
+	$(TMK_PATH)/protocol/chibios/tests/hal_mock.c \
+	$(TMK_PATH)/protocol/chibios/tests/usb_driver_tests.cpp \
+	$(TMK_PATH)/protocol/chibios/usb_driver.c
@@ -0,0 +1,7 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+/* Stands in for tmk_core/protocol/usb_descriptor.h, which needs the LUFA headers.
+ * The endpoints under test are not reorderable. */
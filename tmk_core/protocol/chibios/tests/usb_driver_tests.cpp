@@ -0,0 +1,99 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "usb_driver.h"
+}
+
+static const usbep_t EP          = 1;
+static const size_t  REPORT_SIZE = 8;
+static const size_t  CAPACITY    = 2;
+
+class UsbEndpointIn : public testing::Test {
+   protected:
+    USBDriver         usb_driver = {};
+    uint8_t           buffer[BQ_BUFFER_SIZE(CAPACITY, REPORT_SIZE)];
+    usb_endpoint_in_t endpoint = {};
+
+    void SetUp() override {
+        endpoint.ep_config.ep_mode    = USB_EP_MODE_TYPE_INTR;
+        endpoint.ep_config.in_cb      = usb_endpoint_in_tx_complete_cb;
+        endpoint.ep_config.in_maxsize = REPORT_SIZE;
+        endpoint.config               = {&usb_driver, EP, CAPACITY, REPORT_SIZE, buffer};
+
+        usb_endpoint_in_init(&endpoint);
+        usb_driver.state = USB_READY;
+        usb_endpoint_in_start(&endpoint);
+        usb_driver.state = USB_ACTIVE;
+        usb_endpoint_in_configure_cb(&endpoint);
+    }
+
+    bool send(uint8_t report_id) {
+        uint8_t report[REPORT_SIZE] = {report_id};
+        return usb_endpoint_in_send(&endpoint, report, sizeof(report), 10, false);
+    }
+
+    usb_endpoint_in_stats_t stats() {
+        usb_endpoint_in_stats_t stats;
+        usb_endpoint_in_get_stats(&endpoint, &stats);
+        return stats;
+    }
+};
+
+TEST_F(UsbEndpointIn, CountsReportsTheHostPolls) {
+    EXPECT_TRUE(send(1));
+    EXPECT_TRUE(send(2));
+    EXPECT_EQ(mock_usb_host_poll(&usb_driver, EP), REPORT_SIZE);
+    EXPECT_EQ(mock_usb_host_poll(&usb_driver, EP), REPORT_SIZE);
+    EXPECT_TRUE(usb_endpoint_in_is_inactive(&endpoint));
+
+    auto s = stats();
+    EXPECT_EQ(s.queued, 2u);
+    EXPECT_EQ(s.stalled, 0u);
+    EXPECT_EQ(s.dropped, 0u);
+    EXPECT_EQ(s.max_depth, 2);
+}
+
+TEST_F(UsbEndpointIn, ReportFitsOnceTheHostPolls) {
+    EXPECT_TRUE(send(1));
+    EXPECT_TRUE(send(2));
+    mock_usb_host_poll(&usb_driver, EP);
+    EXPECT_TRUE(send(3));
+
+    auto s = stats();
+    EXPECT_EQ(s.queued, 3u);
+    EXPECT_EQ(s.stalled, 0u);
+    EXPECT_EQ(s.dropped, 0u);
+}
+
+TEST_F(UsbEndpointIn, FullQueueDropsItsReportsAndTheOneThatTimedOut) {
+    // Nobody polls the endpoint, so both buffers stay full.
+    EXPECT_TRUE(send(1));
+    EXPECT_TRUE(send(2));
+    ASSERT_EQ(bqSpaceI(&endpoint.obqueue), 0u);
+
+    // The third report times out, the queue is cleared and the report sent again.
+    EXPECT_TRUE(send(3));
+
+    auto s = stats();
+    EXPECT_EQ(s.queued, 3u);
+    EXPECT_EQ(s.stalled, 1u);
+    EXPECT_EQ(s.dropped, 3u);
+    EXPECT_TRUE(endpoint.timed_out);
+    EXPECT_EQ(bqSizeX(&endpoint.obqueue) - bqSpaceI(&endpoint.obqueue), 1u);
+}
+
+TEST_F(UsbEndpointIn, ResetStatsClearsTheCounts) {
+    EXPECT_TRUE(send(1));
+    EXPECT_TRUE(send(2));
+    EXPECT_TRUE(send(3));
+    usb_endpoint_in_reset_stats(&endpoint);
+
+    auto s = stats();
+    EXPECT_EQ(s.queued, 0u);
+    EXPECT_EQ(s.stalled, 0u);
+    EXPECT_EQ(s.dropped, 0u);
+    EXPECT_EQ(s.max_depth, 0);
+}
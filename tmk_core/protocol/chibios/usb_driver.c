@@ -267,6 +267,12 @@ bool usb_endpoint_in_send(usb_endpoint_in_t *endpoint, const uint8_t *data, size
     if (endpoint->timed_out && timeout != TIME_INFINITE) {
         timeout = TIME_IMMEDIATE;
     }
+
+    /* No partially filled buffer and no empty buffer left, the write below has
+     * to wait for the host to poll the endpoint. */
+    if (endpoint->obqueue.ptr == NULL && obqIsFullI(&endpoint->obqueue)) {
+        endpoint->stats.stalled++;
+    }
     osalSysUnlock();
 
     while (true) {
@@ -275,6 +281,9 @@ bool usb_endpoint_in_send(usb_endpoint_in_t *endpoint, const uint8_t *data, size
         if (sent < size) {
             osalSysLock();
             endpoint->timed_out |= sent == 0;
+            /* The reports waiting in the queue are discarded, and so is the
+             * one that timed out, it is only sent again from scratch. */
+            endpoint->stats.dropped += bqSizeX(&endpoint->obqueue) - bqSpaceI(&endpoint->obqueue) + 1;
             bqSuspendI(&endpoint->obqueue);
             obqResetI(&endpoint->obqueue);
             bqResumeX(&endpoint->obqueue);
@@ -287,6 +296,14 @@ bool usb_endpoint_in_send(usb_endpoint_in_t *endpoint, const uint8_t *data, size
             obqFlush(&endpoint->obqueue);
         }
 
+        osalSysLock();
+        endpoint->stats.queued++;
+        size_t depth = bqSizeX(&endpoint->obqueue) - bqSpaceI(&endpoint->obqueue);
+        if (depth > endpoint->stats.max_depth) {
+            endpoint->stats.max_depth = depth;
+        }
+        osalSysUnlock();
+
         return true;
     }
 }
@@ -320,6 +337,22 @@ bool usb_endpoint_in_is_inactive(usb_endpoint_in_t *endpoint) {
     return inactive;
 }
 
+void usb_endpoint_in_get_stats(usb_endpoint_in_t *endpoint, usb_endpoint_in_stats_t *stats) {
+    osalDbgCheck((endpoint != NULL) && (stats != NULL));
+
+    osalSysLock();
+    *stats = endpoint->stats;
+    osalSysUnlock();
+}
+
+void usb_endpoint_in_reset_stats(usb_endpoint_in_t *endpoint) {
+    osalDbgCheck(endpoint != NULL);
+
+    osalSysLock();
+    memset(&endpoint->stats, 0, sizeof(usb_endpoint_in_stats_t));
+    osalSysUnlock();
+}
+
 bool usb_endpoint_out_receive(usb_endpoint_out_t *endpoint, uint8_t *data, size_t size, sysinterval_t timeout) {
     osalDbgCheck((endpoint != NULL) && (data != NULL) && (size > 0U));
 
@@ -154,6 +154,30 @@ typedef struct {
     uint8_t *buffer;
 } usb_endpoint_config_t;
 
+typedef struct {
+    /**
+     * @brief Number of reports enqueued for transmission
+     */
+    uint32_t queued;
+
+    /**
+     * @brief Number of reports that had to wait for a free buffer in the queue
+     */
+    uint32_t stalled;
+
+    /**
+     * @brief Number of reports that were discarded because the host didn't
+     * poll the endpoint in time, counting the queued reports and the report
+     * that timed out waiting for a free buffer, which is then sent again
+     */
+    uint32_t dropped;
+
+    /**
+     * @brief Highest number of reports waiting in the queue at the same time
+     */
+    uint8_t max_depth;
+} usb_endpoint_in_stats_t;
+
 typedef struct {
     output_buffers_queue_t obqueue;
     USBEndpointConfig      ep_config;
@@ -162,10 +186,11 @@ typedef struct {
     USBOutEndpointState ep_out_state;
     bool                is_shared;
 #endif
-    usb_endpoint_config_t config;
-    usbreqhandler_t       usb_requests_cb;
-    bool                  timed_out;
-    usb_report_storage_t *report_storage;
+    usb_endpoint_config_t   config;
+    usbreqhandler_t         usb_requests_cb;
+    bool                    timed_out;
+    usb_report_storage_t   *report_storage;
+    usb_endpoint_in_stats_t stats;
 } usb_endpoint_in_t;
 
 typedef struct {
@@ -187,6 +212,8 @@ void usb_endpoint_in_stop(usb_endpoint_in_t *endpoint);
 bool usb_endpoint_in_send(usb_endpoint_in_t *endpoint, const uint8_t *data, size_t size, sysinterval_t timeout, bool buffered);
 void usb_endpoint_in_flush(usb_endpoint_in_t *endpoint, bool padded);
 bool usb_endpoint_in_is_inactive(usb_endpoint_in_t *endpoint);
+void usb_endpoint_in_get_stats(usb_endpoint_in_t *endpoint, usb_endpoint_in_stats_t *stats);
+void usb_endpoint_in_reset_stats(usb_endpoint_in_t *endpoint);
 
 void usb_endpoint_in_suspend_cb(usb_endpoint_in_t *endpoint);
 void usb_endpoint_in_wakeup_cb(usb_endpoint_in_t *endpoint);
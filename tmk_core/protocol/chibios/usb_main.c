@@ -27,6 +27,7 @@
 #include "usb_descriptor.h"
 #include "usb_driver.h"
 #include "usb_types.h"
+#include "spsc_queue.h"
 
 #ifdef RAW_ENABLE
 #    include "raw_hid.h"
@@ -95,34 +96,24 @@ static const USBDescriptor *usb_get_descriptor_cb(USBDriver *usbp, uint8_t dtype
  */
 
 #define USB_EVENT_QUEUE_SIZE 16
-usbevent_t event_queue[USB_EVENT_QUEUE_SIZE];
-uint8_t    event_queue_head;
-uint8_t    event_queue_tail;
+SPSC_QUEUE_ASSERT_CAPACITY(USB_EVENT_QUEUE_SIZE);
+
+// Filled from the USB event callback (ISR context) and drained by usb_event_queue_task() in the main loop
+static usbevent_t   event_queue_storage[USB_EVENT_QUEUE_SIZE];
+static spsc_queue_t event_queue = SPSC_QUEUE_INIT(event_queue_storage, sizeof(usbevent_t), USB_EVENT_QUEUE_SIZE);
 
 void usb_event_queue_init(void) {
     // Initialise the event queue
-    memset(&event_queue, 0, sizeof(event_queue));
-    event_queue_head = 0;
-    event_queue_tail = 0;
+    memset(&event_queue_storage, 0, sizeof(event_queue_storage));
+    spsc_queue_init(&event_queue, event_queue_storage, sizeof(usbevent_t), USB_EVENT_QUEUE_SIZE);
 }
 
 static inline bool usb_event_queue_enqueue(usbevent_t event) {
-    uint8_t next = (event_queue_head + 1) % USB_EVENT_QUEUE_SIZE;
-    if (next == event_queue_tail) {
-        return false;
-    }
-    event_queue[event_queue_head] = event;
-    event_queue_head              = next;
-    return true;
+    return spsc_queue_push(&event_queue, &event);
 }
 
 static inline bool usb_event_queue_dequeue(usbevent_t *event) {
-    if (event_queue_head == event_queue_tail) {
-        return false;
-    }
-    *event           = event_queue[event_queue_tail];
-    event_queue_tail = (event_queue_tail + 1) % USB_EVENT_QUEUE_SIZE;
-    return true;
+    return spsc_queue_pop(&event_queue, event);
 }
 
 static inline void usb_event_suspend_handler(void) {
@@ -393,6 +384,26 @@ bool send_report(usb_endpoint_in_lut_t endpoint, void *report, size_t size) {
     return usb_endpoint_in_send(&usb_endpoints_in[endpoint], (uint8_t *)report, size, TIME_MS2I(100), false);
 }
 
+/**
+ * @brief Get the statistics of the report queue of an IN endpoint, e.g. to
+ * check whether reports are produced faster than the host polls for them.
+ *
+ * @param endpoint USB IN endpoint to get the statistics of
+ * @param stats pointer to the statistics to fill
+ */
+void get_report_stats(usb_endpoint_in_lut_t endpoint, usb_endpoint_in_stats_t *stats) {
+    usb_endpoint_in_get_stats(&usb_endpoints_in[endpoint], stats);
+}
+
+/**
+ * @brief Clear the statistics of the report queue of an IN endpoint.
+ *
+ * @param endpoint USB IN endpoint to clear the statistics of
+ */
+void reset_report_stats(usb_endpoint_in_lut_t endpoint) {
+    usb_endpoint_in_reset_stats(&usb_endpoints_in[endpoint]);
+}
+
 /**
  * @brief Send a report to the host, but delay the sending until the size of
  * endpoint report is reached or the incompletely filled buffer is flushed with
@@ -34,6 +34,12 @@ void restart_usb_driver(USBDriver *usbp);
 
 bool send_report(usb_endpoint_in_lut_t endpoint, void *report, size_t size);
 
+/* Get the report queue statistics of an IN endpoint */
+void get_report_stats(usb_endpoint_in_lut_t endpoint, usb_endpoint_in_stats_t *stats);
+
+/* Clear the report queue statistics of an IN endpoint */
+void reset_report_stats(usb_endpoint_in_lut_t endpoint);
+
 /* ---------------
  * USB Event queue
  * ---------------
@@ -23,6 +23,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "util.h"
 #include "debug.h"
 #include "usb_device_state.h"
+#include "boot_trace.h"
 
 #ifdef DIGITIZER_ENABLE
 #    include "digitizer.h"
@@ -182,6 +183,7 @@ void host_keyboard_send(report_keyboard_t *report) {
     report->report_id = REPORT_ID_KEYBOARD;
 #endif
     (*driver->send_keyboard)(report);
+    BOOT_TRACE(FIRST_REPORT);
 
     if (debug_keyboard) {
         dprintf("keyboard_report: %02X | ", report->mods);
@@ -198,6 +200,7 @@ void host_nkro_send(report_nkro_t *report) {
 
     report->report_id = REPORT_ID_NKRO;
     (*driver->send_nkro)(report);
+    BOOT_TRACE(FIRST_REPORT);
 
     if (debug_keyboard) {
         dprintf("nkro_report: %02X | ", report->mods);
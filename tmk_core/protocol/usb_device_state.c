@@ -16,6 +16,8 @@
  */
 
 #include "usb_device_state.h"
+#include "timer.h"
+#include "boot_trace.h"
 #if defined(HAPTIC_ENABLE)
 #    include "haptic.h"
 #endif
@@ -26,12 +28,20 @@
 
 static struct usb_device_state usb_device_state = {.idle_rate = 0, .leds = 0, .protocol = USB_PROTOCOL_REPORT, .configure_state = USB_DEVICE_STATE_NO_INIT};
 
+static uint32_t usb_enumeration_time = 0;
+
 __attribute__((weak)) void notify_usb_device_state_change_kb(struct usb_device_state usb_device_state) {
     notify_usb_device_state_change_user(usb_device_state);
 }
 
 __attribute__((weak)) void notify_usb_device_state_change_user(struct usb_device_state usb_device_state) {}
 
+__attribute__((weak)) void usb_enumerated_kb(uint32_t boot_time_ms) {
+    usb_enumerated_user(boot_time_ms);
+}
+
+__attribute__((weak)) void usb_enumerated_user(uint32_t boot_time_ms) {}
+
 static void notify_usb_device_state_change(struct usb_device_state usb_device_state) {
 #if defined(HAPTIC_ENABLE) && HAPTIC_OFF_IN_LOW_POWER
     haptic_notify_usb_device_state_change();
@@ -47,6 +57,23 @@ static void notify_usb_device_state_change(struct usb_device_state usb_device_st
 void usb_device_state_set_configuration(bool is_configured, uint8_t configuration_number) {
     usb_device_state.configure_state = is_configured ? USB_DEVICE_STATE_CONFIGURED : USB_DEVICE_STATE_INIT;
     notify_usb_device_state_change(usb_device_state);
+
+    if (is_configured) {
+        BOOT_TRACE(USB_CONFIGURED);
+    }
+
+    if (is_configured && usb_enumeration_time == 0) {
+        // The timer is started early in keyboard_init(), so this is roughly the time it took to boot and enumerate
+        usb_enumeration_time = timer_read32();
+        if (usb_enumeration_time == 0) {
+            usb_enumeration_time = 1;
+        }
+        usb_enumerated_kb(usb_enumeration_time);
+    }
+}
+
+uint32_t usb_device_state_get_enumeration_time(void) {
+    return usb_enumeration_time;
 }
 
 void usb_device_state_set_suspend(bool is_configured, uint8_t configuration_number) {
@@ -60,11 +87,13 @@ void usb_device_state_set_resume(bool is_configured, uint8_t configuration_numbe
 }
 
 void usb_device_state_set_reset(void) {
+    BOOT_TRACE(USB_RESET);
     usb_device_state.configure_state = USB_DEVICE_STATE_INIT;
     notify_usb_device_state_change(usb_device_state);
 }
 
 void usb_device_state_init(void) {
+    BOOT_TRACE(USB_INIT);
     usb_device_state.configure_state = USB_DEVICE_STATE_INIT;
     notify_usb_device_state_change(usb_device_state);
 }
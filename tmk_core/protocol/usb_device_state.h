@@ -55,6 +55,11 @@ uint8_t               usb_device_state_get_leds(void);
 void                  usb_device_state_set_idle_rate(uint8_t idle_rate);
 uint8_t               usb_device_state_get_idle_rate(void);
 void                  usb_device_state_reset_hid_state(void);
+uint32_t              usb_device_state_get_enumeration_time(void);
 
 void notify_usb_device_state_change_kb(struct usb_device_state usb_device_state);
 void notify_usb_device_state_change_user(struct usb_device_state usb_device_state);
+
+/* called once, the first time the host configures the device, with the milliseconds elapsed since boot */
+void usb_enumerated_kb(uint32_t boot_time_ms);
+void usb_enumerated_user(uint32_t boot_time_ms);